@@ -1,12 +1,19 @@
 #include <iostream>
 using namespace std;
 
+#include "trace.h"
+
+#ifdef _WIN32
 #include <windows.h>
 #include <process.h>
+#endif
 
-// function definition -- requires windows.h
+// function definition -- requires windows.h (other systems use an ANSI escape sequence)
 void gotoxy(int x, int y)
 {
+	TRACE_COUNTER_ADD(GOTOXY_CALLS, 1);
+
+#ifdef _WIN32
 	HANDLE hConsoleOutput;
 	COORD dwCursorPosition;
 	cout.flush();
@@ -14,10 +21,17 @@ void gotoxy(int x, int y)
 	dwCursorPosition.Y = y;
 	hConsoleOutput = GetStdHandle(STD_OUTPUT_HANDLE);
 	SetConsoleCursorPosition(hConsoleOutput,dwCursorPosition);
+#else
+	cout << "\033[" << y + 1 << ";" << x + 1 << "H";
+#endif
 }
 
 // function definition -- requires process.h
 void clrscr()
 {
+#ifdef _WIN32
 	system("cls");
+#else
+	cout << "\033[2J\033[H";
+#endif
 }
\ No newline at end of file
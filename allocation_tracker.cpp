@@ -0,0 +1,92 @@
+#include "allocation_tracker.h"
+
+#ifdef TETRIS_TRACK_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+//The counts are saved per thread, so counting does not need any locking. They are plain data, so they can be used before any constructor runs.
+static thread_local AllocationCounts threadCounts = {0, 0, 0, 0};
+
+/*
+The global allocation functions are replaced while tracking so every heap allocation is counted.
+*/
+void * operator new(size_t size) {
+	AllocationTracker::recordHeapAllocation(size);
+
+	void *p = malloc(size ? size : 1);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return p;
+}
+
+void * operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p) noexcept {
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+	free(p);
+}
+
+/*
+This function returns the allocations made by the calling thread so far.
+*/
+AllocationCounts AllocationTracker::getCounts() {
+	return threadCounts;
+}
+
+/*
+This function counts an allocation of the given size from the heap.
+*/
+void AllocationTracker::recordHeapAllocation(size_t size) {
+	threadCounts.heapAllocations++;
+	threadCounts.heapBytes += size;
+}
+
+/*
+This function counts a chunk of the given size that was handed out by a memory pool.
+*/
+void AllocationTracker::recordPoolAllocationImpl(size_t size) {
+	threadCounts.poolAllocations++;
+	threadCounts.poolBytes += size;
+}
+
+#else
+
+/*
+This function returns the allocations made by the calling thread so far (always zero, since tracking is disabled).
+*/
+AllocationCounts AllocationTracker::getCounts() {
+	AllocationCounts counts = {0, 0, 0, 0};
+	return counts;
+}
+
+/*
+This function does nothing since tracking is disabled.
+*/
+void AllocationTracker::recordHeapAllocation(size_t size) {
+	(void)size;
+}
+
+/*
+This function does nothing since tracking is disabled.
+*/
+void AllocationTracker::recordPoolAllocationImpl(size_t size) {
+	(void)size;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef __ALLOCATION_TRACKER_H
+#define __ALLOCATION_TRACKER_H
+
+#include <cstddef>
+
+//Tracing the game also tracks its allocations.
+#if defined(TETRIS_TRACE) && !defined(TETRIS_TRACK_ALLOCATIONS)
+#define TETRIS_TRACK_ALLOCATIONS
+#endif
+
+/*
+The amount of allocations (and their total size in bytes) that were made by a thread.
+Heap allocations are the ones made through the global operator new, pool allocations are the chunks handed out by the memory pools.
+*/
+struct AllocationCounts {
+	long long heapAllocations;
+	long long heapBytes;
+	long long poolAllocations;
+	long long poolBytes;
+
+	AllocationCounts operator-(const AllocationCounts& other) const {
+		AllocationCounts result = {heapAllocations - other.heapAllocations, heapBytes - other.heapBytes, poolAllocations - other.poolAllocations, poolBytes - other.poolBytes};
+		return result;
+	}
+
+	AllocationCounts& operator+=(const AllocationCounts& other) {
+		heapAllocations += other.heapAllocations;
+		heapBytes += other.heapBytes;
+		poolAllocations += other.poolAllocations;
+		poolBytes += other.poolBytes;
+		return *this;
+	}
+};
+
+/*
+Counts the allocations made by each thread.
+The heap allocations are counted only when the game is built with TETRIS_TRACK_ALLOCATIONS (the global operator new is replaced then),
+otherwise the counts are always zero and counting costs nothing.
+*/
+class AllocationTracker {
+public:
+#ifdef TETRIS_TRACK_ALLOCATIONS
+	constexpr static bool ENABLED = true;
+#else
+	constexpr static bool ENABLED = false;
+#endif
+
+	static AllocationCounts getCounts();
+	static void recordHeapAllocation(size_t size);
+
+	/*
+	This function counts a chunk that was handed out by a memory pool.
+	*/
+	static inline void recordPoolAllocation(size_t size) {
+#ifdef TETRIS_TRACK_ALLOCATIONS
+		recordPoolAllocationImpl(size);
+#else
+		(void)size;
+#endif
+	}
+
+private:
+	static void recordPoolAllocationImpl(size_t size);
+};
+
+#endif
\ No newline at end of file
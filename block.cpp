@@ -1,29 +1,32 @@
 #include "block.h"
+#include "memory_pool.h"
 
 /*
-Destructor - clears the memory used for the points in the block locations vector.
+Destructor - clears the memory used for the points in the block locations.
 */
 Block::~Block() {
-	Block::clearVectorOfDynamicPoints(this->blockLocations);
+	Block::clearDynamicPoints(this->blockLocations);
 }
 
 /*
-This function clears the memory used for a vector of dynamic points.
+This function clears the memory used for the dynamic points of a block's squares.
 */
-void Block::clearVectorOfDynamicPoints(vector<Point *>& vec) {
-	vector<Point *>::iterator itr = vec.begin();
-	vector<Point *>::iterator itrEnd = vec.end();
+void Block::clearDynamicPoints(BlockSquares& squares) {
+	BlockSquares::iterator itr = squares.begin();
+	BlockSquares::iterator itrEnd = squares.end();
 
 	for (; itr != itrEnd; ++itr) {
 		delete *itr;
 	}
+
+	squares.amount = 0;
 }
 
 /*
 This function returns the block's locations in the console.
 The class Tetris is allowed to change this property, therefore it is not a const function.
 */
-vector<Point *>& Block::getBlockLocations() {
+BlockSquares& Block::getBlockLocations() {
 	return this->blockLocations;
 }
 
@@ -37,83 +40,67 @@ bool Block::isRotateable() const {
 /*
 This function sets the block's squares locations in the console.
 */
-void Block::setBlockLocations(vector<Point *>& blockLocations) {
-	Block::clearVectorOfDynamicPoints(this->blockLocations);
+void Block::setBlockLocations(const BlockSquares& blockLocations) {
+	Block::clearDynamicPoints(this->blockLocations);
 	this->blockLocations = blockLocations;
 	this->updateBlockProperties();
 }
 
 /*
-This function paints the block into the console.
+This function returns the char that represents the block in the console.
 */
-void Block::paint() const {
-	vector<Point *>::const_iterator itr = this->blockLocations.begin();
-	vector<Point *>::const_iterator itrEnd = this->blockLocations.end();
-
-	for (; itr != itrEnd; ++itr) {
-		gotoxy((*itr)->getX(), (*itr)->getY());
-		cout << this->ch;
-	}
-}
-
-/*
-This function prints spaces instead of the block in the console.
-*/
-void Block::removeBlockFromConsole() const {
-	vector<Point *>::const_iterator itr = this->blockLocations.begin();
-	vector<Point *>::const_iterator itrEnd = this->blockLocations.end();
-
-	for (; itr != itrEnd; ++itr) {
-		gotoxy((*itr)->getX(), (*itr)->getY());
-		cout << " ";
-	}
+char Block::getChar() const {
+	return this->ch;
 }
 
 /*
 This function rotates the block to the right.
+The squares are moved in place, since the location of each rotated square depends only on its own location and on the properties of the block.
 */
 void Block::rotateRight() {
 	if (this->rotateable) {
-		this->setBlockLocations(this->getRotatedPosition());
+		BlockSquares::iterator itr = this->blockLocations.begin();
+		BlockSquares::iterator itrEnd = this->blockLocations.end();
+
+		for (; itr != itrEnd; ++itr) {
+			Point rotated = this->getRotatedPoint(**itr);
+
+			(*itr)->setX(rotated.getX());
+			(*itr)->setY(rotated.getY());
+		}
+
+		this->updateBlockProperties();
 		this->rotatedAmount++; //Increasing the amount of times the block was rotated.
 	}
 }
 
 /*
-Rotating the block according to a formula we've discovered.
+Rotating a square of the block according to a formula we've discovered.
+The rotated square is returned by value, so checking a rotation does not allocate.
 */
-vector<Point *> Block::getRotatedPosition() {
-	vector<Point *> rotatedPosition;
-	
-	vector<Point *>::iterator itr = this->blockLocations.begin();
-	vector<Point *>::iterator itrEnd = this->blockLocations.end();
-
-	for (; itr != itrEnd; ++itr) {
-		int newX, newY, x, y, relativeX, relativeY;
+Point Block::getRotatedPoint(const Point& point) const {
+	int newX, newY, x, y, relativeX, relativeY;
 
-		x = (*itr)->getX();
-		y = (*itr)->getY();
+	x = point.getX();
+	y = point.getY();
 
-		relativeX = abs(this->maxColIndex - x - this->colAmount); //Getting the relative position of X according to the rest of the points.
-		relativeY = abs(this->maxRowIndex - y - this->rowAmount); //Getting the relative position of Y according to the rest of the points.
+	relativeX = abs(this->maxColIndex - x - this->colAmount); //Getting the relative position of X according to the rest of the points.
+	relativeY = abs(this->maxRowIndex - y - this->rowAmount); //Getting the relative position of Y according to the rest of the points.
 
-		newY = relativeX; //Setting the newY to the relative value of x according to the other points in the vector.
-		
-		if (this->rotatedAmount % 2 == 0) {
-			newX = abs(relativeY - this->colAmount); //Getting the new relative value of x according to the relative value of y.
-			newX += this->maxColIndex - this->colAmount; //Returning newX to the real value in the board.
-		}
-		else {
-			newX = abs(relativeY - this->rowAmount); //Getting the new relative value of x according to the relative value of y.
-			newX += this->maxColIndex - this->rowAmount; //Returning newX to the real value in the board.
-		}
-
-		newY += this->maxRowIndex - this->rowAmount; //Returning newY to the real value in the board.
-
-		rotatedPosition.push_back(new Point(newX, newY));
+	newY = relativeX; //Setting the newY to the relative value of x according to the other points in the vector.
+	
+	if (this->rotatedAmount % 2 == 0) {
+		newX = abs(relativeY - this->colAmount); //Getting the new relative value of x according to the relative value of y.
+		newX += this->maxColIndex - this->colAmount; //Returning newX to the real value in the board.
+	}
+	else {
+		newX = abs(relativeY - this->rowAmount); //Getting the new relative value of x according to the relative value of y.
+		newX += this->maxColIndex - this->rowAmount; //Returning newX to the real value in the board.
 	}
 
-	return rotatedPosition;
+	newY += this->maxRowIndex - this->rowAmount; //Returning newY to the real value in the board.
+
+	return Point(newX, newY);
 }
 
 /*
@@ -123,8 +110,8 @@ void Block::updateBlockProperties() {
 	int minColIndex, minRowIndex;
 	Point *p;
 
-	vector<Point *>::iterator itr = this->blockLocations.begin();
-	vector<Point *>::iterator itrEnd = this->blockLocations.end();
+	BlockSquares::iterator itr = this->blockLocations.begin();
+	BlockSquares::iterator itrEnd = this->blockLocations.end();
 	p = *itr;
 
 	minColIndex = this->maxColIndex = p->getX();
@@ -169,4 +156,27 @@ Getting the amount of times the block was rotated - used for saving the block to
 */
 int Block::getRotatedAmount() const {
 	return this->rotatedAmount;
+}
+
+/*
+This function returns the pool the blocks of the current thread are allocated from.
+The kinds of blocks do not add any properties, so all of them fit in a chunk of the size of a block.
+*/
+static MemoryPool& getBlocksPool() {
+	static thread_local MemoryPool pool(sizeof(Block));
+	return pool;
+}
+
+/*
+This function allocates memory for a new block from the pool.
+*/
+void * Block::operator new(size_t size) {
+	return getBlocksPool().allocate(size);
+}
+
+/*
+This function returns the memory of a block to the pool.
+*/
+void Block::operator delete(void *p) {
+	MemoryPool::deallocate(p); //The chunk goes back to the pool it came from, which may belong to another thread.
 }
\ No newline at end of file
@@ -2,16 +2,40 @@
 #define __BLOCK_H
 
 #include <iostream>
-#include <vector>
 #include "point.h"
-#include "Gotoxy.h"
 using namespace std;
 
+/*
+The squares of a block. A block has at most MAX_SQUARES squares, so they are kept in an array inside the block
+and creating a block does not allocate a buffer for them (the points themselves come from the pool of the points).
+*/
+struct BlockSquares {
+	constexpr static int MAX_SQUARES = 4;
+
+	typedef Point **iterator;
+	typedef Point *const *const_iterator;
+
+	Point *points[MAX_SQUARES];
+	int amount = 0;
+
+	iterator begin() { return this->points; }
+	iterator end() { return this->points + this->amount; }
+	const_iterator begin() const { return this->points; }
+	const_iterator end() const { return this->points + this->amount; }
+	Point *front() const { return this->points[0]; }
+	Point *operator[](int index) const { return this->points[index]; }
+	int size() const { return this->amount; }
+
+	void add(Point *point) { //There must be less than MAX_SQUARES squares.
+		this->points[this->amount++] = point;
+	}
+};
+
 class Block {
 protected:
 	char ch;
 
-	vector<Point *> blockLocations; //This property saves the locations in the console for each square of the block.
+	BlockSquares blockLocations; //This property saves the locations in the console for each square of the block.
 	int rotatedAmount = 0;
 	bool rotateable = true;
 	int colAmount = 0;
@@ -19,27 +43,31 @@ protected:
 	int maxColIndex = 0;
 	int maxRowIndex = 0;
 
-	void setBlockLocations(vector<Point *>& blockLocations);
+	void setBlockLocations(const BlockSquares& blockLocations);
 
 public:
 	constexpr static char NORMAL_SQUARE_CHAR = '#';
 	constexpr static char BOMB_SQUARE_CHAR = '@';
+	constexpr static char GHOST_SQUARE_CHAR = '.';
 
 	virtual ~Block();
 
-	vector<Point *>& getBlockLocations();
-	virtual vector<Point *> getRotatedPosition();
+	BlockSquares& getBlockLocations();
+	Point getRotatedPoint(const Point& point) const;
 	virtual void rotateRight();
 	bool isRotateable() const;
 
-	void paint() const;
-	void removeBlockFromConsole() const;
+	char getChar() const;
 
 	void updateBlockProperties();
 	void setRotatedAmount(int rotateAmount);
 	int getRotatedAmount() const;
 
-	static void clearVectorOfDynamicPoints(vector<Point *>& vec);
+	static void clearDynamicPoints(BlockSquares& squares);
+
+	//The blocks are allocated from a pool of the current thread, since a block is created and deleted for every block dropped.
+	static void * operator new(size_t size);
+	static void operator delete(void *p);
 };
 
 #endif
\ No newline at end of file
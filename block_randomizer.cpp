@@ -0,0 +1,226 @@
+#include "block_randomizer.h"
+#include <cmath>
+
+/*
+Constructor - uses the current settings of the randomizer.
+*/
+BlockRandomizer::BlockRandomizer() {
+	this->configure(RandomizerConfig::getCurrent());
+}
+
+/*
+Constructor - uses the given settings.
+*/
+BlockRandomizer::BlockRandomizer(const RandomizerConfig& config) {
+	this->configure(config);
+}
+
+/*
+This function sets the randomizer's settings (the settings must be valid) and starts from an empty bag / history.
+*/
+void BlockRandomizer::configure(const RandomizerConfig& config) {
+	this->mode = config.mode;
+	this->fingerprint = config.getFingerprint();
+	this->buildAliasTable(config.weights);
+
+	this->bagSize = 0;
+	for (int i = 0; i < TYPES_AMOUNT; i++) {
+		this->bagCounts[i] = (int)floor(config.weights[i] + 0.5);
+		this->bagSize += this->bagCounts[i];
+	}
+
+	this->historySize = config.historySize;
+	this->historyRolls = config.historyRolls;
+
+	this->reset();
+}
+
+/*
+This function builds the alias table of the given weights (Vose's method), so a block can be picked in O(1).
+*/
+void BlockRandomizer::buildAliasTable(const double weights[TYPES_AMOUNT]) {
+	double scaled[TYPES_AMOUNT];
+	int small[TYPES_AMOUNT], large[TYPES_AMOUNT];
+	int smallAmount = 0, largeAmount = 0;
+	double sum = 0;
+
+	for (int i = 0; i < TYPES_AMOUNT; i++) {
+		sum += weights[i];
+	}
+
+	//Scaling the weights so their average is 1, and splitting them into the columns that are under / over the average.
+	for (int i = 0; i < TYPES_AMOUNT; i++) {
+		scaled[i] = weights[i] * TYPES_AMOUNT / sum;
+		this->alias[i] = (unsigned char)i;
+
+		if (scaled[i] < 1) {
+			small[smallAmount++] = i;
+		}
+		else {
+			large[largeAmount++] = i;
+		}
+	}
+
+	//Each small column is filled up to the average with a part of a large column.
+	while (smallAmount > 0 && largeAmount > 0) {
+		int less = small[--smallAmount];
+		int more = large[largeAmount - 1];
+
+		this->keepChance[less] = (unsigned int)(scaled[less] * 4294967296.0);
+		this->alias[less] = (unsigned char)more;
+		scaled[more] -= 1 - scaled[less];
+
+		if (scaled[more] < 1) {
+			largeAmount--;
+			small[smallAmount++] = more;
+		}
+	}
+
+	//The columns that are left are full (up to rounding errors).
+	while (largeAmount > 0) {
+		this->keepChance[large[--largeAmount]] = 0xFFFFFFFFu;
+	}
+
+	while (smallAmount > 0) {
+		this->keepChance[small[--smallAmount]] = 0xFFFFFFFFu;
+	}
+}
+
+/*
+This function picks a block from the alias table using a single random number:
+the high part of number * TYPES_AMOUNT picks the column and the low part decides between the column and its alias.
+*/
+BlocksGenerator::eBlockType BlockRandomizer::sampleAlias(unsigned int number) const {
+	unsigned long long product = (unsigned long long)number * TYPES_AMOUNT;
+	int column = (int)(product >> 32);
+	unsigned int coin = (unsigned int)product;
+
+	return (BlocksGenerator::eBlockType)(coin < this->keepChance[column] ? column : this->alias[column]);
+}
+
+/*
+This function starts from a full bag and an empty history.
+*/
+void BlockRandomizer::reset() {
+	for (int i = 0; i < TYPES_AMOUNT; i++) {
+		this->bagLeft[i] = this->bagCounts[i];
+	}
+
+	this->bagLeftSize = this->bagSize;
+	this->historyHead = 0;
+
+	for (int i = 0; i < RandomizerConfig::MAX_HISTORY_SIZE; i++) {
+		this->history[i] = (BlocksGenerator::eBlockType)-1; //No block.
+	}
+}
+
+/*
+This function takes a number from the random stream and returns the type of the next block.
+*/
+BlocksGenerator::eBlockType BlockRandomizer::next(RandomStream& random) {
+	unsigned int number = random.next();
+
+	if (this->mode == RandomizerConfig::BAG_MODE) {
+		return this->nextFromBag(number);
+	}
+	else if (this->mode == RandomizerConfig::HISTORY_MODE) {
+		return this->nextWithHistory(number);
+	}
+
+	return this->sampleAlias(number);
+}
+
+/*
+This function deals a block from the bag (every block left in the bag has the same chance), and refills the bag when it becomes empty.
+*/
+BlocksGenerator::eBlockType BlockRandomizer::nextFromBag(unsigned int number) {
+	int index = (int)(((unsigned long long)number * (unsigned int)this->bagLeftSize) >> 32);
+	int blockType = 0;
+
+	while (index >= this->bagLeft[blockType]) { //Finding the block the index falls on (there are only a few types of blocks).
+		index -= this->bagLeft[blockType];
+		blockType++;
+	}
+
+	this->bagLeft[blockType]--;
+	this->bagLeftSize--;
+
+	if (this->bagLeftSize == 0) {
+		for (int i = 0; i < TYPES_AMOUNT; i++) {
+			this->bagLeft[i] = this->bagCounts[i];
+		}
+
+		this->bagLeftSize = this->bagSize;
+	}
+
+	return (BlocksGenerator::eBlockType)blockType;
+}
+
+/*
+This function picks a block, and picks again (up to historyRolls times in total) while the block is one of the last historySize blocks.
+The first roll uses the given number, and the other rolls use a stream seeded with it, so a block still takes a single number from the game's stream.
+*/
+BlocksGenerator::eBlockType BlockRandomizer::nextWithHistory(unsigned int number) {
+	RandomStream rolls(number);
+	BlocksGenerator::eBlockType blockType = this->sampleAlias(number);
+
+	for (int roll = 1; roll < this->historyRolls; roll++) {
+		bool isInHistory = false;
+
+		for (int i = 0; i < this->historySize; i++) {
+			if (this->history[i] == blockType) {
+				isInHistory = true;
+			}
+		}
+
+		if (!isInHistory) {
+			break;
+		}
+
+		blockType = this->sampleAlias(rolls.next());
+	}
+
+	this->history[this->historyHead] = blockType;
+	this->historyHead = (this->historyHead + 1) % this->historySize;
+
+	return blockType;
+}
+
+/*
+This function sets the history to the given recent blocks, when the given amount of blocks were generated.
+The recent blocks are packed RECENT_BLOCK_BITS bits each, with the last block in the lowest bits (as BlocksQueue::getRecentBlocks returns them),
+so the history is set in O(1) instead of picking every block of the game again.
+*/
+void BlockRandomizer::setHistory(unsigned long long recentBlocks, unsigned int counter) {
+	for (int i = 0; i < RandomizerConfig::MAX_HISTORY_SIZE; i++) {
+		this->history[i] = (BlocksGenerator::eBlockType)-1; //No block.
+	}
+
+	//The block at position i of the stream was written to history[i % historySize].
+	this->historyHead = (int)(counter % (unsigned int)this->historySize);
+
+	for (int i = 0; i < this->historySize && (unsigned int)i < counter; i++) {
+		int index = (this->historyHead + this->historySize - 1 - i) % this->historySize;
+		this->history[index] = (BlocksGenerator::eBlockType)((recentBlocks >> (i * RECENT_BLOCK_BITS)) & ((1u << RECENT_BLOCK_BITS) - 1));
+	}
+}
+
+/*
+This function returns the position in the stream the randomizer has to start from (after a reset) to pick the block at the given position.
+In the weighted mode every block is independent, in the bag mode the bag that holds the block is dealt again, and in the history mode
+no block is picked again, since the history is set with setHistory.
+*/
+unsigned int BlockRandomizer::getReplayStart(unsigned int counter) const {
+	if (this->mode == RandomizerConfig::BAG_MODE) {
+		return counter - counter % this->bagSize;
+	}
+
+	return counter;
+}
+
+/*
+This function returns the fingerprint of the randomizer's settings.
+*/
+unsigned int BlockRandomizer::getFingerprint() const {
+	return this->fingerprint;
+}
\ No newline at end of file
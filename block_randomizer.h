@@ -0,0 +1,58 @@
+#ifndef __BLOCK_RANDOMIZER_H
+#define __BLOCK_RANDOMIZER_H
+
+#include "blocks_generator.h"
+#include "random_stream.h"
+#include "randomizer_config.h"
+
+/*
+Picks the types of the blocks of a game according to a RandomizerConfig:
+* Weighted - each block is picked independently, in O(1) using an alias table of the weights.
+* Bag - the blocks are dealt from a shuffled bag that holds the given amount of copies of each block, and the bag is refilled when it is empty.
+* History - a block that is one of the last blocks is picked again (up to a given amount of times), so repeats are rare.
+Every block takes exactly one number from the random stream, so the position in the game's blocks is the stream's counter.
+*/
+class BlockRandomizer {
+public:
+	constexpr static int TYPES_AMOUNT = RandomizerConfig::BLOCK_TYPES_AMOUNT;
+	constexpr static int RECENT_BLOCK_BITS = 3; //The size of a block in a packed list of recent blocks (see setHistory).
+	constexpr static unsigned long long NO_RECENT_BLOCKS = (1ull << (RECENT_BLOCK_BITS * RandomizerConfig::MAX_HISTORY_SIZE)) - 1; //A list that holds no blocks.
+
+private:
+	//The alias table: a uniformly picked column i is kept with a chance of keepChance[i] / 2^32, and replaced by alias[i] otherwise.
+	unsigned int keepChance[TYPES_AMOUNT];
+	unsigned char alias[TYPES_AMOUNT];
+
+	RandomizerConfig::eMode mode = RandomizerConfig::WEIGHTED_MODE;
+	unsigned int fingerprint = 0; //This property saves the fingerprint of the settings (see RandomizerConfig::getFingerprint).
+
+	//Bag mode properties.
+	int bagCounts[TYPES_AMOUNT]; //This property saves the amount of copies of each block in a full bag.
+	int bagSize = 0;
+	int bagLeft[TYPES_AMOUNT]; //This property saves the amount of copies of each block that are still in the current bag.
+	int bagLeftSize = 0;
+
+	//History mode properties.
+	BlocksGenerator::eBlockType history[RandomizerConfig::MAX_HISTORY_SIZE]; //A ring buffer of the last blocks.
+	int historySize = 0;
+	int historyRolls = 0;
+	int historyHead = 0;
+
+	void buildAliasTable(const double weights[TYPES_AMOUNT]);
+	BlocksGenerator::eBlockType sampleAlias(unsigned int number) const;
+	BlocksGenerator::eBlockType nextFromBag(unsigned int number);
+	BlocksGenerator::eBlockType nextWithHistory(unsigned int number);
+
+public:
+	BlockRandomizer();
+	BlockRandomizer(const RandomizerConfig& config);
+
+	void configure(const RandomizerConfig& config);
+	void reset();
+	BlocksGenerator::eBlockType next(RandomStream& random);
+	void setHistory(unsigned long long recentBlocks, unsigned int counter);
+	unsigned int getReplayStart(unsigned int counter) const;
+	unsigned int getFingerprint() const;
+};
+
+#endif
\ No newline at end of file
@@ -1,67 +1,37 @@
 #include "blocks_generator.h"
 
+const int BlocksGenerator::SHAPES[SHAPES_AMOUNT][SHAPE_SIZE][2] = {
+	{{0, 0}, {1, 0}, {0, 1}, {1, 1}}, //Square.
+	{{0, 0}, {1, 0}, {2, 0}, {3, 0}}, //Line.
+	{{0, 0}, {1, 0}, {1, 1}, {2, 1}}, //Snake.
+	{{0, 0}, {0, 1}, {1, 1}, {2, 1}}, //Gamma.
+	{{0, 0}, {-1, 1}, {0, 1}, {1, 1}} //Plus.
+};
+
+const int BlocksGenerator::DEFAULT_WEIGHTS[BOMB_BLOCK + 1] = {16, 16, 16, 16, 16, 10, 10};
+
 /*
-This function returns a random block.
+This function receives a block type and creates a block of that type at the initial location of the blocks.
 */
-Block * BlocksGenerator::getRandomBlock() {
+Block * BlocksGenerator::createBlock(eBlockType blockType) {
+	if (blockType == JOKER_BLOCK) {
+		return (Block *)new Joker(Point());
+	}
+	else if (blockType == BOMB_BLOCK) {
+		return (Block *)new Bomb(Point());
+	}
+
 	//Getting the default values for a general point in the game.
 	int xLocation = Point::MIDDLE_X_POSITION;
 	int yLocation = Point::GAME_LOCATION_OFFSET_Y;
 
-	vector<Point *> blockLocations;
-
-	int randNum = (rand() % 100) + 1; //Calculating a number between 1 and 100.
+	BlockSquares blockLocations;
 
-	//Checking which block the random number is applicable to.
-	if (randNum <= SQUARE_CHANCE) {
-		//Setting the square's locations according to the initial location of the square.
-		blockLocations.reserve(4);
-		blockLocations.push_back(new Point(xLocation, yLocation));
-		blockLocations.push_back(new Point(xLocation + 1, yLocation));
-		blockLocations.push_back(new Point(xLocation, yLocation + 1));
-		blockLocations.push_back(new Point(xLocation + 1, yLocation + 1));
+	//Setting the block's locations according to the initial location of the block.
+	for (int i = 0; i < SHAPE_SIZE; i++) {
+		blockLocations.add(new Point(xLocation + SHAPES[blockType][i][0], yLocation + SHAPES[blockType][i][1]));
 	}
-	else if (randNum <= LINE_CHANCE) {
-		//Setting the line's locations according to the initial location of the line.
-		blockLocations.reserve(4);
-		blockLocations.push_back(new Point(xLocation, yLocation));
-		blockLocations.push_back(new Point(xLocation + 1, yLocation));
-		blockLocations.push_back(new Point(xLocation + 2, yLocation));
-		blockLocations.push_back(new Point(xLocation + 3, yLocation));
-	}
-	else if (randNum <= SNAKE_CHANCE) {
-		//Setting the snake's locations according to the initial location of the snake.
-		blockLocations.reserve(4);
-		blockLocations.push_back(new Point(xLocation, yLocation));
-		blockLocations.push_back(new Point(xLocation + 1, yLocation));
-		blockLocations.push_back(new Point(xLocation + 1, yLocation + 1));
-		blockLocations.push_back(new Point(xLocation + 2, yLocation + 1));
-	}
-	else if (randNum <= GAMMA_CHANCE) {
-		//Setting the gammas's locations according to the initial location of the gamma.
-		blockLocations.reserve(4);
-		blockLocations.push_back(new Point(xLocation, yLocation));
-		blockLocations.push_back(new Point(xLocation, yLocation + 1));
-		blockLocations.push_back(new Point(xLocation + 1, yLocation + 1));
-		blockLocations.push_back(new Point(xLocation + 2, yLocation + 1));
-	}
-	else if (randNum <= PLUS_CHANCE) {
-		//Setting the plus' locations according to the initial location of the plus.
-		blockLocations.reserve(4);
-		blockLocations.push_back(new Point(xLocation, yLocation));
-		blockLocations.push_back(new Point(xLocation - 1, yLocation + 1));
-		blockLocations.push_back(new Point(xLocation, yLocation + 1));
-		blockLocations.push_back(new Point(xLocation + 1, yLocation + 1));
-	}
-	else {
-		if (randNum <= JOKER_CHANCE) {
-			return (Block *)new Joker(Point());
-		}
-		else {
-			return (Block *)new Bomb(Point());
-		}
-	}
-	
+
 	return (Block *)new GeneralBlock(blockLocations);
 }
 
@@ -6,17 +6,19 @@
 #include "joker.h"
 
 class BlocksGenerator {
-protected:
-	constexpr static int SQUARE_CHANCE = 16;
-	constexpr static int LINE_CHANCE = 32;
-	constexpr static int SNAKE_CHANCE = 48;
-	constexpr static int GAMMA_CHANCE = 64;
-	constexpr static int PLUS_CHANCE = 80;
-	constexpr static int JOKER_CHANCE = 90;
-	constexpr static int BOMB_CHANCE = 100;
-
 public:
-	static Block * getRandomBlock();
+	enum eBlockType {SQUARE_BLOCK, LINE_BLOCK, SNAKE_BLOCK, GAMMA_BLOCK, PLUS_BLOCK, JOKER_BLOCK, BOMB_BLOCK};
+
+	constexpr static int SHAPES_AMOUNT = 5; //The amount of block types that are made of several squares (all types before JOKER_BLOCK).
+	constexpr static int SHAPE_SIZE = 4;
+
+	static const int SHAPES[SHAPES_AMOUNT][SHAPE_SIZE][2]; //The location of each square of each shape relative to the initial location of the block (x, y).
+
+	static const int DEFAULT_WEIGHTS[BOMB_BLOCK + 1]; //The chance (in percents) of each block in the game's original mix, used when no other mix is configured.
+
+	static_assert(SHAPE_SIZE <= BlockSquares::MAX_SQUARES, "A block cannot hold all of the squares of a shape.");
+
+	static Block * createBlock(eBlockType blockType);
 
 	static bool isJoker(Block *block);
 	static bool isBomb(Block *block);
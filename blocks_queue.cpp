@@ -0,0 +1,122 @@
+#include "blocks_queue.h"
+
+/*
+Constructor - fills the queue using the given seed.
+*/
+BlocksQueue::BlocksQueue(unsigned int seed) {
+	this->reset(seed);
+}
+
+/*
+This function empties the queue and fills it again with blocks generated from the given seed.
+The current settings of the randomizer are used, so a change of the settings applies from the next game.
+*/
+void BlocksQueue::reset(unsigned int seed) {
+	this->random.reset(seed);
+	this->randomizer.configure(RandomizerConfig::getCurrent());
+	this->head = 0;
+	this->size = 0;
+	this->recentBlocks = BlockRandomizer::NO_RECENT_BLOCKS;
+
+	while (this->size < CAPACITY) {
+		this->refill();
+	}
+}
+
+/*
+This function generates a batch of blocks at the end of the queue.
+*/
+void BlocksQueue::refill() {
+	for (int i = 0; i < REFILL_BATCH; i++) {
+		this->blockTypes[(this->head + this->size) % CAPACITY] = this->randomizer.next(this->random);
+		this->size++;
+	}
+}
+
+/*
+This function removes the next block from the queue and returns its type.
+*/
+BlocksGenerator::eBlockType BlocksQueue::pop() {
+	BlocksGenerator::eBlockType blockType = this->blockTypes[this->head];
+
+	this->head = (this->head + 1) % CAPACITY;
+	this->size--;
+	this->recentBlocks = ((this->recentBlocks << BlockRandomizer::RECENT_BLOCK_BITS) | blockType) & BlockRandomizer::NO_RECENT_BLOCKS;
+
+	if (this->size <= CAPACITY - REFILL_BATCH) { //There is room for a whole batch, so we generate it now instead of generating one block at a time.
+		this->refill();
+	}
+
+	return blockType;
+}
+
+/*
+This function returns the type of an upcoming block without removing it (0 is the next block). The index must be lower than MAX_LOOKAHEAD.
+*/
+BlocksGenerator::eBlockType BlocksQueue::peek(int index) const {
+	return this->blockTypes[(this->head + index) % CAPACITY];
+}
+
+/*
+This function returns the seed the blocks are generated from.
+*/
+unsigned int BlocksQueue::getSeed() const {
+	return this->random.getSeed();
+}
+
+/*
+This function returns how many blocks were generated from the seed so far.
+*/
+unsigned int BlocksQueue::getCounter() const {
+	return this->random.getCounter();
+}
+
+/*
+This function returns how many blocks are in the queue.
+*/
+int BlocksQueue::getSize() const {
+	return this->size;
+}
+
+/*
+This function returns the last blocks that were taken from the queue (the randomizer's history when the first block in the queue was picked),
+packed BlockRandomizer::RECENT_BLOCK_BITS bits each with the last block in the lowest bits.
+*/
+unsigned long long BlocksQueue::getRecentBlocks() const {
+	return this->recentBlocks;
+}
+
+/*
+This function returns the fingerprint of the settings the blocks are picked with.
+*/
+unsigned int BlocksQueue::getRandomizerFingerprint() const {
+	return this->randomizer.getFingerprint();
+}
+
+/*
+This function sets the queue to the state it had when it held the given amount of blocks, the given amount of blocks were generated from the seed
+and the given blocks were the last ones taken from it. The settings of the randomizer are not changed.
+Each block takes exactly one number from the random stream, so the blocks in the queue are the last size blocks that were generated.
+The randomizer may depend on earlier blocks: the history is set from the recent blocks, and the blocks of the current bag are generated again.
+*/
+void BlocksQueue::restore(unsigned int seed, unsigned int counter, int size, unsigned long long recentBlocks) {
+	unsigned int firstInQueue = counter - size;
+
+	this->random.reset(seed);
+	this->randomizer.reset();
+	this->randomizer.setHistory(recentBlocks, firstInQueue);
+	this->random.setCounter(this->randomizer.getReplayStart(firstInQueue));
+	this->recentBlocks = recentBlocks;
+
+	while (this->random.getCounter() < firstInQueue) {
+		this->randomizer.next(this->random);
+	}
+
+	this->head = 0;
+	this->size = 0;
+
+	while (this->size < size) {
+		this->blockTypes[this->size] = this->randomizer.next(this->random);
+		this->size++;
+	}
+}
\ No newline at end of file
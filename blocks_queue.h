@@ -0,0 +1,44 @@
+#ifndef __BLOCKS_QUEUE_H
+#define __BLOCKS_QUEUE_H
+
+#include "blocks_generator.h"
+#include "random_stream.h"
+#include "block_randomizer.h"
+
+/*
+A fixed-size ring buffer of the next blocks of the game.
+The blocks are generated ahead of time in batches from the game's random stream (using the settings of the randomizer when the queue was reset),
+so taking a block or looking at the upcoming blocks does not allocate.
+*/
+class BlocksQueue {
+public:
+	constexpr static int CAPACITY = 16;
+	constexpr static int REFILL_BATCH = 8;
+	constexpr static int MAX_LOOKAHEAD = CAPACITY - REFILL_BATCH; //The amount of blocks that are always available after a block was taken.
+
+private:
+	BlocksGenerator::eBlockType blockTypes[CAPACITY];
+	int head = 0; //This property saves the index of the next block in the ring buffer.
+	int size = 0;
+	unsigned long long recentBlocks = BlockRandomizer::NO_RECENT_BLOCKS; //This property saves the last blocks taken from the queue (see getRecentBlocks).
+	RandomStream random;
+	BlockRandomizer randomizer;
+
+	void refill();
+
+public:
+	BlocksQueue(unsigned int seed = 0);
+
+	void reset(unsigned int seed);
+	BlocksGenerator::eBlockType pop();
+	BlocksGenerator::eBlockType peek(int index) const;
+
+	unsigned int getSeed() const;
+	unsigned int getCounter() const;
+	int getSize() const;
+	unsigned long long getRecentBlocks() const;
+	unsigned int getRandomizerFingerprint() const;
+	void restore(unsigned int seed, unsigned int counter, int size, unsigned long long recentBlocks);
+};
+
+#endif
\ No newline at end of file
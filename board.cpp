@@ -0,0 +1,289 @@
+#include "board.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+This function receives a non-zero value and returns the index of its lowest set bit.
+*/
+int Board::countTrailingZeros(unsigned int value) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, value);
+
+	return (int)index;
+#else
+	return __builtin_ctz(value);
+#endif
+}
+
+/*
+This function receives a non-zero value and returns the index of its highest set bit.
+*/
+int Board::findLastSetBit(unsigned int value) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse(&index, value);
+
+	return (int)index;
+#else
+	return 31 - __builtin_clz(value);
+#endif
+}
+
+/*
+This function receives a value and returns the amount of bits set in it.
+*/
+int Board::countSetBits(unsigned int value) {
+#ifdef _MSC_VER
+	return (int)__popcnt(value);
+#else
+	return __builtin_popcount(value);
+#endif
+}
+
+/*
+This function receives an index and returns a mask of all the bits above it (the rows beneath it / the columns to its right).
+*/
+unsigned int Board::getMaskBelow(int index) {
+	return ~((2u << index) - 1);
+}
+
+/*
+This function returns whether the square at the given row and column is used.
+*/
+bool Board::isUsed(int row, int col) const {
+	return (this->rowMasks[row] >> col) & 1;
+}
+
+/*
+This function returns whether all of the squares in the given row are used.
+*/
+bool Board::isRowFull(int row) const {
+	return this->rowMasks[row] == FULL_ROW_MASK;
+}
+
+/*
+This function marks the square at the given row and column as used.
+*/
+void Board::setUsed(int row, int col) {
+	this->rowMasks[row] |= 1u << col;
+	this->colMasks[col] |= 1u << row;
+}
+
+/*
+This function marks the square at the given row and column as free.
+*/
+void Board::clearUsed(int row, int col) {
+	this->rowMasks[row] &= ~(1u << col);
+	this->colMasks[col] &= ~(1u << row);
+}
+
+/*
+This function marks all of the squares in the board as free.
+*/
+void Board::clear() {
+	for (int i = 0; i < ROWS; i++) {
+		this->rowMasks[i] = 0;
+	}
+
+	for (int j = 0; j < COLS; j++) {
+		this->colMasks[j] = 0;
+	}
+}
+
+/*
+This function receives a range of rows, finds all of the full rows inside it in a single scan and removes them from the board.
+The rows above the removed rows are moved down only once, no matter how many rows were removed.
+The function returns the amount of rows that were removed.
+*/
+int Board::removeFullRows(int topRow, int bottomRow) {
+	unsigned int removedRows = 0;
+
+	//Finding the full rows inside the given range.
+	for (int i = topRow; i <= bottomRow; i++) {
+		if (this->isRowFull(i)) {
+			removedRows |= 1u << i;
+		}
+	}
+
+	if (removedRows == 0) {
+		return 0;
+	}
+
+	//Compacting the rows from the bottom of the range upwards - each row that is not full is copied to the next free row beneath it.
+	int targetRow = bottomRow;
+
+	for (int i = bottomRow; i >= 0; i--) {
+		if (!((removedRows >> i) & 1)) {
+			this->rowMasks[targetRow--] = this->rowMasks[i];
+		}
+	}
+
+	//Clearing the top rows in the board since their content was moved down.
+	for (int i = targetRow; i >= 0; i--) {
+		this->rowMasks[i] = 0;
+	}
+
+	//Removing the same rows from each column - every bit above a removed row moves one row down.
+	//The rows are removed from the top down so the indexes of the rows that were not handled yet are not changed.
+	for (int j = 0; j < COLS; j++) {
+		unsigned int mask = this->colMasks[j];
+		unsigned int rows = removedRows;
+
+		while (rows != 0) {
+			int row = countTrailingZeros(rows);
+			unsigned int above = mask & ((1u << row) - 1);
+
+			mask = (mask & getMaskBelow(row)) | (above << 1);
+			rows &= rows - 1;
+		}
+
+		this->colMasks[j] = (unsigned short)mask;
+	}
+
+	return countSetBits(removedRows);
+}
+
+/*
+This function returns the height of the given column (0 if the column is empty and ROWS if it is full up to the top row).
+*/
+int Board::getColumnHeight(int col) const {
+	if (this->colMasks[col] == 0) {
+		return 0;
+	}
+
+	return ROWS - countTrailingZeros(this->colMasks[col]);
+}
+
+/*
+This function returns the amount of free squares directly beneath the given square in its column before a used square / the bottom of the board is reached.
+*/
+int Board::getDropDistance(int row, int col) const {
+	unsigned int usedBelow = this->colMasks[col] & getMaskBelow(row);
+
+	if (usedBelow == 0) {
+		return ROWS - 1 - row;
+	}
+
+	return countTrailingZeros(usedBelow) - row - 1;
+}
+
+/*
+This function returns the first free row beneath the given square in its column, or -1 if there is no free square beneath it.
+*/
+int Board::findFreeRowBelow(int row, int col) const {
+	unsigned int freeBelow = ~this->colMasks[col] & FULL_COL_MASK & getMaskBelow(row);
+
+	if (freeBelow == 0) {
+		return -1;
+	}
+
+	return countTrailingZeros(freeBelow);
+}
+
+/*
+This function returns the last (lowest) free row beneath the given square in its column, or -1 if there is no free square beneath it.
+*/
+int Board::findLastFreeRowBelow(int row, int col) const {
+	unsigned int freeBelow = ~this->colMasks[col] & FULL_COL_MASK & getMaskBelow(row);
+
+	if (freeBelow == 0) {
+		return -1;
+	}
+
+	return findLastSetBit(freeBelow);
+}
+
+/*
+This function returns the amount of free squares beneath the given square in its column (including free squares under used ones).
+*/
+int Board::countFreeRowsBelow(int row, int col) const {
+	return countSetBits(~this->colMasks[col] & FULL_COL_MASK & getMaskBelow(row));
+}
+
+/*
+This function returns the first free column to the right of the given square in its row, or -1 if there is no free square to its right.
+*/
+int Board::findFreeColRight(int row, int col) const {
+	unsigned int freeRight = ~this->rowMasks[row] & FULL_ROW_MASK & getMaskBelow(col);
+
+	if (freeRight == 0) {
+		return -1;
+	}
+
+	return countTrailingZeros(freeRight);
+}
+
+/*
+This function returns the first free column to the left of the given square in its row, or -1 if there is no free square to its left.
+*/
+int Board::findFreeColLeft(int row, int col) const {
+	unsigned int freeLeft = ~this->rowMasks[row] & ((1u << col) - 1);
+
+	if (freeLeft == 0) {
+		return -1;
+	}
+
+	return findLastSetBit(freeLeft);
+}
+
+/*
+This function returns the used squares of a row as a mask (bit j is set when the square at column j is used).
+*/
+unsigned short Board::getRowMask(int row) const {
+	return this->rowMasks[row];
+}
+
+/*
+This function receives the masks of all of the rows (as returned by getRowMask) and sets the board's squares according to them.
+*/
+void Board::setRowMasks(const unsigned short rowMasks[ROWS]) {
+	for (int j = 0; j < COLS; j++) {
+		this->colMasks[j] = 0;
+	}
+
+	for (int i = 0; i < ROWS; i++) {
+		unsigned int rowMask = rowMasks[i] & FULL_ROW_MASK;
+
+		this->rowMasks[i] = (unsigned short)rowMask;
+
+		for (; rowMask != 0; rowMask &= rowMask - 1) { //Going over the used squares of the row.
+			this->colMasks[countTrailingZeros(rowMask)] |= (unsigned short)(1u << i);
+		}
+	}
+}
+
+/*
+This function writes the board into a given file (a used square is written as 1 and a free square as 0).
+*/
+void Board::saveToFile(ofstream& outFile) const {
+	int usedPoints[ROWS][COLS];
+
+	for (int i = 0; i < ROWS; i++) {
+		for (int j = 0; j < COLS; j++) {
+			usedPoints[i][j] = this->isUsed(i, j) ? 1 : 0;
+		}
+	}
+
+	outFile.write((const char *)usedPoints, sizeof(int) * ROWS * COLS);
+}
+
+/*
+This function reads the board from a given file that was written by the saveToFile function.
+*/
+void Board::loadFromFile(ifstream& inFile) {
+	int usedPoints[ROWS][COLS];
+
+	inFile.read((char *)usedPoints, sizeof(int) * ROWS * COLS);
+	this->clear();
+
+	for (int i = 0; i < ROWS; i++) {
+		for (int j = 0; j < COLS; j++) {
+			if (usedPoints[i][j] != 0) {
+				this->setUsed(i, j);
+			}
+		}
+	}
+}
\ No newline at end of file
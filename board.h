@@ -0,0 +1,49 @@
+#ifndef __BOARD_H
+#define __BOARD_H
+
+#include <fstream>
+using namespace std;
+
+class Board {
+public:
+	constexpr static int ROWS = 15;
+	constexpr static int COLS = 10;
+
+	constexpr static unsigned int FULL_ROW_MASK = (1u << COLS) - 1;
+	constexpr static unsigned int FULL_COL_MASK = (1u << ROWS) - 1;
+
+private:
+	unsigned short rowMasks[ROWS] = {}; //Bit j of rowMasks[i] is set when the square at row i and column j is used.
+	unsigned short colMasks[COLS] = {}; //Bit i of colMasks[j] is set when the square at row i and column j is used (the same board, indexed by column).
+
+	static unsigned int getMaskBelow(int index);
+
+public:
+	bool isUsed(int row, int col) const;
+	bool isRowFull(int row) const;
+	void setUsed(int row, int col);
+	void clearUsed(int row, int col);
+	void clear();
+
+	int removeFullRows(int topRow, int bottomRow);
+
+	int getColumnHeight(int col) const;
+	int getDropDistance(int row, int col) const;
+	int findFreeRowBelow(int row, int col) const;
+	int findLastFreeRowBelow(int row, int col) const;
+	int countFreeRowsBelow(int row, int col) const;
+	int findFreeColRight(int row, int col) const;
+	int findFreeColLeft(int row, int col) const;
+
+	unsigned short getRowMask(int row) const;
+	void setRowMasks(const unsigned short rowMasks[ROWS]);
+
+	void saveToFile(ofstream& outFile) const;
+	void loadFromFile(ifstream& inFile);
+
+	static int countTrailingZeros(unsigned int value);
+	static int findLastSetBit(unsigned int value);
+	static int countSetBits(unsigned int value);
+};
+
+#endif
\ No newline at end of file
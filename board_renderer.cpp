@@ -0,0 +1,57 @@
+#include "board_renderer.h"
+
+/*
+Constructor - receives the stream the squares are written to.
+The content of the console is not known yet, so the first frame is painted completely.
+*/
+BoardRenderer::BoardRenderer(ostream& out) : out(out) {
+	this->invalidate();
+}
+
+/*
+This function moves the console's cursor to the given location.
+*/
+void BoardRenderer::moveCursor(int x, int y) {
+	gotoxy(x, y);
+}
+
+/*
+This function marks all of the squares as unknown so the next frame repaints the whole board.
+*/
+void BoardRenderer::invalidate() {
+	for (int i = 0; i < Board::ROWS; i++) {
+		for (int j = 0; j < Board::COLS; j++) {
+			this->displayed[i][j] = UNKNOWN_SQUARE_CHAR;
+		}
+	}
+}
+
+/*
+This function receives a frame (the char of each square of the board) and paints only the squares that differ from what is displayed in the console.
+The cursor is moved only when the next changed square is not right after the previously painted one.
+*/
+void BoardRenderer::render(const char frame[Board::ROWS][Board::COLS]) {
+	int cellsPainted = 0;
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		int nextCursorCol = -1; //The column the cursor is at after the last square painted in this row (-1 if nothing was painted yet).
+
+		for (int j = 0; j < Board::COLS; j++) {
+			if (this->displayed[i][j] == frame[i][j]) {
+				continue;
+			}
+
+			if (nextCursorCol != j) {
+				this->moveCursor(j + Point::GAME_LOCATION_OFFSET_X, i + Point::GAME_LOCATION_OFFSET_Y);
+			}
+
+			this->out << frame[i][j];
+			this->displayed[i][j] = frame[i][j];
+			nextCursorCol = j + 1;
+			cellsPainted++;
+		}
+	}
+
+	TRACE_COUNTER_ADD(CELLS_PAINTED, cellsPainted);
+	TRACE_COUNTER_ADD(BYTES_WRITTEN, cellsPainted); //Each square is a single char.
+}
\ No newline at end of file
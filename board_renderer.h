@@ -0,0 +1,31 @@
+#ifndef __BOARD_RENDERER_H
+#define __BOARD_RENDERER_H
+
+#include <iostream>
+#include "board.h"
+#include "point.h"
+#include "Gotoxy.h"
+#include "trace.h"
+using namespace std;
+
+class BoardRenderer {
+public:
+	constexpr static char UNKNOWN_SQUARE_CHAR = 0; //Marks a square whose content in the console is unknown, so it is always painted.
+
+private:
+	char displayed[Board::ROWS][Board::COLS]; //This property saves the char that is currently displayed in the console for each square of the board.
+
+protected:
+	ostream& out; //This property saves the stream the squares are written to.
+
+	virtual void moveCursor(int x, int y);
+
+public:
+	BoardRenderer(ostream& out = cout);
+	virtual ~BoardRenderer() = default;
+
+	void invalidate();
+	void render(const char frame[Board::ROWS][Board::COLS]);
+};
+
+#endif
\ No newline at end of file
@@ -6,8 +6,7 @@ Constructor - receives the initial location of where the block should be created
 Bomb::Bomb(const Point& location, char ch) {
 	this->ch = BOMB_SQUARE_CHAR;
 	this->rotateable = false;
-	this->blockLocations.reserve(BOMB_SIZE);
 
 	//Setting the bomb's location according to the initial location of the bomb.
-	this->blockLocations.push_back(new Point(location));
+	this->blockLocations.add(new Point(location));
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef __FRAME_H
+#define __FRAME_H
+
+#include "board.h"
+#include "blocks_generator.h"
+#include "allocation_tracker.h"
+
+/*
+Everything that is displayed in the console during a game, as the game was at one moment.
+The game fills a frame after each change and passes a copy of it to the render thread, which is the only one that writes to the console.
+A frame is plain data (it holds no pointers into the game), so the render thread never reads the game itself.
+*/
+struct Frame {
+	constexpr static int NEXT_BLOCKS_AMOUNT = 3;
+	constexpr static int NOTICE_SIZE = 128; //The longest notice is cut to NOTICE_SIZE - 1 characters.
+
+	unsigned int number; //The frames are numbered in the order they were published, so the renderer knows how many it has skipped.
+
+	bool isBoardVisible; //The board's boundaries and the upcoming blocks are displayed only after the first game was started or loaded.
+	char squares[Board::ROWS][Board::COLS];
+	BlocksGenerator::eBlockType nextBlocks[NEXT_BLOCKS_AMOUNT];
+
+	int score;
+	int blocksDropped;
+	bool hasBestScore;
+	int bestScore;
+	AllocationCounts gameAllocations;
+	AllocationCounts tickAllocations;
+
+	char notice[NOTICE_SIZE];
+};
+
+#endif
\ No newline at end of file
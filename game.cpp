@@ -0,0 +1,1096 @@
+#include "game.h"
+
+/*
+Destructor - removes the current block from the memory.
+*/
+Game::~Game() {
+	delete this->currentBlock;
+}
+
+/*
+This function starts a new game - it clears the board and the score and generates the game's blocks from the given seed.
+*/
+void Game::start(unsigned int seed) {
+	this->board.clear();
+
+	delete this->currentBlock;
+	this->currentBlock = nullptr;
+	this->ghostDistance = 0;
+
+	this->setScore(0);
+	this->setBlocksDropped(0);
+	this->nextBlocks.reset(seed);
+	this->isFailed = false;
+
+	AllocationCounts noAllocations = {0, 0, 0, 0};
+	this->lastTickAllocations = noAllocations;
+	this->gameAllocations = noAllocations;
+}
+
+/*
+This function runs one step of the game according to the action made by the user (or NO_ACTION if there was no action).
+When the game is built with TETRIS_TRACK_ALLOCATIONS, the allocations made in the step are counted as well.
+*/
+void Game::tick(eAction action) {
+#ifdef TETRIS_TRACK_ALLOCATIONS
+	AllocationCounts before = AllocationTracker::getCounts();
+
+	this->step(action);
+
+	this->lastTickAllocations = AllocationTracker::getCounts() - before;
+	this->gameAllocations += this->lastTickAllocations;
+#else
+	this->step(action);
+#endif
+
+	if (this->events != nullptr) { //Delivering the step's events to the subscribers.
+		this->events->flush();
+	}
+}
+
+/*
+This function runs one step of the game:
+it adds a new block if there is no current block, otherwise it handles the action and moves the block down / locks it in the board.
+This is the core of the game.
+*/
+void Game::step(eAction action) {
+	if (this->isFailed) {
+		return;
+	}
+
+	if (this->currentBlock == nullptr) { //If the current block that is dropping is null, then the previous block has reached the bottom of the board / the game has just started.
+		this->addNewBlock(); //Adding a new block to the board.
+		return;
+	}
+
+	this->moveBlock(action);
+	this->checkAndExplode(); //Checking if the current block is a bomb, if it is and it hits a square beneath it, it will explode.
+
+	//If the joker pause key was pressed and the current block is a joker block, then we should pause it.
+	if (action == JOKER_PAUSE && this->currentBlock != nullptr && BlocksGenerator::isJoker(this->currentBlock)) {
+		this->pauseJoker();
+	}
+	else if (this->currentBlock != nullptr && this->canBlockMoveDown()) { //If the current block is not a joker / the joker key was not pressed and it can move down, we should move the block down.
+		this->moveBlockDown();
+	}
+	else if (this->currentBlock != nullptr) { //Checking if we still have a block in the instance (it may have been removed if it was a bomb and it has exploded).
+		this->lockBlock();
+	}
+}
+
+/*
+This function moves the current block according to the given action (the joker's pause is not a move, so it is handled by the step itself).
+*/
+void Game::moveBlock(eAction action) {
+	if (action == MOVE_LEFT) {
+		this->checkAndExplode(action); //Checking if the current block is a bomb, and if so we should explode if possible.
+		this->moveBlockLeft(); //If the current block was a bomb and it has exploded, this function will not do anything.
+	}
+	else if (action == MOVE_DOWN) {
+		this->moveBlockToBottom();
+	}
+	else if (action == MOVE_RIGHT) {
+		this->checkAndExplode(action); //Checking if the current block is a bomb, and if so we should explode if possible.
+		this->moveBlockRight(); //If the current block was a bomb and it has exploded, this function will not do anything.
+	}
+	else if (action == ROTATE_RIGHT) {
+		this->rotateBlockRight();
+	}
+}
+
+/*
+This function handles an action between the game's steps: the current block is moved like in a step, but it does not move down and it is not locked
+(the joker's pause has no effect here). This way keypresses that arrive faster than the game's steps are all handled.
+*/
+void Game::act(eAction action) {
+	if (this->isFailed || this->currentBlock == nullptr) {
+		return;
+	}
+
+#ifdef TETRIS_TRACK_ALLOCATIONS
+	AllocationCounts before = AllocationTracker::getCounts();
+#endif
+
+	this->moveBlock(action);
+	this->checkAndExplode(); //Checking if the moved bomb hits a square beneath it, like the step does after the action.
+
+#ifdef TETRIS_TRACK_ALLOCATIONS
+	this->gameAllocations += AllocationTracker::getCounts() - before;
+#endif
+
+	if (this->events != nullptr) {
+		this->events->flush();
+	}
+}
+
+/*
+This function pauses the current joker block at its position and removes the row it paused at if the row is full.
+*/
+void Game::pauseJoker() {
+	BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::iterator itr = blockLocations.begin();
+
+	this->setUsedPoints(); //Setting the joker's location in the board.
+	this->emitEvent(GameEvent::JOKER_PAUSED);
+
+	int jokerRow = (*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y;
+
+	//Checking if we should remove the row the joker paused at.
+	//If so, we should increase the score by 50.
+	TRACE_ZONE("line clear");
+
+	if (this->board.removeFullRows(jokerRow, jokerRow) > 0) {
+		this->increaseScore(JOKER_LINE_REMOVED_SCORE); //Increasing the score by 50.
+		this->emitEvent(GameEvent::ROWS_CLEARED, 1);
+	}
+
+	delete this->currentBlock; //Deleting the current block from the memory since we don't need it anymore.
+	this->currentBlock = nullptr; //Setting the current block's pointer to null so we know we should add a new block.
+}
+
+/*
+This function is called when the current block cannot move down anymore - it removes the rows the block has filled and updates the score accordingly.
+*/
+void Game::lockBlock() {
+	TRACE_ZONE("line clear");
+	BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::iterator itr = blockLocations.begin();
+	BlockSquares::iterator itrEnd = blockLocations.end();
+	int topRow = ROWS - 1;
+	int bottomRow = 0;
+
+	//Finding the range of rows the block has filled, since only these rows could have become full.
+	for (; itr != itrEnd; ++itr) {
+		int row = (*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y;
+
+		if (row < topRow) {
+			topRow = row;
+		}
+
+		if (row > bottomRow) {
+			bottomRow = row;
+		}
+	}
+
+	this->emitEvent(GameEvent::BLOCK_LOCKED);
+
+	int removed = this->board.removeFullRows(topRow, bottomRow); //Indicating how many rows we have removed (if any).
+
+	//Checking how many rows we have removed.
+	switch (removed) {
+	case 1: //If we removed 1 row, we should check if it was removed by a joker or not because it affects the score.
+		if (BlocksGenerator::isJoker(this->currentBlock)) {
+			this->increaseScore(JOKER_LINE_REMOVED_SCORE);
+		}
+		else {
+			this->increaseScore(LINES_REMOVED_SCORE_1);
+		}
+
+		break;
+	case 2:
+		this->increaseScore(LINES_REMOVED_SCORE_2);
+		break;
+	case 3:
+		this->increaseScore(LINES_REMOVED_SCORE_3);
+		break;
+	case 4:
+		this->increaseScore(LINES_REMOVED_SCORE_4);
+		break;
+	}
+
+	if (removed > 0) {
+		this->emitEvent(GameEvent::ROWS_CLEARED, removed);
+	}
+
+	delete this->currentBlock; //Deleting the current block from the memory since we don't need it anymore.
+	this->currentBlock = nullptr; //Setting the current block's pointer to null so we know we should add a new block.
+}
+
+/*
+This function returns whether the current block can move down by 1 square.
+*/
+bool Game::canBlockMoveDown() {
+	TRACE_ZONE("collision");
+
+	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
+		return false;
+	}
+
+	const BlockSquares& points = this->currentBlock->getBlockLocations();
+	BlockSquares::const_iterator itr = points.begin();
+	Point *p;
+
+	if (BlocksGenerator::isJoker(this->currentBlock)) {
+		p = *itr;
+		int pX = p->getX();
+		int pY = p->getY();
+
+		//Checking if the joker has room anywehre in the same column it's moving down at.
+		if (this->board.findFreeRowBelow(pY - Point::GAME_LOCATION_OFFSET_Y, pX - Point::GAME_LOCATION_OFFSET_X) != -1) {
+			return true;
+		}
+
+		//Setting the current's block location in the board so we know the room was filled there because it cannot move down.
+		this->setUsedPoints();
+		return false;
+	}
+
+	BlockSquares::const_iterator itrEnd = points.end();
+
+	//If the block is not a joker, we handle it normally.
+	for (; itr != itrEnd; ++itr) {
+		p = *itr;
+
+		//Checking if the block reached the end of the board or if there is a part of another block beneath the current block.
+		if (this->board.getDropDistance(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X) == 0) {
+			//Setting the current's block locations in the board so we know the room was filled there because it cannot move down.
+			this->setUsedPoints();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+This function returns whether the current block can move right.
+*/
+bool Game::canBlockMoveRight() {
+	TRACE_ZONE("collision");
+
+	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
+		return false;
+	}
+
+	//If the current block is a joker, we assume it can move right because we handle it in the moveBlockRight method instead (to avoid code duplication).
+	if (BlocksGenerator::isJoker(this->currentBlock)) {
+		return true;
+	}
+
+	const BlockSquares& points = this->currentBlock->getBlockLocations();
+	BlockSquares::const_iterator itr = points.begin();
+	BlockSquares::const_iterator itrEnd = points.end();
+	Point *p;
+
+	for (; itr != itrEnd; ++itr) {
+		p = *itr;
+
+		if (p->getX() - Point::GAME_LOCATION_OFFSET_X == COLS - 1) { //Checking if the block reached the end of the board.
+			return false;
+		}
+
+		if (this->board.isUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X + 1)) { //Checking if there is a part of another block to the right of the current block.
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+This function returns whether the current block can move left.
+*/
+bool Game::canBlockMoveLeft() {
+	TRACE_ZONE("collision");
+
+	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
+		return false;
+	}
+
+	//If the current block is a joker, we assume it can move right because we handle it in the moveBlockRight method instead (to avoid code duplication).
+	if (BlocksGenerator::isJoker(this->currentBlock)) {
+		return true;
+	}
+
+	const BlockSquares& points = this->currentBlock->getBlockLocations();
+	BlockSquares::const_iterator itr = points.begin();
+	BlockSquares::const_iterator itrEnd = points.end();
+	Point *p;
+
+	for (; itr != itrEnd; ++itr) {
+		p = *itr;
+
+		if (p->getX() == Point::GAME_LOCATION_OFFSET_X) { //Checking if the block reached the end of the board.
+			return false;
+		}
+
+		if (this->board.isUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X - 1)) { //Checking if there is a part of another block to the left of the current block.
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+This function receives an output parameter which is an array of rotated points of the current block 
+and returns whether any of the rotated squares is overlapping an existing square in the board.
+*/
+bool Game::canBlockRotateRight() {
+	TRACE_ZONE("collision");
+
+	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
+		return false;
+	}
+
+	//If the current block is not a line, then we cannot rotate it (because the other shapes cannot rotate).
+	if (!this->currentBlock->isRotateable()) {
+		return false;
+	}
+
+	const BlockSquares& points = this->currentBlock->getBlockLocations();
+	BlockSquares::const_iterator itr = points.begin();
+	BlockSquares::const_iterator itrEnd = points.end();
+	bool ret = true;
+
+	//Checking if any square of the rotated block is not in a legal location.
+	for (; itr != itrEnd && ret; ++itr) {
+		Point rotated = this->currentBlock->getRotatedPoint(**itr);
+		Point *p = &rotated;
+
+		if (p->getY() > ROWS + Point::GAME_LOCATION_OFFSET_Y - 1) { //Checking if the current square reached beyond the bottom of the board.
+			ret = false;
+		}
+		else if (p->getX() < Point::GAME_LOCATION_OFFSET_X) { //Checking if the current square reached beyond the left side of the board.
+			ret = false;
+		}
+		else if (p->getX() > COLS + Point::GAME_LOCATION_OFFSET_X - 1) { //Checking if the current square reached beyond the right of the board.
+			ret = false;
+		}
+		else if (this->board.isUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X)) { //Checking if the current square is overlapping an existing square in the board.
+			ret = false;
+		}
+	}
+
+	return ret;
+}
+
+/*
+This function moves the current block down by 1 square.
+*/
+void Game::moveBlockDown() {
+	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
+		return;
+	}
+
+	BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::iterator itr = blockLocations.begin();
+	int startY = (*itr)->getY();
+
+	if (BlocksGenerator::isJoker(this->currentBlock)) { //If the current block is a joker, we should try to find the first position it can fit into.
+		Point *p = *itr;
+
+		int movedPosition = this->board.findFreeRowBelow(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X);
+
+		if (movedPosition != -1) {
+			p->setY(movedPosition + Point::GAME_LOCATION_OFFSET_Y);
+		}
+
+		this->updateGhost(); //The joker may jump over used squares, so its landing position is calculated again.
+	}
+	else { //Moving all of the block's locations 1 square down.
+		BlockSquares::iterator itrEnd = blockLocations.end();
+
+		for (; itr != itrEnd; ++itr) {
+			(*itr)->setY((*itr)->getY() + 1);
+		}
+
+		this->currentBlock->updateBlockProperties();
+		this->ghostDistance--; //The block still lands at the same position, which is now 1 square closer.
+	}
+
+	this->emitEvent(GameEvent::BLOCK_MOVED, 0, blockLocations.front()->getY() - startY, 0);
+}
+
+/*
+This function moves the current block 1 square to the right.
+*/
+void Game::moveBlockRight() {
+	if (!this->canBlockMoveRight()) { //Validating that the block can move right before we move it.
+		return;
+	}
+
+	BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::iterator itr = blockLocations.begin();
+	int startX = (*itr)->getX();
+
+	//If the current block is a joker, we should try to find the first position it can fit into.
+	if (BlocksGenerator::isJoker(this->currentBlock)) {
+		Point *p = *itr;
+
+		int pX = p->getX();
+		int pY = p->getY();
+
+		int movedPosition = this->board.findFreeColRight(pY - Point::GAME_LOCATION_OFFSET_Y, pX - Point::GAME_LOCATION_OFFSET_X);
+
+		if (movedPosition != -1) {
+			p->setX(movedPosition + Point::GAME_LOCATION_OFFSET_X);
+		}
+	}
+	else { //If the current block is not a joker, we should move all of its squares 1 square to the right.
+		BlockSquares::iterator itrEnd = blockLocations.end();
+
+		for (; itr != itrEnd; ++itr) {
+			(*itr)->setX((*itr)->getX() + 1);
+		}
+
+		this->currentBlock->updateBlockProperties();
+	}
+
+	this->updateGhost(); //The block moved sideways, so its landing position is calculated again.
+	this->emitEvent(GameEvent::BLOCK_MOVED, 0, 0, blockLocations.front()->getX() - startX); //A joker may have passed over used squares.
+}
+
+/*
+This function moves the current block 1 square to the right.
+*/
+void Game::moveBlockLeft() {
+	if (!this->canBlockMoveLeft()) { //Validating that the block can move right before we move it.
+		return;
+	}
+
+	BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::iterator itr = blockLocations.begin();
+	int startX = (*itr)->getX();
+	
+	//If the current block is a joker, we should try to find the first position it can fit into.
+	if (BlocksGenerator::isJoker(this->currentBlock)) {
+		int pX = (*itr)->getX();
+		int pY = (*itr)->getY();
+
+		int movedPosition = this->board.findFreeColLeft(pY - Point::GAME_LOCATION_OFFSET_Y, pX - Point::GAME_LOCATION_OFFSET_X);
+
+		if (movedPosition != -1) {
+			(*itr)->setX(movedPosition + Point::GAME_LOCATION_OFFSET_X);
+		}
+	}
+	else { //If the current block is not a joker, we should move all of its squares 1 square to the left.
+		BlockSquares::iterator itrEnd = blockLocations.end();
+
+		for (; itr != itrEnd; ++itr) {
+			(*itr)->setX((*itr)->getX() - 1);
+		}
+
+		this->currentBlock->updateBlockProperties();
+	}
+
+	this->updateGhost(); //The block moved sideways, so its landing position is calculated again.
+	this->emitEvent(GameEvent::BLOCK_MOVED, 0, 0, blockLocations.front()->getX() - startX); //A joker may have passed over used squares.
+}
+
+/*
+This function rotates the current block to the right if possible.
+*/
+void Game::rotateBlockRight() {
+	if (!this->canBlockRotateRight()) { //Checking if the current block can be rotated to the right.
+		return;
+	}
+
+	this->currentBlock->rotateRight(); //Rotating the block to the right.
+	this->updateGhost(); //The block's shape has changed, so its landing position is calculated again.
+	this->emitEvent(GameEvent::BLOCK_ROTATED, this->currentBlock->getRotatedAmount());
+}
+
+/*
+This function returns the amount of rows the current block can move down before it lands on another block / the bottom of the board.
+*/
+int Game::getBlockDropDistance() const {
+	const BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::const_iterator itr = blockLocations.begin();
+	BlockSquares::const_iterator itrEnd = blockLocations.end();
+	int distance = ROWS;
+
+	//The block lands according to the square with the shortest way down in its column.
+	for (; itr != itrEnd; ++itr) {
+		int squareDistance = this->board.getDropDistance((*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y, (*itr)->getX() - Point::GAME_LOCATION_OFFSET_X);
+
+		if (squareDistance < distance) {
+			distance = squareDistance;
+		}
+	}
+
+	return distance;
+}
+
+/*
+This function moves the current block to the last available position at the bottom of the board and increases the score for each square moved.
+The landing position is calculated directly from the board, so the block is moved only once.
+*/
+void Game::moveBlockToBottom() {
+	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
+		return;
+	}
+
+	BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::iterator itr = blockLocations.begin();
+	BlockSquares::iterator itrEnd = blockLocations.end();
+	int startY = (*itr)->getY();
+	int counter;
+
+	if (BlocksGenerator::isJoker(this->currentBlock)) {
+		//The joker jumps from one free square to the next one in its column, so it ends at the lowest free square after one jump per free square.
+		Point *p = *itr;
+		int row = p->getY() - Point::GAME_LOCATION_OFFSET_Y;
+		int col = p->getX() - Point::GAME_LOCATION_OFFSET_X;
+
+		counter = this->board.countFreeRowsBelow(row, col);
+
+		if (counter > 0) {
+			p->setY(this->board.findLastFreeRowBelow(row, col) + Point::GAME_LOCATION_OFFSET_Y);
+		}
+	}
+	else {
+		counter = this->getBlockDropDistance();
+
+		if (counter > 0) {
+			for (; itr != itrEnd; ++itr) {
+				(*itr)->setY((*itr)->getY() + counter);
+			}
+
+			this->currentBlock->updateBlockProperties();
+		}
+	}
+
+	this->ghostDistance = 0;
+	this->setUsedPoints(); //Setting the block's locations in the board since it cannot move down anymore.
+	this->increaseScore(counter * MOVE_TO_BOTTOM_SCORE_MULTIPLIER);
+
+	if (counter > 0) {
+		this->emitEvent(GameEvent::BLOCK_MOVED, 0, blockLocations.front()->getY() - startY, 0); //A joker may have passed over used squares, so it can move further than the counter.
+	}
+}
+
+/*
+This function takes the next block from the queue of upcoming blocks, adds it to the top of the board and sets it as the current block.
+*/
+void Game::addNewBlock() {
+	this->addBlock(this->nextBlocks.pop());
+}
+
+/*
+This function adds a block of the given type to the top of the board and sets it as the current block (replacing the current block, if there is one).
+It is used for the blocks taken from the queue, and by tools that analyze a position with a specific block.
+*/
+void Game::addBlock(BlocksGenerator::eBlockType blockType) {
+	delete this->currentBlock;
+	this->currentBlock = BlocksGenerator::createBlock(blockType);
+
+	const BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::const_iterator itr = blockLocations.begin();
+	BlockSquares::const_iterator itrEnd = blockLocations.end();
+
+	//Checking if we have created the block on top of another block and if so we should indicate the game has ended (using the isFailed property).
+	for (; itr != itrEnd; ++itr) {
+		Point *p = *itr;
+
+		if (this->board.isUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X)) {
+			this->isFailed = true;
+			this->ghostDistance = 0; //The block cannot move, so it has no landing position to display.
+			this->emitEvent(GameEvent::GAME_OVER);
+			return;
+		}
+	}
+
+	this->updateGhost();
+	this->increaseNumOfBlocks(); //Increasing the number of blocks used.
+	this->emitEvent(GameEvent::BLOCK_SPAWNED, blockType);
+}
+
+/*
+This function replaces the game's board with the given board (used for setting up positions, for example in the benchmarks).
+*/
+void Game::setBoard(const Board& board) {
+	this->board = board;
+	this->updateGhost();
+}
+
+/*
+This function receives a parameter score and sets the game's score to the given parameter.
+*/
+void Game::setScore(int score) {
+	this->score = score;
+}
+
+/*
+This function receives a parameter score and increases the game's score by the given parameter.
+*/
+void Game::increaseScore(int score) {
+	this->score += score;
+}
+
+/*
+This function receives a parameter score and decreases the game's score by the given parameter.
+*/
+void Game::decreaseScore(int score) {
+	this->score -= score;
+
+	if (this->score < 0) {
+		this->score = 0;
+	}
+}
+
+/*
+This function receives a parameter blocksDropped and sets the game's amount of blocks dropped to the given parameter.
+*/
+void Game::setBlocksDropped(int blocksDropped) {
+	this->blocksDropped = blocksDropped;
+}
+
+/*
+This function increases the number of blocks dropped by 1.
+*/
+void Game::increaseNumOfBlocks() {
+	this->blocksDropped++;
+}
+
+/*
+This function calculates where the current block will land and saves it in the ghostDistance property.
+It is called whenever the block moves sideways / rotates or the board changes, since moving down does not change the landing position.
+*/
+void Game::updateGhost() {
+	if (this->currentBlock == nullptr) {
+		this->ghostDistance = 0;
+		return;
+	}
+
+	if (BlocksGenerator::isJoker(this->currentBlock)) { //The joker passes through used squares, so it lands at the lowest free square of its column.
+		Point *p = this->currentBlock->getBlockLocations().front();
+		int row = p->getY() - Point::GAME_LOCATION_OFFSET_Y;
+		int landingRow = this->board.findLastFreeRowBelow(row, p->getX() - Point::GAME_LOCATION_OFFSET_X);
+
+		this->ghostDistance = (landingRow == -1) ? 0 : landingRow - row;
+	}
+	else {
+		this->ghostDistance = this->getBlockDropDistance();
+	}
+}
+
+/*
+This function receives a frame (the char of each square of the board) and fills it with the board, the current block and the current block's landing position.
+*/
+void Game::buildFrame(char frame[ROWS][COLS]) const {
+	for (int i = 0; i < ROWS; i++) {
+		for (int j = 0; j < COLS; j++) {
+			frame[i][j] = this->board.isUsed(i, j) ? Block::NORMAL_SQUARE_CHAR : ' ';
+		}
+	}
+
+	if (this->currentBlock != nullptr) {
+		const BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+		BlockSquares::const_iterator itr;
+
+		//Painting the landing position first, so the block itself is painted on top of it where they overlap.
+		if (this->ghostDistance > 0) {
+			for (itr = blockLocations.begin(); itr != blockLocations.end(); ++itr) {
+				frame[(*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y + this->ghostDistance][(*itr)->getX() - Point::GAME_LOCATION_OFFSET_X] = Block::GHOST_SQUARE_CHAR;
+			}
+		}
+
+		for (itr = blockLocations.begin(); itr != blockLocations.end(); ++itr) {
+			frame[(*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y][(*itr)->getX() - Point::GAME_LOCATION_OFFSET_X] = this->currentBlock->getChar();
+		}
+	}
+}
+
+/*
+This function receives a block and sets the board's used locations according to the received block's locations in the console.
+This function is called when the block should pause (when it doesn't move any further).
+*/
+void Game::setUsedPoints() {
+	const BlockSquares& points = this->currentBlock->getBlockLocations();
+	BlockSquares::const_iterator itr = points.begin();
+	BlockSquares::const_iterator itrEnd = points.end();
+
+	for (; itr != itrEnd; ++itr) {
+		Point *p = *itr;
+
+		this->board.setUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X);
+	}
+}
+
+/*
+This function receives a parameter speed and sets the game's speed according to the given parameter.
+*/
+void Game::setSpeed(int speed) {
+	this->speed = speed;
+}
+
+/*
+This function sets the stream the game's events are written to (nullptr stops writing events).
+The events of each step are delivered to the stream's subscribers at the end of the step.
+*/
+void Game::setEventStream(GameEventStream *events) {
+	this->events = events;
+}
+
+/*
+This function writes an event about the current block (if there is one) to the game's event stream.
+*/
+void Game::writeEvent(GameEvent::eType type, int amount, int rowsMoved, int colsMoved) {
+	GameEvent event = {(unsigned char)type, -1, -1, (signed char)rowsMoved, (signed char)colsMoved, (short)amount, this->score};
+
+	if (this->currentBlock != nullptr) {
+		Point *p = this->currentBlock->getBlockLocations().front();
+
+		event.row = (signed char)(p->getY() - Point::GAME_LOCATION_OFFSET_Y);
+		event.col = (signed char)(p->getX() - Point::GAME_LOCATION_OFFSET_X);
+	}
+
+	this->events->push(event);
+}
+
+/*
+This function returns the current game's score.
+*/
+int Game::getScore() const {
+	return this->score;
+}
+
+/*
+This function returns the current game's amount of blocks dropped.
+*/
+int Game::getNumOfBlocks() const {
+	return this->blocksDropped;
+}
+
+/*
+This function returns the game's speed in miliseconds (the time between two steps of the game).
+*/
+int Game::getSpeed() const {
+	return this->speed;
+}
+
+/*
+This function returns the allocations made in the last step of the game (only counted when the game is built with TETRIS_TRACK_ALLOCATIONS).
+*/
+AllocationCounts Game::getLastTickAllocations() const {
+	return this->lastTickAllocations;
+}
+
+/*
+This function returns the allocations made since the game has started (only counted when the game is built with TETRIS_TRACK_ALLOCATIONS).
+*/
+AllocationCounts Game::getGameAllocations() const {
+	return this->gameAllocations;
+}
+
+/*
+This function returns whether a block was created on top of another block, which means the game has ended.
+*/
+bool Game::isGameOver() const {
+	return this->isFailed;
+}
+
+/*
+This function returns the game's board.
+*/
+const Board& Game::getBoard() const {
+	return this->board;
+}
+
+/*
+This function returns the stream the game's events are written to (or nullptr if the game does not write events).
+*/
+GameEventStream * Game::getEventStream() const {
+	return this->events;
+}
+
+/*
+This function returns the block that is currently falling down (or nullptr if there is no such block).
+*/
+Block * Game::getCurrentBlock() const {
+	return this->currentBlock;
+}
+
+/*
+This function returns the queue of the game's upcoming blocks.
+*/
+const BlocksQueue& Game::getNextBlocks() const {
+	return this->nextBlocks;
+}
+
+/*
+This function returns how many rows beneath the current block it is going to land.
+*/
+int Game::getGhostDistance() const {
+	return this->ghostDistance;
+}
+
+/*
+This function receives the action made by the user (or NO_ACTION if there was no action), checks if the current block is a bomb
+and if it is, checks whether it should explode and if so - it explodes.
+*/
+void Game::checkAndExplode(eAction action) {
+	if (this->currentBlock == nullptr || !BlocksGenerator::isBomb(this->currentBlock)) //Checking that the current block exists and that it is a bomb.
+		return;
+
+	BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+	BlockSquares::iterator itr = blockLocations.begin();
+
+	Point *p = *itr; //Getting the bomb's location.
+
+	if (action == NO_ACTION) { //If the user did not make any action we should check if the bomb touches a square beneath it.
+		if (p->getY() - Point::GAME_LOCATION_OFFSET_Y == ROWS - 1) { //If the bomb reached the end of the board, we should remove it from the board.
+			this->board.clearUsed(ROWS - 1, p->getX() - Point::GAME_LOCATION_OFFSET_X);
+			this->emitEvent(GameEvent::BOMB_EXPLODED, 0); //The bomb did not remove any square.
+
+			delete this->currentBlock;
+			this->currentBlock = nullptr;
+		}
+		//Checking if the bomb is touching a square beneath it and if so - explode.
+		else if (p->getY() - Point::GAME_LOCATION_OFFSET_Y >= 0 && this->board.isUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y + 1, p->getX() - Point::GAME_LOCATION_OFFSET_X)) { //Checking if there is a part of another block beneath the current block.
+			this->explode(*p);
+		}
+	}
+	else if (action == MOVE_LEFT) { //If the user pressed on the move left key, we should check whether the bomb touches a square to its left and if so - explode.
+		if (p->getX() - Point::GAME_LOCATION_OFFSET_X > 0 && this->board.isUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X - 1)) {
+			this->explode(*p);
+		}
+	}
+	else if (action == MOVE_RIGHT) { //If the user pressed on the move right key, we should check whether the bomb touches a square to its right and if so - explode.
+		if (p->getX() - Point::GAME_LOCATION_OFFSET_X < COLS - 1 && this->board.isUsed(p->getY() - Point::GAME_LOCATION_OFFSET_Y, p->getX() - Point::GAME_LOCATION_OFFSET_X + 1)) {
+			this->explode(*p);
+		}
+	}
+}
+
+/*
+This function receives a location in the console, and removes all squares in 3x3 range around it.
+*/
+void Game::explode(Point p) {
+	TRACE_ZONE("explode");
+	int startX, startY;
+	int amountJumpX = 3;
+	int amountJumpY = 3;
+
+	startX = p.getX() - Point::GAME_LOCATION_OFFSET_X - 1;
+	startY = p.getY() - Point::GAME_LOCATION_OFFSET_Y - 1;
+
+	if (startX < 0) { //If the startX location of the removal is exceeding the game's left border, we should only remove 2 squares to the right.
+		startX = 0;
+		amountJumpX = 2;
+	}
+
+	if (startY < 0) { //If the startY location of the removal is exceeding the game's top border, we should only remove 2 squares to the bottom.
+		startY = 0;
+		amountJumpY = 2;
+	}
+
+	int removed = 0;
+
+	for (int i = startY; i < startY + amountJumpY && i < ROWS; i++) {
+		for (int j = startX; j < startX + amountJumpX && j < COLS; j++) {
+			if (this->board.isUsed(i, j)) { //Removing the squares the bomb exploded at and removing 50 points for each square removed.
+				this->decreaseScore(BOMB_EXPLODE_SCORE_PENALTY);
+				this->board.clearUsed(i, j);
+				removed++;
+			}
+		}
+	}
+
+	this->emitEvent(GameEvent::BOMB_EXPLODED, removed);
+
+	//Removing the current block's instance.
+	delete this->currentBlock;
+	this->currentBlock = nullptr;
+}
+
+/*
+This function returns the kind of the current block as it is saved in files and states (NO_BLOCK if there is no current block).
+*/
+char Game::getCurrentBlockType() const {
+	if (this->currentBlock == nullptr) {
+		return NO_BLOCK;
+	}
+	else if (BlocksGenerator::isJoker(this->currentBlock)) {
+		return JOKER_BLOCK;
+	}
+	else if (BlocksGenerator::isBomb(this->currentBlock)) {
+		return BOMB_BLOCK;
+	}
+
+	return REGULAR_BLOCK;
+}
+
+/*
+This function writes the current game into a given file.
+*/
+void Game::saveToFile(ofstream& outFile) const {
+	char blockType = this->getCurrentBlockType();
+
+	this->board.saveToFile(outFile); //Writing the board to the file.
+	outFile.write((const char *)&this->score, sizeof(int)); //Writing the score to the file.
+	outFile.write((const char *)&this->blocksDropped, sizeof(int)); //Writing the amount of dropped blocks to the file.
+	outFile.write((const char*)&this->speed, sizeof(int)); //Writing the current game's speed to the file.
+	outFile.write((const char *)&blockType, sizeof(char)); //Writing the current block type to the file.
+
+	if (blockType != NO_BLOCK) {
+		int blockRotatedAmount = this->currentBlock->getRotatedAmount();
+
+		outFile.write((const char *)&blockRotatedAmount, sizeof(int)); //Writing the amount of times the block was rotated.
+
+		const BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+
+		//Writing the current block's size to the file.
+		int blockLocationsSize = blockLocations.size();
+		outFile.write((const char *)&blockLocationsSize, sizeof(int));
+
+		//Writing the points in the current block's locations to the file.
+		BlockSquares::const_iterator itr = blockLocations.begin();
+		BlockSquares::const_iterator itrEnd = blockLocations.end();
+		for (; itr != itrEnd; ++itr) {
+			outFile.write((const char *)*itr, sizeof(Point));
+		}
+	}
+}
+
+/*
+This function reads the game from a given file that was written by the saveToFile function.
+The upcoming blocks are not saved in the file, so they are generated from the given seed.
+*/
+void Game::loadFromFile(ifstream& inFile, unsigned int seed) {
+	char blockType;
+	int blockSize;
+	Point p;
+
+	this->board.loadFromFile(inFile); //Reading the board from the file.
+	inFile.read((char *)&this->score, sizeof(int)); //Reading the score from the file.
+	inFile.read((char *)&this->blocksDropped, sizeof(int)); //Reading the amount of blocks dropped from the file.
+	inFile.read((char *)&this->speed, sizeof(int)); //Reading the game's speed from the file.
+	inFile.read((char *)&blockType, sizeof(char)); //Reading the current block's type.
+
+	delete this->currentBlock;
+
+	if (blockType == NO_BLOCK) {
+		this->currentBlock = nullptr;
+	}
+	else {
+		int blockRotatedAmount;
+		
+		inFile.read((char *)&blockRotatedAmount, sizeof(int)); //Reading the amount of times the current block was rotated.
+		inFile.read((char *)&blockSize, sizeof(int)); //Reading the current block's size.
+
+		BlockSquares blockLocations;
+
+		//Reading the current block's locations from the file (only a regular block keeps all of them).
+		for (int i = 0; i < blockSize; i++) {
+			inFile.read((char *)&p, sizeof(Point));
+
+			if (blockType == REGULAR_BLOCK && blockLocations.size() < BlockSquares::MAX_SQUARES) {
+				blockLocations.add(new Point(p));
+			}
+		}
+
+		//Initializing the current block.
+		if (blockType == REGULAR_BLOCK) {
+			this->currentBlock = new GeneralBlock(blockLocations);
+			this->currentBlock->setRotatedAmount(blockRotatedAmount);
+		}
+		else if (blockType == JOKER_BLOCK) {
+			this->currentBlock = new Joker(p);
+		}
+		else {
+			this->currentBlock = new Bomb(p);
+		}
+	}
+
+	this->nextBlocks.reset(seed);
+	this->isFailed = false;
+	this->updateGhost();
+}
+
+/*
+This function saves a snapshot of the game into the given state.
+The state holds no pointers, so it can be copied and restored later with loadState (for example, to undo moves or to try moves in a search).
+*/
+void Game::saveState(GameState& state) const {
+	for (int i = 0; i < ROWS; i++) {
+		state.rowMasks[i] = this->board.getRowMask(i);
+	}
+
+	state.blockType = this->getCurrentBlockType();
+	state.blockRotatedAmount = 0;
+
+	for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+		state.blockSquares[i][0] = 0;
+		state.blockSquares[i][1] = 0;
+	}
+
+	if (this->currentBlock != nullptr) {
+		const BlockSquares& blockLocations = this->currentBlock->getBlockLocations();
+		BlockSquares::const_iterator itr = blockLocations.begin();
+		BlockSquares::const_iterator itrEnd = blockLocations.end();
+
+		state.blockRotatedAmount = (unsigned char)this->currentBlock->getRotatedAmount(); //Only the parity of the amount affects the rotation.
+
+		for (int i = 0; itr != itrEnd && i < GameState::MAX_BLOCK_SQUARES; ++itr, i++) {
+			state.blockSquares[i][0] = (signed char)((*itr)->getX() - Point::GAME_LOCATION_OFFSET_X);
+			state.blockSquares[i][1] = (signed char)((*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y);
+		}
+	}
+
+	state.score = this->score;
+	state.blocksDropped = this->blocksDropped;
+	state.seed = this->nextBlocks.getSeed();
+	state.blocksGenerated = this->nextBlocks.getCounter();
+	state.nextBlocksAmount = (unsigned short)this->nextBlocks.getSize();
+	state.isFailed = this->isFailed ? 1 : 0;
+	state.randomizerId = (unsigned short)(this->nextBlocks.getRandomizerFingerprint() & GameState::RANDOMIZER_ID_MASK);
+
+	unsigned long long recentBlocks = this->nextBlocks.getRecentBlocks();
+
+	for (int i = 0; i < GameState::RECENT_BLOCKS_BYTES; i++) {
+		state.recentBlocks[i] = (unsigned char)(recentBlocks >> (i * 8));
+	}
+}
+
+/*
+This function restores the game from a state that was saved with saveState, and returns whether it succeeded.
+The game's speed is not changed. A state that was saved by a game with other settings of the randomizer is not loaded,
+since the game would pick different blocks after it.
+*/
+bool Game::loadState(const GameState& state) {
+	if (state.randomizerId != (this->nextBlocks.getRandomizerFingerprint() & GameState::RANDOMIZER_ID_MASK)) {
+		return false;
+	}
+
+	unsigned long long recentBlocks = 0;
+
+	for (int i = 0; i < GameState::RECENT_BLOCKS_BYTES; i++) {
+		recentBlocks |= (unsigned long long)state.recentBlocks[i] << (i * 8);
+	}
+
+	this->board.setRowMasks(state.rowMasks);
+	this->score = state.score;
+	this->blocksDropped = state.blocksDropped;
+	this->isFailed = (state.isFailed != 0);
+	this->nextBlocks.restore(state.seed, state.blocksGenerated, state.nextBlocksAmount, recentBlocks);
+
+	delete this->currentBlock;
+	this->currentBlock = nullptr;
+
+	if (state.blockType != NO_BLOCK) {
+		Point p(state.blockSquares[0][0] + Point::GAME_LOCATION_OFFSET_X, state.blockSquares[0][1] + Point::GAME_LOCATION_OFFSET_Y);
+
+		if (state.blockType == REGULAR_BLOCK) {
+			BlockSquares blockLocations;
+
+			for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+				blockLocations.add(new Point(state.blockSquares[i][0] + Point::GAME_LOCATION_OFFSET_X, state.blockSquares[i][1] + Point::GAME_LOCATION_OFFSET_Y));
+			}
+
+			this->currentBlock = new GeneralBlock(blockLocations);
+			this->currentBlock->setRotatedAmount(state.blockRotatedAmount);
+		}
+		else if (state.blockType == JOKER_BLOCK) {
+			this->currentBlock = new Joker(p);
+		}
+		else {
+			this->currentBlock = new Bomb(p);
+		}
+	}
+
+	this->updateGhost();
+
+	return true;
+}
\ No newline at end of file
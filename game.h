@@ -0,0 +1,141 @@
+#ifndef __GAME_H
+#define __GAME_H
+
+#include <fstream>
+using namespace std;
+
+#include "block.h"
+#include "blocks_generator.h"
+#include "blocks_queue.h"
+#include "board.h"
+#include "game_state.h"
+#include "game_events.h"
+#include "trace.h"
+#include "allocation_tracker.h"
+
+/*
+The rules of the game - the board, the falling block, the upcoming blocks and the score.
+This class does not read keypresses or write to the console, so it can be run without a console (the Tetris class displays it).
+*/
+class Game {
+public:
+	//Definition of each action the user can make in the game.
+	enum eAction {NO_ACTION, MOVE_LEFT, MOVE_DOWN, MOVE_RIGHT, ROTATE_RIGHT, JOKER_PAUSE};
+
+	constexpr static int ROWS = Board::ROWS;
+	constexpr static int COLS = Board::COLS;
+
+	constexpr static int DEFAULT_SPEED = 350;
+
+	constexpr static int MOVE_TO_BOTTOM_SCORE_MULTIPLIER = 2;
+	constexpr static int JOKER_LINE_REMOVED_SCORE = 50;
+	constexpr static int BOMB_EXPLODE_SCORE_PENALTY = 50;
+	constexpr static int LINES_REMOVED_SCORE_1 = 100;
+	constexpr static int LINES_REMOVED_SCORE_2 = 300;
+	constexpr static int LINES_REMOVED_SCORE_3 = 500;
+	constexpr static int LINES_REMOVED_SCORE_4 = 800;
+
+	//Files constants.
+	constexpr static char NO_BLOCK = -1;
+	constexpr static char REGULAR_BLOCK = 0;
+	constexpr static char JOKER_BLOCK = 1;
+	constexpr static char BOMB_BLOCK = 2;
+
+private:
+	bool isFailed = false; //This property saves whether the blocks reached the end of the board.
+	int speed = DEFAULT_SPEED; //This property saves the game's speed in miliseconds.
+	Board board; //This property saves the locations of the used points inside the board.
+	Block *currentBlock = nullptr; //This property saves the current block that is falling down.
+	BlocksQueue nextBlocks; //This property saves the upcoming blocks of the game.
+	int ghostDistance = 0; //This property saves how many rows beneath the current block it is going to land.
+	int score = 0;
+	int blocksDropped = 0;
+	AllocationCounts lastTickAllocations = {0, 0, 0, 0}; //These properties are only updated when the game is built with TETRIS_TRACK_ALLOCATIONS.
+	AllocationCounts gameAllocations = {0, 0, 0, 0};
+	GameEventStream *events = nullptr; //This property saves the stream the game's events are written to (or nullptr if nothing follows the game's events).
+
+	static_assert(GameState::MAX_BLOCK_SQUARES >= BlocksGenerator::SHAPE_SIZE, "The state cannot hold all of the squares of a block.");
+	static_assert(GameState::MAX_BLOCK_SQUARES <= BlockSquares::MAX_SQUARES, "A block cannot hold all of the squares of the state.");
+	static_assert(BlocksQueue::CAPACITY < 32, "The state cannot hold the amount of blocks in the queue.");
+	static_assert(BlockRandomizer::RECENT_BLOCK_BITS * RandomizerConfig::MAX_HISTORY_SIZE <= GameState::RECENT_BLOCKS_BYTES * 8, "The state cannot hold the randomizer's history.");
+
+	Game(const Game& other) = delete; //Removing the copy constructor since it's not needed.
+
+	void step(eAction action);
+	void moveBlock(eAction action);
+	char getCurrentBlockType() const;
+	void addNewBlock();
+	void setUsedPoints();
+	void updateGhost();
+	void pauseJoker();
+	void lockBlock();
+
+	void increaseScore(int score);
+	void decreaseScore(int score);
+	void increaseNumOfBlocks();
+
+	/*
+	This function writes an event about the current block to the game's event stream, if the game has one.
+	It is defined here so the check is inlined, and a game without an event stream only pays for the check.
+	*/
+	void emitEvent(GameEvent::eType type, int amount = 0, int rowsMoved = 0, int colsMoved = 0) {
+		if (this->events != nullptr) {
+			this->writeEvent(type, amount, rowsMoved, colsMoved);
+		}
+	}
+
+	void writeEvent(GameEvent::eType type, int amount, int rowsMoved, int colsMoved);
+
+public:
+	Game() = default;
+	~Game();
+
+	void start(unsigned int seed);
+	void tick(eAction action);
+	void act(eAction action);
+
+	void addBlock(BlocksGenerator::eBlockType blockType);
+
+	bool canBlockMoveDown();
+	bool canBlockMoveRight();
+	bool canBlockMoveLeft();
+	bool canBlockRotateRight();
+	int getBlockDropDistance() const;
+
+	void moveBlockDown();
+	void moveBlockRight();
+	void moveBlockLeft();
+	void rotateBlockRight();
+	void moveBlockToBottom();
+
+	void checkAndExplode(eAction action = NO_ACTION);
+	void explode(Point p);
+
+	void buildFrame(char frame[ROWS][COLS]) const;
+
+	void setBoard(const Board& board);
+	void setScore(int score);
+	void setBlocksDropped(int blocksDropped);
+	void setSpeed(int speed);
+	void setEventStream(GameEventStream *events);
+
+	int getScore() const;
+	int getNumOfBlocks() const;
+	int getSpeed() const;
+	AllocationCounts getLastTickAllocations() const;
+	AllocationCounts getGameAllocations() const;
+	bool isGameOver() const;
+	const Board& getBoard() const;
+	Block * getCurrentBlock() const;
+	const BlocksQueue& getNextBlocks() const;
+	int getGhostDistance() const;
+	GameEventStream * getEventStream() const;
+
+	void saveToFile(ofstream& outFile) const;
+	void loadFromFile(ifstream& inFile, unsigned int seed);
+
+	void saveState(GameState& state) const;
+	bool loadState(const GameState& state);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "game_events.h"
+
+/*
+This function adds a subscriber to the stream and returns true, or returns false if the stream already has the maximum amount of subscribers.
+*/
+bool GameEventStream::subscribe(GameEventSubscriber *subscriber) {
+	if (this->subscribersAmount == MAX_SUBSCRIBERS) {
+		return false;
+	}
+
+	this->subscribers[this->subscribersAmount++] = subscriber;
+
+	return true;
+}
+
+/*
+This function removes a subscriber from the stream (the events that were not delivered yet are not delivered to it).
+*/
+void GameEventStream::unsubscribe(GameEventSubscriber *subscriber) {
+	for (int i = 0; i < this->subscribersAmount; i++) {
+		if (this->subscribers[i] == subscriber) {
+			//Moving the next subscribers back, so the others are still called in the order they subscribed.
+			for (int j = i + 1; j < this->subscribersAmount; j++) {
+				this->subscribers[j - 1] = this->subscribers[j];
+			}
+
+			this->subscribersAmount--;
+			return;
+		}
+	}
+}
+
+/*
+This function returns whether the stream has any subscribers.
+*/
+bool GameEventStream::hasSubscribers() const {
+	return this->subscribersAmount > 0;
+}
+
+/*
+This function delivers the events in the buffer to every subscriber and empties the buffer.
+*/
+void GameEventStream::flush() {
+	if (this->eventsAmount == 0) {
+		return;
+	}
+
+	for (int i = 0; i < this->subscribersAmount; i++) {
+		this->subscribers[i]->onEvents(this->events, this->eventsAmount);
+	}
+
+	this->eventsAmount = 0;
+}
+
+/*
+This function returns the amount of events written since the stream was created.
+*/
+long long GameEventStream::getEventsWritten() const {
+	return this->eventsWritten;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef __GAME_EVENTS_H
+#define __GAME_EVENTS_H
+
+/*
+A change the game's step made. The events of a game describe everything that happened in it,
+so renderers, statistics, replay recorders and network broadcasters can follow the game without looking into its state.
+The location is the board location (row, column) of the block's first square after the event.
+*/
+struct GameEvent {
+	enum eType {BLOCK_SPAWNED, BLOCK_MOVED, BLOCK_ROTATED, BLOCK_LOCKED, ROWS_CLEARED, BOMB_EXPLODED, JOKER_PAUSED, GAME_OVER};
+
+	constexpr static int TYPES_AMOUNT = GAME_OVER + 1;
+
+	unsigned char type;
+	signed char row;
+	signed char col;
+	signed char rowsMoved; //The amount of rows a moved block has moved down.
+	signed char colsMoved; //The amount of columns a moved block has moved (negative to the left).
+	short amount; //The type of a spawned block, the rotation of a rotated block, the amount of cleared rows or the amount of squares a bomb removed.
+	int score; //The game's score after the event.
+};
+
+/*
+An object that receives the events of a game.
+*/
+class GameEventSubscriber {
+public:
+	virtual ~GameEventSubscriber() = default;
+
+	//The events are received in batches (at the end of every step of the game, or whenever the stream's buffer is full), in the order they were made.
+	virtual void onEvents(const GameEvent *events, int amount) = 0;
+};
+
+/*
+The events of a game, kept in a preallocated buffer and delivered to the subscribers in batches.
+The game only writes events when a stream is attached to it, so a game without subscribers does not pay for them.
+Nothing is allocated while events are written or delivered, and the subscribers are called on the game's thread.
+*/
+class GameEventStream {
+public:
+	constexpr static int CAPACITY = 256;
+	constexpr static int MAX_SUBSCRIBERS = 8;
+
+private:
+	GameEvent events[CAPACITY];
+	int eventsAmount = 0;
+	GameEventSubscriber *subscribers[MAX_SUBSCRIBERS];
+	int subscribersAmount = 0;
+	long long eventsWritten = 0; //This property saves the amount of events written since the stream was created.
+
+	GameEventStream(const GameEventStream& other) = delete; //Removing the copy constructor since the subscribers should not be shared.
+
+public:
+	GameEventStream() = default;
+
+	bool subscribe(GameEventSubscriber *subscriber);
+	void unsubscribe(GameEventSubscriber *subscriber);
+	bool hasSubscribers() const;
+
+	/*
+	This function adds an event to the buffer, and delivers the buffer to the subscribers first if it is full.
+	*/
+	void push(const GameEvent& event) {
+		if (this->eventsAmount == CAPACITY) {
+			this->flush();
+		}
+
+		this->events[this->eventsAmount++] = event;
+		this->eventsWritten++;
+	}
+
+	void flush();
+
+	long long getEventsWritten() const;
+};
+
+#endif
\ No newline at end of file
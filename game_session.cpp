@@ -0,0 +1,174 @@
+#include "game_session.h"
+
+/*
+Constructor - receives the game the session runs. The first step is due right away.
+*/
+GameSession::GameSession(Game& game) : game(game), nextStepTime(chrono::steady_clock::now()) {
+}
+
+/*
+This function adds an action to the session and returns true, or returns false if there are already ACTIONS_CAPACITY actions waiting
+(only called by the producer of the actions).
+*/
+bool GameSession::pushAction(Game::eAction action) {
+	return this->actions.push(action);
+}
+
+/*
+This function handles the actions that arrived, in the order they arrived, until an action has to wait for the next step.
+While there is no current block (the step adds the next block), the actions wait for the step as well.
+*/
+void GameSession::applyActions() {
+	Game::eAction action;
+
+	while (this->stepAction == Game::NO_ACTION && this->game.getCurrentBlock() != nullptr && !this->game.isGameOver() && this->actions.pop(action)) {
+		if (action == Game::MOVE_DOWN || action == Game::JOKER_PAUSE) {
+			this->stepAction = action;
+		}
+		else {
+			this->game.act(action); //A bomb may explode here, and then the next actions wait for the next block.
+
+			if (this->recording != nullptr) {
+				this->recording->addAction(action);
+			}
+		}
+	}
+}
+
+/*
+This function removes all of the actions that were not handled yet (for example, when another state of the game is loaded).
+*/
+void GameSession::cancelActions() {
+	Game::eAction action;
+
+	while (this->actions.pop(action)) {
+	}
+
+	this->stepAction = Game::NO_ACTION;
+}
+
+/*
+This function sets the time of the next step to one step (the game's speed) after the given time (called when the game starts or continues).
+*/
+void GameSession::schedule(chrono::steady_clock::time_point now) {
+	this->nextStepTime = this->isTurbo ? now : now + chrono::milliseconds(this->game.getSpeed());
+}
+
+/*
+This function handles the actions that arrived and runs the game's steps whose time has come, and returns the amount of steps that were run.
+In turbo mode a single step is run each time.
+*/
+int GameSession::resume(chrono::steady_clock::time_point now) {
+	int stepsAmount = 0;
+
+	this->applyActions();
+
+	while (!this->game.isGameOver() && stepsAmount < (this->isTurbo ? 1 : MAX_CATCH_UP_STEPS) && (this->isTurbo || now >= this->nextStepTime)) {
+		if (this->recording != nullptr) {
+			this->recording->addStep(this->stepAction);
+		}
+
+		this->game.tick(this->stepAction);
+		this->stepAction = Game::NO_ACTION;
+		stepsAmount++;
+
+		if (this->game.isGameOver()) {
+			this->gamesFinished++;
+
+			if (this->recording != nullptr) {
+				this->recording->finish(this->game);
+				this->recording = nullptr; //Only one game is recorded to a replay.
+			}
+
+			if (this->isRestarting) {
+				this->cancelActions(); //The actions were meant for the game that is over.
+				this->game.start(this->restartSeeds.next()); //The game's speed is kept.
+			}
+		}
+
+		if (this->isTurbo) {
+			this->nextStepTime = now;
+		}
+		else {
+			this->nextStepTime += chrono::milliseconds(this->game.getSpeed()); //The next step is due one step after this step was due.
+		}
+
+		this->applyActions(); //The actions that waited for the step (or for the new block) are handled right after it.
+	}
+
+	if (!this->isTurbo && now >= this->nextStepTime) { //The session is too far behind the clock, so the steps it missed are skipped.
+		this->schedule(now);
+	}
+
+	return stepsAmount;
+}
+
+/*
+This function turns the turbo mode on or off. When it is turned off, the next step is due one step after the given time.
+*/
+void GameSession::setTurbo(bool isTurbo, chrono::steady_clock::time_point now) {
+	this->isTurbo = isTurbo;
+	this->schedule(now);
+}
+
+/*
+This function returns whether the session is in turbo mode.
+*/
+bool GameSession::getTurbo() const {
+	return this->isTurbo;
+}
+
+/*
+This function returns the time the next step is due.
+*/
+chrono::steady_clock::time_point GameSession::getNextStepTime() const {
+	return this->nextStepTime;
+}
+
+/*
+This function sets whether a new game is started when the game is over, and the seed of the stream of the seeds of these games.
+*/
+void GameSession::setRestarting(bool isRestarting, unsigned int seed) {
+	this->isRestarting = isRestarting;
+	this->restartSeeds.reset(seed);
+}
+
+/*
+This function returns the amount of the session's games that were over.
+*/
+int GameSession::getGamesFinished() const {
+	return this->gamesFinished;
+}
+
+/*
+This function starts recording the session's game to the given replay (or stops recording it, if it is nullptr).
+The game has to be one that was just started, and the replay is finished when the game is over.
+*/
+void GameSession::setRecording(Replay *recording) {
+	this->recording = recording;
+
+	if (recording != nullptr) {
+		recording->start(this->game);
+	}
+}
+
+/*
+This function returns the replay the game is recorded to (or nullptr if it is not recorded, or its recording was finished).
+*/
+Replay * GameSession::getRecording() const {
+	return this->recording;
+}
+
+/*
+This function returns whether the session's game is over.
+*/
+bool GameSession::isFinished() const {
+	return this->game.isGameOver();
+}
+
+/*
+This function returns the session's game.
+*/
+Game& GameSession::getGame() const {
+	return this->game;
+}
\ No newline at end of file
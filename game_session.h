@@ -0,0 +1,69 @@
+#ifndef __GAME_SESSION_H
+#define __GAME_SESSION_H
+
+#include <chrono>
+using namespace std;
+
+#include "game.h"
+#include "spsc_queue.h"
+#include "random_stream.h"
+#include "replay.h"
+
+/*
+Runs a game as a resumable state machine instead of a loop that owns its thread.
+Each call to resume handles the actions that arrived since the previous call and runs the game's step if its time has come, then returns,
+so the caller decides how to wait until the next action or until getNextStepTime (a single thread can run many sessions this way,
+and nothing is kept on the stack between the calls).
+
+The actions are pushed by a single producer (the thread that reads the player's input) and handled by whoever resumes the session.
+Moves are made as soon as the session is resumed after they arrive, and dropping the block or pausing the joker waits for the next step
+(the moves after them wait for the step as well), like one step of the game with that action.
+
+The steps are due at fixed times: each step is due one period (the game's speed) after the time the previous step was due, and not after the time
+it was run, so the time it takes to run a step or to wake up does not add up. A session that was resumed late runs the steps it missed
+(up to MAX_CATCH_UP_STEPS, after that the missed steps are skipped). In turbo mode the steps are not bound to the clock at all:
+a step is always due, so the game runs as fast as it is resumed.
+
+A session can restart its game whenever it is over (with the next seed of its own seed stream), so it runs forever, for kiosks and soak tests.
+A session can also record its game's actions and steps to a Replay, until the game is over.
+*/
+class GameSession {
+public:
+	constexpr static int ACTIONS_CAPACITY = 64;
+	constexpr static int MAX_CATCH_UP_STEPS = 5; //The most steps a single resume runs to catch up with the clock.
+
+private:
+	Game& game;
+	SpscQueue<Game::eAction, ACTIONS_CAPACITY> actions; //This property saves the actions that were pushed and were not handled yet.
+	Game::eAction stepAction = Game::NO_ACTION; //This property saves the action that is handled by the next step.
+	chrono::steady_clock::time_point nextStepTime;
+	bool isTurbo = false;
+	bool isRestarting = false; //This property saves whether a new game is started when the game is over.
+	RandomStream restartSeeds; //This property saves the seeds of the games that are started when the game is over.
+	int gamesFinished = 0;
+	Replay *recording = nullptr; //This property saves the replay the game is recorded to (or nullptr if the game is not recorded).
+
+public:
+	GameSession(Game& game);
+	GameSession(const GameSession& other) = delete;
+
+	bool pushAction(Game::eAction action);
+	void applyActions();
+	void cancelActions();
+
+	void schedule(chrono::steady_clock::time_point now);
+	int resume(chrono::steady_clock::time_point now);
+
+	void setTurbo(bool isTurbo, chrono::steady_clock::time_point now);
+	bool getTurbo() const;
+	void setRestarting(bool isRestarting, unsigned int seed);
+	int getGamesFinished() const;
+	void setRecording(Replay *recording);
+	Replay *getRecording() const;
+
+	chrono::steady_clock::time_point getNextStepTime() const;
+	bool isFinished() const;
+	Game& getGame() const;
+};
+
+#endif
\ No newline at end of file
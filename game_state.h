@@ -0,0 +1,36 @@
+#ifndef __GAME_STATE_H
+#define __GAME_STATE_H
+
+#include <type_traits>
+#include "board.h"
+
+/*
+A flat snapshot of a game, used for undo and for searches that try many moves from the same position.
+It holds no pointers, so it is copied with a plain memory copy (see Game::saveState and Game::loadState).
+The game's speed and the settings of the randomizer are not part of the position, so they are not saved
+(a state only identifies the randomizer's settings, so it is not loaded into a game that picks its blocks differently).
+*/
+struct GameState {
+	constexpr static int MAX_BLOCK_SQUARES = 4;
+	constexpr static int RANDOMIZER_ID_BITS = 10;
+	constexpr static unsigned int RANDOMIZER_ID_MASK = (1u << RANDOMIZER_ID_BITS) - 1;
+	constexpr static int RECENT_BLOCKS_BYTES = 6;
+
+	unsigned short rowMasks[Board::ROWS]; //The board's used squares, as returned by Board::getRowMask.
+	char blockType; //The kind of the current block (Game::NO_BLOCK, REGULAR_BLOCK, JOKER_BLOCK or BOMB_BLOCK).
+	unsigned char blockRotatedAmount;
+	signed char blockSquares[MAX_BLOCK_SQUARES][2]; //The column and row of each square of the current block in the board (a joker and a bomb use only the first one).
+	int score;
+	int blocksDropped;
+	unsigned int seed; //The seed the blocks are generated from.
+	unsigned int blocksGenerated; //How many blocks were generated from the seed so far.
+	unsigned short nextBlocksAmount : 5; //How many generated blocks are still waiting in the queue.
+	unsigned short isFailed : 1;
+	unsigned short randomizerId : RANDOMIZER_ID_BITS; //The low bits of the fingerprint of the randomizer's settings (see RandomizerConfig::getFingerprint).
+	unsigned char recentBlocks[RECENT_BLOCKS_BYTES]; //The last blocks taken from the queue, as returned by BlocksQueue::getRecentBlocks (the randomizer's history).
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must be copyable with a memory copy.");
+static_assert(sizeof(GameState) <= 64, "GameState should fit in a cache line.");
+
+#endif
\ No newline at end of file
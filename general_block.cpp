@@ -1,6 +1,9 @@
 #include "general_block.h"
 
-GeneralBlock::GeneralBlock(vector<Point *>& blockLocations, char ch) {
+/*
+Constructor - takes the points of the given squares (the block deletes them).
+*/
+GeneralBlock::GeneralBlock(const BlockSquares& blockLocations, char ch) {
 	this->blockLocations = blockLocations;
 	this->ch = ch;
 
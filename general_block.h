@@ -5,7 +5,7 @@
 
 class GeneralBlock : public Block {
 public:
-	GeneralBlock(vector<Point *>& blockLocations, char ch = Block::NORMAL_SQUARE_CHAR);
+	GeneralBlock(const BlockSquares& blockLocations, char ch = Block::NORMAL_SQUARE_CHAR);
 };
 
 #endif
\ No newline at end of file
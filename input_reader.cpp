@@ -0,0 +1,144 @@
+#include "input_reader.h"
+
+/*
+Constructor - the keypresses are not read until the input thread is started.
+*/
+InputReader::InputReader() : isReading(false) {
+}
+
+/*
+Destructor - stops the input thread.
+*/
+InputReader::~InputReader() {
+	this->stop();
+}
+
+/*
+This function starts the input thread.
+*/
+void InputReader::start() {
+	if (this->inputThread.joinable()) {
+		return;
+	}
+
+	this->isReading = true;
+	this->inputThread = thread(&InputReader::readLoop, this);
+}
+
+/*
+This function stops the input thread (it stops within STOP_CHECK_DELAY miliseconds). Keypresses that were already read stay in the queue.
+*/
+void InputReader::stop() {
+	if (!this->inputThread.joinable()) {
+		return;
+	}
+
+	this->isReading = false;
+	this->inputThread.join();
+}
+
+/*
+This function runs on the input thread: it waits for input in the console and pushes every keypress to the queue, until the thread is stopped.
+The console's input holds other events as well (key releases, mouse, focus and resize events), so every event is read and only the keypresses are kept -
+an event that is left in the input would keep the input handle signaled.
+*/
+void InputReader::readLoop() {
+	HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+	INPUT_RECORD records[RECORDS_BATCH];
+
+	while (this->isReading) {
+		if (WaitForSingleObject(input, STOP_CHECK_DELAY) != WAIT_OBJECT_0) { //No input has arrived.
+			continue;
+		}
+
+		DWORD recordsAmount = 0;
+
+		if (!ReadConsoleInputA(input, records, RECORDS_BATCH, &recordsAmount)) {
+			continue;
+		}
+
+		for (DWORD i = 0; i < recordsAmount && this->isReading; i++) {
+			const KEY_EVENT_RECORD& keyEvent = records[i].Event.KeyEvent;
+
+			//Keys without a character (such as the arrows and shift) are skipped, since all of the game's keys are characters.
+			if (records[i].EventType != KEY_EVENT || !keyEvent.bKeyDown || keyEvent.uChar.AsciiChar == 0) {
+				continue;
+			}
+
+			KeyEvent event = {keyEvent.uChar.AsciiChar, chrono::steady_clock::now()};
+
+			for (int j = 0; j < keyEvent.wRepeatCount; j++) { //A key that is held down may arrive as a single event that is repeated.
+				this->pushKey(event);
+			}
+		}
+	}
+}
+
+/*
+This function pushes a keypress to the queue (waiting while the queue is full) and wakes up the game's thread if it waits for a keypress.
+*/
+void InputReader::pushKey(const KeyEvent& event) {
+	while (!this->keys.push(event)) {
+		if (!this->isReading) {
+			return;
+		}
+
+		Sleep(FULL_QUEUE_DELAY);
+	}
+
+	//Locking the mutex so the notification cannot be sent between the game's thread checking the queue and starting to wait.
+	lock_guard<mutex> lock(this->waitMutex);
+	this->keyPushed.notify_one();
+}
+
+/*
+This function copies the first keypress in the queue without removing it, or returns false if there is no keypress.
+*/
+bool InputReader::peekKey(KeyEvent& event) const {
+	return this->keys.peek(event);
+}
+
+/*
+This function removes the first keypress from the queue and copies it, or returns false if there is no keypress.
+*/
+bool InputReader::getKey(KeyEvent& event) {
+	return this->keys.pop(event);
+}
+
+/*
+This function waits until there is a keypress in the queue, then removes it and copies it.
+*/
+void InputReader::waitForKey(KeyEvent& event) {
+	if (this->keys.pop(event)) {
+		return;
+	}
+
+	unique_lock<mutex> lock(this->waitMutex);
+
+	while (this->keys.isEmpty()) {
+		this->keyPushed.wait(lock);
+	}
+
+	lock.unlock();
+
+	this->keys.pop(event);
+}
+
+/*
+This function waits until there is a keypress in the queue or until the given time, and returns whether there is a keypress (it is not removed).
+*/
+bool InputReader::waitForKeyUntil(chrono::steady_clock::time_point time) {
+	if (!this->keys.isEmpty()) {
+		return true;
+	}
+
+	unique_lock<mutex> lock(this->waitMutex);
+
+	while (this->keys.isEmpty()) {
+		if (this->keyPushed.wait_until(lock, time) == cv_status::timeout) {
+			return !this->keys.isEmpty();
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef __INPUT_READER_H
+#define __INPUT_READER_H
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <Windows.h>
+#include <conio.h>
+using namespace std;
+
+#include "spsc_queue.h"
+
+/*
+A keypress, with the time it was read from the console.
+*/
+struct KeyEvent {
+	char key;
+	chrono::steady_clock::time_point time;
+};
+
+/*
+Reads the keypresses from the console on a thread of its own and passes them to the game's thread in the order they were pressed.
+The input thread waits on the console's input handle, so it runs only when there is input (or when it checks whether it should stop),
+and the game's thread takes the keypresses from a wait-free queue, so reading a keypress never waits for the input thread.
+No keypress is dropped: when the queue is full, the input thread waits until the game's thread takes keypresses from it.
+*/
+class InputReader {
+public:
+	constexpr static int QUEUE_CAPACITY = 256;
+	constexpr static int STOP_CHECK_DELAY = 100; //The longest time the input thread waits for input before it checks whether it should stop (in miliseconds).
+	constexpr static int FULL_QUEUE_DELAY = 1; //The time the input thread waits when the queue is full (in miliseconds).
+	constexpr static int RECORDS_BATCH = 32; //The most console events the input thread reads at once.
+
+private:
+	SpscQueue<KeyEvent, QUEUE_CAPACITY> keys;
+	thread inputThread;
+	atomic<bool> isReading; //This property saves whether the input thread should keep reading keypresses.
+
+	//These properties are only used to wake up the game's thread when it waits for a keypress.
+	mutex waitMutex;
+	condition_variable keyPushed;
+
+	void readLoop();
+	void pushKey(const KeyEvent& event);
+
+public:
+	InputReader();
+	InputReader(const InputReader& other) = delete;
+	~InputReader();
+
+	void start();
+	void stop();
+
+	bool peekKey(KeyEvent& event) const;
+	bool getKey(KeyEvent& event);
+	void waitForKey(KeyEvent& event);
+	bool waitForKeyUntil(chrono::steady_clock::time_point time);
+};
+
+#endif
\ No newline at end of file
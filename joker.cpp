@@ -6,8 +6,7 @@ Constructor - receives the initial location of where the block should be created
 Joker::Joker(const Point& location, char ch) {
 	this->ch = ch;
 	this->rotateable = false;
-	this->blockLocations.reserve(JOKER_SIZE);
 
 	//Setting the joker's locations according to the initial location of the joker.
-	this->blockLocations.push_back(new Point(location));
+	this->blockLocations.add(new Point(location));
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "memory_pool.h"
+#include "allocation_tracker.h"
+#include <new>
+
+/*
+Constructor - receives the size of the chunks (it is rounded up so every chunk is aligned like any object).
+The pool allocates for the thread that creates it.
+*/
+MemoryPool::MemoryPool(size_t chunkSize) {
+	if (chunkSize < sizeof(FreeChunk)) {
+		chunkSize = sizeof(FreeChunk);
+	}
+
+	this->memory = new PoolMemory();
+	this->memory->chunkSize = (chunkSize + HEADER_SIZE - 1) / HEADER_SIZE * HEADER_SIZE;
+	this->memory->ownerThread = this_thread::get_id();
+	this->memory->returnedChunks.store(nullptr);
+	this->memory->references.store(1);
+}
+
+/*
+Destructor - returns the slabs to the heap, unless some chunks are still used (for example, a block that is freed after its thread has ended),
+in which case the slabs are returned when the last of these chunks is freed.
+*/
+MemoryPool::~MemoryPool() {
+	release(this->memory);
+}
+
+/*
+This function drops a reference to the memory of a pool, and returns the memory to the heap if it was the last one.
+*/
+void MemoryPool::release(PoolMemory *memory) {
+	if (memory->references.fetch_sub(1, memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	vector<char *>::iterator itr = memory->slabs.begin();
+	vector<char *>::iterator itrEnd = memory->slabs.end();
+
+	for (; itr != itrEnd; ++itr) {
+		::operator delete(*itr);
+	}
+
+	delete memory;
+}
+
+/*
+This function takes a new slab from the heap and adds all of its chunks (each with its header) to the list of free chunks.
+*/
+void MemoryPool::addSlab() {
+	size_t stride = HEADER_SIZE + this->memory->chunkSize;
+	char *slab = (char *)::operator new(stride * CHUNKS_PER_SLAB);
+
+	this->memory->slabs.push_back(slab);
+
+	for (int i = CHUNKS_PER_SLAB - 1; i >= 0; i--) {
+		FreeChunk *chunk = (FreeChunk *)(slab + i * stride);
+
+		chunk->next = this->memory->freeChunks;
+		this->memory->freeChunks = chunk;
+	}
+}
+
+/*
+This function returns memory for an object of the given size.
+Objects that are bigger than a chunk are allocated on the heap (with a header too, so deallocate can tell them apart).
+It should be called only by the thread that created the pool.
+*/
+void * MemoryPool::allocate(size_t size) {
+	PoolMemory *memory = this->memory;
+
+	if (size > memory->chunkSize) {
+		ChunkHeader *header = (ChunkHeader *)::operator new(HEADER_SIZE + size);
+
+		header->memory = nullptr;
+		return (char *)header + HEADER_SIZE;
+	}
+
+	if (memory->freeChunks == nullptr) { //Taking back the chunks that were freed by other threads before asking the heap for more.
+		memory->freeChunks = memory->returnedChunks.exchange(nullptr, memory_order_acquire);
+	}
+
+	if (memory->freeChunks == nullptr) {
+		this->addSlab();
+	}
+
+	FreeChunk *chunk = memory->freeChunks;
+	ChunkHeader *header = (ChunkHeader *)chunk;
+
+	memory->freeChunks = chunk->next;
+	memory->references.fetch_add(1, memory_order_relaxed);
+	memory->chunksAllocated++;
+	header->memory = memory;
+	AllocationTracker::recordPoolAllocation(size);
+
+	return (char *)header + HEADER_SIZE;
+}
+
+/*
+This function receives memory that was returned by allocate (of any pool, on any thread), and frees it.
+A chunk that is freed by the thread of its pool goes back to the pool's list, and a chunk that is freed by another thread is pushed to the pool's returned chunks.
+*/
+void MemoryPool::deallocate(void *p) {
+	if (p == nullptr) {
+		return;
+	}
+
+	ChunkHeader *header = (ChunkHeader *)((char *)p - HEADER_SIZE);
+	PoolMemory *memory = header->memory;
+
+	if (memory == nullptr) {
+		::operator delete(header);
+		return;
+	}
+
+	FreeChunk *chunk = (FreeChunk *)header;
+
+	if (memory->ownerThread == this_thread::get_id()) {
+		chunk->next = memory->freeChunks;
+		memory->freeChunks = chunk;
+	}
+	else {
+		chunk->next = memory->returnedChunks.load(memory_order_relaxed);
+
+		while (!memory->returnedChunks.compare_exchange_weak(chunk->next, chunk, memory_order_release, memory_order_relaxed)) {
+		}
+	}
+
+	release(memory);
+}
+
+/*
+This function returns the size of each chunk in the pool.
+*/
+size_t MemoryPool::getChunkSize() const {
+	return this->memory->chunkSize;
+}
+
+/*
+This function returns how many chunks of the pool are currently used (on any thread).
+*/
+int MemoryPool::getChunksInUse() const {
+	return this->memory->references.load(memory_order_relaxed) - 1;
+}
+
+/*
+This function returns how many slabs were taken from the heap.
+*/
+int MemoryPool::getSlabsAmount() const {
+	return (int)this->memory->slabs.size();
+}
+
+/*
+This function returns how many chunks were handed out since the pool was created.
+*/
+long long MemoryPool::getChunksAllocated() const {
+	return this->memory->chunksAllocated;
+}
\ No newline at end of file
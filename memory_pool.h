@@ -0,0 +1,67 @@
+#ifndef __MEMORY_POOL_H
+#define __MEMORY_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <thread>
+using namespace std;
+
+/*
+A pool of fixed size chunks of memory, used for the objects that are allocated and freed all the time during a game (the blocks and their points).
+The memory is taken from the heap in slabs of many chunks, and freed chunks are kept in a list and reused, so the heap is not fragmented by these objects.
+
+A pool allocates for a single thread (each thread uses its own pools), but a chunk may be freed by any thread: every chunk has a header with the memory
+of the pool it belongs to, and a chunk freed by another thread is passed back to that pool (and reused once the pool's own free chunks run out).
+The memory of a pool is counted by its chunks that are in use, so it outlives the pool (and its thread) until the last of them is freed.
+*/
+class MemoryPool {
+public:
+	constexpr static int CHUNKS_PER_SLAB = 64;
+	constexpr static size_t HEADER_SIZE = alignof(max_align_t); //The header keeps the chunks aligned like any object.
+
+private:
+	struct FreeChunk {
+		FreeChunk *next;
+	};
+
+	//The memory of a pool, which is shared by the pool and by its chunks that are in use.
+	struct PoolMemory {
+		size_t chunkSize;
+		thread::id ownerThread; //This property saves the thread that allocates from the pool.
+		FreeChunk *freeChunks = nullptr; //This property saves the list of the chunks that were freed by the owner thread.
+		atomic<FreeChunk *> returnedChunks; //This property saves the list of the chunks that were freed by other threads.
+		atomic<int> references; //One for each chunk in use, and one for the pool itself (the memory is returned to the heap when none is left).
+		vector<char *> slabs;
+		long long chunksAllocated = 0;
+	};
+
+	//The header before each chunk (the memory is null for an object that was too big for a chunk and was allocated on the heap).
+	struct ChunkHeader {
+		PoolMemory *memory;
+	};
+
+	static_assert(sizeof(ChunkHeader) <= HEADER_SIZE, "The header of a chunk must fit before the chunk.");
+
+	PoolMemory *memory;
+
+	void addSlab();
+
+	static void release(PoolMemory *memory);
+
+public:
+	MemoryPool(size_t chunkSize);
+	MemoryPool(const MemoryPool&) = delete;
+	MemoryPool& operator=(const MemoryPool&) = delete;
+	~MemoryPool();
+
+	void * allocate(size_t size);
+	static void deallocate(void *p);
+
+	size_t getChunkSize() const;
+	int getChunksInUse() const;
+	int getSlabsAmount() const;
+	long long getChunksAllocated() const;
+};
+
+#endif
\ No newline at end of file
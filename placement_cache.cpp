@@ -0,0 +1,513 @@
+#include "placement_cache.h"
+
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+constexpr unsigned long long ZOBRIST_SEED = 0x7E7215ull; //The keys must be the same in every process and every run, so they are made from a fixed seed.
+constexpr unsigned int MAX_LOAD_NUMERATOR = 3; //An entry is only added while the table is less than 3/4 full.
+constexpr unsigned int MAX_LOAD_DENOMINATOR = 4;
+
+/*
+This function returns the next number of a SplitMix64 sequence, which mixes the bits of the given state well.
+*/
+static unsigned long long mixBits(unsigned long long value) {
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+	return value ^ (value >> 31);
+}
+
+/*
+The Zobrist keys of the squares of the board.
+*/
+struct ZobristKeys {
+	unsigned long long squares[Board::ROWS][Board::COLS];
+
+	ZobristKeys() {
+		unsigned long long state = ZOBRIST_SEED;
+
+		for (int i = 0; i < Board::ROWS; i++) {
+			for (int j = 0; j < Board::COLS; j++) {
+				state = mixBits(state);
+				this->squares[i][j] = state;
+			}
+		}
+	}
+};
+
+/*
+This function returns the Zobrist keys (they are made the first time they are needed).
+*/
+static const ZobristKeys& getZobristKeys() {
+	static const ZobristKeys keys;
+
+	return keys;
+}
+
+/*
+Destructor - unmaps the file.
+*/
+PlacementCache::~PlacementCache() {
+	this->close();
+}
+
+/*
+This function opens the cache for looking up and adding placements of the given version of the evaluation, and returns whether it was opened.
+The file is created with 2^capacityBits entries if it does not exist (or it is not a cache of this layout). If it holds the entries of another version,
+a new generation is started, so all of its entries are free.
+*/
+bool PlacementCache::create(const string& fileName, unsigned int evaluationVersion, int capacityBits) {
+	this->close();
+
+	if (capacityBits < 1 || capacityBits > MAX_CAPACITY_BITS || evaluationVersion == 0) {
+		return false;
+	}
+
+	this->fileName = fileName;
+	this->evaluationVersion = evaluationVersion;
+
+	if (!this->map(true, 0) || !this->isValid()) { //The file is new, or it is not a cache of this layout.
+		unsigned int capacity = 1u << capacityBits;
+
+		this->close();
+
+		if (!this->map(true, sizeof(Header) + (size_t)capacity * sizeof(Entry))) {
+			return false;
+		}
+
+		Header *header = new (this->getHeader()) Header();
+
+		header->magic = 0;
+		header->version = VERSION;
+		header->capacity = capacity;
+		header->entrySize = (unsigned int)sizeof(Entry);
+		header->evaluationVersion.store(evaluationVersion, memory_order_relaxed);
+		header->generation.store(1, memory_order_relaxed);
+		header->entriesAmount.store(0, memory_order_relaxed);
+
+		for (unsigned int i = 0; i < capacity; i++) {
+			new (this->getEntry(i)) Entry();
+			this->getEntry(i)->tag.store(0, memory_order_relaxed);
+		}
+
+		atomic_thread_fence(memory_order_release);
+		header->magic = MAGIC; //The magic is written last, so a reader does not use a cache that is being made.
+	}
+
+	Header *header = this->getHeader();
+
+	if (header->evaluationVersion.load(memory_order_relaxed) != evaluationVersion) {
+		unsigned int generation = header->generation.load(memory_order_relaxed) + 1;
+
+		header->generation.store((generation == 0) ? 1 : generation, memory_order_relaxed);
+		header->entriesAmount.store(0, memory_order_relaxed);
+		header->evaluationVersion.store(evaluationVersion, memory_order_release);
+	}
+
+	return true;
+}
+
+/*
+This function opens an existing cache for looking up the placements of the given version of the evaluation (nothing is found while the cache holds
+the entries of another version), and returns false if there is no such file or it is not a cache of this layout.
+*/
+bool PlacementCache::open(const string& fileName, unsigned int evaluationVersion) {
+	this->close();
+	this->fileName = fileName;
+	this->evaluationVersion = evaluationVersion;
+
+	if (!this->map(false, 0) || !this->isValid()) {
+		this->close();
+		return false;
+	}
+
+	return true;
+}
+
+/*
+This function maps the file into memory: for writing (it is created if it does not exist) or for reading only.
+If a size is given the file is made that size, and otherwise the whole file is mapped.
+*/
+bool PlacementCache::map(bool isWritable, size_t size) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(this->fileName.c_str(), isWritable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+		isWritable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER fileSize;
+
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	if (size != 0) {
+		fileSize.QuadPart = (LONGLONG)size;
+
+		if (!SetFilePointerEx(file, fileSize, NULL, FILE_BEGIN) || !SetEndOfFile(file)) {
+			CloseHandle(file);
+			return false;
+		}
+	}
+	else if (GetFileSizeEx(file, &fileSize)) {
+		size = (size_t)fileSize.QuadPart;
+	}
+
+	HANDLE mapping = (size > 0) ? CreateFileMappingA(file, NULL, isWritable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL) : NULL;
+
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return false;
+	}
+
+	this->memory = MapViewOfFile(mapping, isWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+
+	if (this->memory == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	this->fileHandle = file;
+	this->mappingHandle = mapping;
+#else
+	int descriptor = ::open(this->fileName.c_str(), isWritable ? (O_CREAT | O_RDWR) : O_RDONLY, 0644);
+	struct stat information;
+
+	if (descriptor < 0) {
+		return false;
+	}
+
+	if (size != 0) {
+		if (ftruncate(descriptor, (off_t)size) != 0) {
+			::close(descriptor);
+			return false;
+		}
+	}
+	else if (fstat(descriptor, &information) == 0) {
+		size = (size_t)information.st_size;
+	}
+
+	this->memory = (size > 0) ? mmap(NULL, size, isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, descriptor, 0) : MAP_FAILED;
+	::close(descriptor); //The mapping stays after the descriptor is closed.
+
+	if (this->memory == MAP_FAILED) {
+		this->memory = nullptr;
+		return false;
+	}
+#endif
+
+	this->size = size;
+	this->isWritable = isWritable;
+
+	return true;
+}
+
+/*
+This function returns whether the mapped file is a cache of this layout.
+*/
+bool PlacementCache::isValid() const {
+	if (this->size < sizeof(Header)) {
+		return false;
+	}
+
+	Header *header = this->getHeader();
+
+	return header->magic == MAGIC && header->version == VERSION && header->entrySize == sizeof(Entry) && header->capacity != 0
+		&& (header->capacity & (header->capacity - 1)) == 0 && header->capacity <= (1u << MAX_CAPACITY_BITS)
+		&& this->size >= sizeof(Header) + (size_t)header->capacity * sizeof(Entry);
+}
+
+/*
+This function unmaps the file (the entries that were added are written to it by the system).
+*/
+void PlacementCache::close() {
+	if (this->memory == nullptr) {
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(this->memory);
+	CloseHandle((HANDLE)this->mappingHandle);
+	CloseHandle((HANDLE)this->fileHandle);
+	this->mappingHandle = nullptr;
+	this->fileHandle = nullptr;
+#else
+	munmap(this->memory, this->size);
+#endif
+
+	this->memory = nullptr;
+	this->size = 0;
+	this->isWritable = false;
+}
+
+/*
+This function returns whether a cache is mapped.
+*/
+bool PlacementCache::isOpen() const {
+	return this->memory != nullptr;
+}
+
+/*
+This function returns whether the entries of the cache were made with the evaluation this process uses.
+*/
+bool PlacementCache::isCurrent() const {
+	return this->memory != nullptr && this->getHeader()->evaluationVersion.load(memory_order_acquire) == this->evaluationVersion;
+}
+
+/*
+This function looks up the placement of the given key and returns whether it was found.
+*/
+bool PlacementCache::find(unsigned long long key, CachedPlacement& placement) {
+	this->lookups++;
+
+	if (this->memory == nullptr) {
+		return false;
+	}
+
+	Header *header = this->getHeader();
+
+	if (header->evaluationVersion.load(memory_order_acquire) != this->evaluationVersion) {
+		return false;
+	}
+
+	unsigned int generation = header->generation.load(memory_order_acquire);
+	unsigned int capacity = header->capacity;
+	unsigned int index = (unsigned int)key & (capacity - 1);
+
+	for (unsigned int probe = 0; probe < capacity; probe++, index = (index + 1) & (capacity - 1)) {
+		Entry *entry = this->getEntry(index);
+
+		this->probes++;
+
+		if (entry->tag.load(memory_order_acquire) != generation) { //A free entry ends the search.
+			return false;
+		}
+
+		if (entry->key[0].load(memory_order_relaxed) != (unsigned int)key || entry->key[1].load(memory_order_relaxed) != (unsigned int)(key >> 32)) {
+			continue;
+		}
+
+		unsigned int evaluation = entry->evaluation.load(memory_order_relaxed);
+		unsigned int actionsAmount = entry->actionsAmount.load(memory_order_relaxed);
+		unsigned int words[ACTION_WORDS];
+
+		for (int i = 0; i < ACTION_WORDS; i++) {
+			words[i] = entry->actions[i].load(memory_order_relaxed);
+		}
+
+		atomic_thread_fence(memory_order_acquire);
+
+		//The entry was rewritten by a new generation while it was read (the writer clears the tag before it writes the rest of the entry),
+		//or the generation that was loaded is already the one of the next version of the evaluation.
+		if (entry->tag.load(memory_order_relaxed) != generation || header->evaluationVersion.load(memory_order_relaxed) != this->evaluationVersion
+			|| actionsAmount > CachedPlacement::MAX_ACTIONS) {
+			return false;
+		}
+
+		memcpy(&placement.evaluation, &evaluation, sizeof(float));
+		placement.actionsAmount = (int)actionsAmount;
+
+		for (int i = 0; i < placement.actionsAmount; i++) {
+			int bit = i * ACTION_BITS;
+			unsigned long long pair = words[bit / 32] | ((bit / 32 + 1 < ACTION_WORDS) ? (unsigned long long)words[bit / 32 + 1] << 32 : 0);
+
+			placement.actions[i] = (unsigned char)((pair >> (bit % 32)) & ((1u << ACTION_BITS) - 1));
+		}
+
+		this->hits++;
+
+		return true;
+	}
+
+	return false;
+}
+
+/*
+This function adds the placement of the given key, and returns false if it was not added: the cache was opened for reading only,
+the key is already in the cache, the table is full or the placement takes too many actions.
+*/
+bool PlacementCache::insert(unsigned long long key, const CachedPlacement& placement) {
+	if (this->memory == nullptr || !this->isWritable) {
+		return false;
+	}
+
+	Header *header = this->getHeader();
+	unsigned int capacity = header->capacity;
+	unsigned int generation = header->generation.load(memory_order_relaxed);
+	unsigned int entriesAmount = header->entriesAmount.load(memory_order_relaxed);
+
+	if (placement.actionsAmount < 0 || placement.actionsAmount > CachedPlacement::MAX_ACTIONS
+		|| entriesAmount >= capacity / MAX_LOAD_DENOMINATOR * MAX_LOAD_NUMERATOR) {
+		this->failedInserts++;
+		return false;
+	}
+
+	unsigned int index = (unsigned int)key & (capacity - 1);
+
+	for (unsigned int probe = 0; probe < capacity; probe++, index = (index + 1) & (capacity - 1)) {
+		Entry *entry = this->getEntry(index);
+
+		if (entry->tag.load(memory_order_relaxed) == generation) {
+			if (entry->key[0].load(memory_order_relaxed) == (unsigned int)key && entry->key[1].load(memory_order_relaxed) == (unsigned int)(key >> 32)) {
+				return false;
+			}
+
+			continue;
+		}
+
+		//The entry is free (or it is left from an older generation).
+		unsigned int evaluation;
+		unsigned int words[ACTION_WORDS] = {};
+
+		memcpy(&evaluation, &placement.evaluation, sizeof(float));
+
+		for (int i = 0; i < placement.actionsAmount; i++) {
+			int bit = i * ACTION_BITS;
+
+			words[bit / 32] |= (unsigned int)placement.actions[i] << (bit % 32);
+
+			if (bit % 32 > 32 - ACTION_BITS) { //The action continues in the next word.
+				words[bit / 32 + 1] |= (unsigned int)placement.actions[i] >> (32 - bit % 32);
+			}
+		}
+
+		//The tag is cleared before the rest of the entry is written, so a reader of the older generation that is reading the entry at the same time
+		//does not find its tag again when it checks it after the read.
+		entry->tag.store(0, memory_order_relaxed);
+		atomic_thread_fence(memory_order_release);
+
+		entry->key[0].store((unsigned int)key, memory_order_relaxed);
+		entry->key[1].store((unsigned int)(key >> 32), memory_order_relaxed);
+		entry->evaluation.store(evaluation, memory_order_relaxed);
+		entry->actionsAmount.store((unsigned int)placement.actionsAmount, memory_order_relaxed);
+
+		for (int i = 0; i < ACTION_WORDS; i++) {
+			entry->actions[i].store(words[i], memory_order_relaxed);
+		}
+
+		entry->tag.store(generation, memory_order_release); //The tag is written last, so a reader that finds it reads the whole entry.
+		header->entriesAmount.store(entriesAmount + 1, memory_order_relaxed);
+		this->inserts++;
+
+		return true;
+	}
+
+	this->failedInserts++;
+
+	return false;
+}
+
+/*
+This function returns the amount of entries of the table.
+*/
+unsigned int PlacementCache::getCapacity() const {
+	return (this->memory != nullptr) ? this->getHeader()->capacity : 0;
+}
+
+/*
+This function returns the amount of entries of the current generation.
+*/
+unsigned int PlacementCache::getEntriesAmount() const {
+	return (this->memory != nullptr) ? this->getHeader()->entriesAmount.load(memory_order_relaxed) : 0;
+}
+
+/*
+This function returns the generation of the entries (it is increased whenever the version of the evaluation changes).
+*/
+unsigned int PlacementCache::getGeneration() const {
+	return (this->memory != nullptr) ? this->getHeader()->generation.load(memory_order_relaxed) : 0;
+}
+
+/*
+This function returns the amount of lookups this process made.
+*/
+long long PlacementCache::getLookups() const {
+	return this->lookups;
+}
+
+/*
+This function returns the amount of lookups of this process that found a placement.
+*/
+long long PlacementCache::getHits() const {
+	return this->hits;
+}
+
+/*
+This function returns the part of the lookups of this process that found a placement (between 0 and 1).
+*/
+double PlacementCache::getHitRate() const {
+	return (this->lookups > 0) ? (double)this->hits / this->lookups : 0;
+}
+
+/*
+This function returns the average amount of entries a lookup of this process read.
+*/
+double PlacementCache::getAverageProbes() const {
+	return (this->lookups > 0) ? (double)this->probes / this->lookups : 0;
+}
+
+/*
+This function returns the amount of placements this process added.
+*/
+long long PlacementCache::getInserts() const {
+	return this->inserts;
+}
+
+/*
+This function returns the amount of placements this process could not add since the table was full (or they took too many actions).
+*/
+long long PlacementCache::getFailedInserts() const {
+	return this->failedInserts;
+}
+
+/*
+This function returns the header at the beginning of the file.
+*/
+PlacementCache::Header * PlacementCache::getHeader() const {
+	return (Header *)this->memory;
+}
+
+/*
+This function returns the entry with the given index.
+*/
+PlacementCache::Entry * PlacementCache::getEntry(unsigned int index) const {
+	return (Entry *)((Header *)this->memory + 1) + index;
+}
+
+/*
+This function returns the key of the position of a state: the Zobrist hash of its board xored with the hash of its falling block.
+*/
+unsigned long long PlacementCache::getKey(const GameState& state) {
+	unsigned long long squares = 0;
+
+	static_assert(sizeof(state.blockSquares) == sizeof(squares), "The squares of the block are hashed as a single number.");
+	memcpy(&squares, state.blockSquares, sizeof(squares));
+
+	return getBoardHash(state.rowMasks) ^ mixBits(squares ^ mixBits(((unsigned long long)(unsigned char)state.blockType << 8) | (state.blockRotatedAmount & 1)));
+}
+
+/*
+This function returns the Zobrist hash of a board (the keys of its used squares xored together).
+*/
+unsigned long long PlacementCache::getBoardHash(const unsigned short rowMasks[Board::ROWS]) {
+	const ZobristKeys& keys = getZobristKeys();
+	unsigned long long hash = 0;
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		for (int j = 0; j < Board::COLS; j++) {
+			if (rowMasks[i] & (1u << j)) {
+				hash ^= keys.squares[i][j];
+			}
+		}
+	}
+
+	return hash;
+}
\ No newline at end of file
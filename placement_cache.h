@@ -0,0 +1,117 @@
+#ifndef __PLACEMENT_CACHE_H
+#define __PLACEMENT_CACHE_H
+
+#include <atomic>
+#include <string>
+#include "game_state.h"
+#include "game.h"
+using namespace std;
+
+/*
+The best placement of a block, as it is kept in the cache: the actions that lead to it and its evaluation.
+*/
+struct CachedPlacement {
+	constexpr static int MAX_ACTIONS = 32; //A placement that takes more actions is not cached.
+
+	float evaluation;
+	int actionsAmount;
+	unsigned char actions[MAX_ACTIONS]; //The action given to each step (a Game::eAction).
+};
+
+/*
+A persistent cache of the best placements of blocks, so a bot (or a hint) does not search the boards it has already seen again.
+The key of a position is the Zobrist hash of the board (the keys of its used squares xored together) xored with the hash of the falling block:
+its kind, its rotation and its squares (the squares give the shape, the orientation and the location, since a block may be searched after it has moved).
+
+The cache is an open-addressing table (with linear probing) in a memory-mapped file, so it is kept between runs and shared between processes:
+a single process opens it for writing and adds the placements it finds, and any amount of processes map it read-only and only look up.
+An entry is only rewritten by a later generation: the writer clears its tag (the cache's generation), writes the rest of it and then writes the new tag,
+so a reader that finds the same tag before and after it reads the entry has read it whole, without locks. The header holds the version of the evaluation the entries were made with: opening the cache for writing with another
+version starts a new generation (which makes every entry free, without writing to them), and the readers of another version find nothing.
+The table is not made larger: an entry is only added while the table is less than 3/4 full.
+
+The statistics (lookups, hits and probes) are counted by each process for itself, since the readers cannot write to the file.
+*/
+class PlacementCache {
+public:
+	constexpr static unsigned int MAGIC = 0x43504C50; //"PLPC" in little endian.
+	constexpr static unsigned int VERSION = 1; //Increased whenever the layout of the file changes.
+	constexpr static int DEFAULT_CAPACITY_BITS = 20; //A million entries (32MB).
+	constexpr static int MAX_CAPACITY_BITS = 28;
+
+private:
+	constexpr static int CACHE_LINE_SIZE = 64;
+	constexpr static int ACTION_BITS = 3;
+	constexpr static int ACTION_WORDS = (CachedPlacement::MAX_ACTIONS * ACTION_BITS + 31) / 32;
+
+	static_assert(ATOMIC_INT_LOCK_FREE == 2, "The atomics in the file must be lock-free to be shared between processes.");
+	static_assert(Game::JOKER_PAUSE < (1 << ACTION_BITS), "An action must fit in the bits it is packed in.");
+
+	struct alignas(CACHE_LINE_SIZE) Header {
+		unsigned int magic;
+		unsigned int version;
+		unsigned int capacity; //The amount of entries (a power of two).
+		unsigned int entrySize;
+		atomic<unsigned int> evaluationVersion; //The version of the evaluation of the entries (see PlacementEvaluator::getVersion).
+		atomic<unsigned int> generation; //The tag of the entries of the current version (0 is the tag of an entry that was never written).
+		atomic<unsigned int> entriesAmount; //The amount of entries of the current generation.
+	};
+
+	//The words are 32 bits, since a 64-bit atomic load is a write on 32-bit x86 and the readers map the file read-only.
+	struct Entry {
+		atomic<unsigned int> tag; //The generation the entry was added in.
+		atomic<unsigned int> key[2];
+		atomic<unsigned int> evaluation; //The bits of the float.
+		atomic<unsigned int> actionsAmount;
+		atomic<unsigned int> actions[ACTION_WORDS]; //ACTION_BITS bits for each action.
+	};
+
+	string fileName;
+	bool isWritable = false;
+	void *memory = nullptr;
+	size_t size = 0;
+	void *fileHandle = nullptr; //Only used on Windows.
+	void *mappingHandle = nullptr; //Only used on Windows.
+	unsigned int evaluationVersion = 0; //This property saves the version of the evaluation this process looks up and adds.
+
+	long long lookups = 0;
+	long long hits = 0;
+	long long probes = 0;
+	long long inserts = 0;
+	long long failedInserts = 0; //This property saves the amount of placements that were not added since the table was full (or they took too many actions).
+
+	Header *getHeader() const;
+	Entry *getEntry(unsigned int index) const;
+	bool map(bool isCreating, size_t size);
+	bool isValid() const;
+
+	PlacementCache(const PlacementCache& other) = delete;
+
+public:
+	PlacementCache() = default;
+	~PlacementCache();
+
+	bool create(const string& fileName, unsigned int evaluationVersion, int capacityBits = DEFAULT_CAPACITY_BITS);
+	bool open(const string& fileName, unsigned int evaluationVersion);
+	void close();
+	bool isOpen() const;
+	bool isCurrent() const;
+
+	bool find(unsigned long long key, CachedPlacement& placement);
+	bool insert(unsigned long long key, const CachedPlacement& placement);
+
+	unsigned int getCapacity() const;
+	unsigned int getEntriesAmount() const;
+	unsigned int getGeneration() const;
+	long long getLookups() const;
+	long long getHits() const;
+	double getHitRate() const;
+	double getAverageProbes() const;
+	long long getInserts() const;
+	long long getFailedInserts() const;
+
+	static unsigned long long getKey(const GameState& state);
+	static unsigned long long getBoardHash(const unsigned short rowMasks[Board::ROWS]);
+};
+
+#endif
\ No newline at end of file
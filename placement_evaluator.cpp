@@ -0,0 +1,95 @@
+#include "placement_evaluator.h"
+#include <cstdlib>
+
+/*
+Constructor - receives the weights of the features.
+*/
+PlacementEvaluator::PlacementEvaluator(const EvaluationWeights& weights) : weights(weights) {
+}
+
+/*
+This function finds every placement of the block of the given state and puts the one with the best evaluation into the output parameters,
+and returns false if the block has no placement (there is no block, or the game is over).
+The placements are searched with a high score, since the game does not let the score go below 0: a bomb's penalty is always counted in full,
+so the choice does not depend on the score (the states of the placements hold this score as well).
+The given game is used for running the steps, so its state is changed.
+*/
+bool PlacementEvaluator::findBest(Game& game, const GameState& start, Placement& best, double& evaluation) {
+	GameState searchStart = start;
+	int bestIndex = -1;
+
+	searchStart.score = SEARCH_SCORE;
+	this->finder.findPlacements(game, searchStart, this->placements);
+
+	for (size_t i = 0; i < this->placements.size(); i++) {
+		double placementEvaluation = this->evaluate(searchStart, this->placements[i].state);
+
+		if (bestIndex == -1 || placementEvaluation > evaluation) {
+			bestIndex = (int)i;
+			evaluation = placementEvaluation;
+		}
+	}
+
+	if (bestIndex == -1) {
+		return false;
+	}
+
+	best = this->placements[bestIndex];
+
+	return true;
+}
+
+/*
+This function returns the evaluation of the board a placement led to (higher is better).
+*/
+double PlacementEvaluator::evaluate(const GameState& start, const GameState& placed) const {
+	int heights[Board::COLS];
+	int aggregateHeight = 0;
+	int holes = 0;
+	int bumpiness = 0;
+
+	for (int j = 0; j < Board::COLS; j++) {
+		heights[j] = 0;
+
+		for (int i = 0; i < Board::ROWS; i++) {
+			if (placed.rowMasks[i] & (1u << j)) {
+				if (heights[j] == 0) {
+					heights[j] = Board::ROWS - i; //The first used square from the top.
+				}
+			}
+			else if (heights[j] != 0) {
+				holes++;
+			}
+		}
+
+		aggregateHeight += heights[j];
+
+		if (j > 0) {
+			bumpiness += abs(heights[j] - heights[j - 1]);
+		}
+	}
+
+	return this->weights.scoreGained * (placed.score - start.score) + this->weights.aggregateHeight * aggregateHeight
+		+ this->weights.holes * holes + this->weights.bumpiness * bumpiness;
+}
+
+/*
+This function returns a number that identifies the evaluation: the checksum of the formula's version and of the weights.
+*/
+unsigned int PlacementEvaluator::getVersion() const {
+	const unsigned char *bytes = (const unsigned char *)&this->weights;
+	unsigned int version = (2166136261u ^ FORMULA_VERSION) * 16777619u;
+
+	for (size_t i = 0; i < sizeof(this->weights); i++) {
+		version = (version ^ bytes[i]) * 16777619u;
+	}
+
+	return (version == 0) ? 1 : version; //A version of 0 means that the cache has no evaluation yet.
+}
+
+/*
+This function returns the finder the placements are found with (to read its statistics).
+*/
+const PlacementFinder& PlacementEvaluator::getFinder() const {
+	return this->finder;
+}
\ No newline at end of file
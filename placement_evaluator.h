@@ -0,0 +1,41 @@
+#ifndef __PLACEMENT_EVALUATOR_H
+#define __PLACEMENT_EVALUATOR_H
+
+#include "placement_finder.h"
+
+/*
+The weights of the features of a board that a placement leads to (see PlacementEvaluator).
+*/
+struct EvaluationWeights {
+	double scoreGained = 0.0076; //Per point of score the placement gained (clearing a line gains 100).
+	double aggregateHeight = -0.51; //Per square of the heights of all of the columns.
+	double holes = -0.36; //Per free square that has a used square above it.
+	double bumpiness = -0.18; //Per square of difference between the heights of neighbouring columns.
+};
+
+/*
+Chooses the best placement of the current block, as a bot or a hint would: every placement is found with PlacementFinder,
+and the board each placement leads to is evaluated as a weighted sum of its features (the score gained, the heights, the holes and the bumpiness).
+The evaluation only depends on the board and the block, and not on the score or on the blocks that come after it, so it can be cached (see PlacementCache).
+*/
+class PlacementEvaluator {
+public:
+	constexpr static unsigned int FORMULA_VERSION = 1; //Increased whenever evaluate changes, so the cached evaluations of the previous formula are not used.
+	constexpr static int SEARCH_SCORE = 1 << 24; //The score the placements are searched with (see findBest).
+
+private:
+	EvaluationWeights weights;
+	PlacementFinder finder;
+	vector<Placement> placements;
+
+public:
+	PlacementEvaluator(const EvaluationWeights& weights = EvaluationWeights());
+
+	bool findBest(Game& game, const GameState& start, Placement& best, double& evaluation);
+	double evaluate(const GameState& start, const GameState& placed) const;
+
+	unsigned int getVersion() const;
+	const PlacementFinder& getFinder() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "placement_finder.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+The location and rotation of the falling block, used as a key for the block states that were already reached.
+*/
+struct BlockKey {
+	signed char blockSquares[GameState::MAX_BLOCK_SQUARES][2];
+	unsigned char rotationParity;
+
+	bool operator==(const BlockKey& other) const {
+		return memcmp(this, &other, sizeof(BlockKey)) == 0;
+	}
+};
+
+/*
+This function returns the key of the falling block of a state.
+*/
+static BlockKey getBlockKey(const GameState& state) {
+	BlockKey key;
+
+	memset(&key, 0, sizeof(key));
+	memcpy(key.blockSquares, state.blockSquares, sizeof(key.blockSquares));
+	key.rotationParity = state.blockRotatedAmount & 1; //Only the parity of the rotations affects the next rotation.
+
+	return key;
+}
+
+/*
+This function receives the game to run the steps with and a state with a falling block, and puts every distinct placement of the block into the output parameter.
+The placements are found in a breadth-first order, so each placement comes with the shortest list of actions that leads to it.
+If a board can be reached in several ways, the placement with the highest score is kept (moving the block to the bottom increases the score).
+The given game is used for running the steps, so its state is changed.
+*/
+void PlacementFinder::findPlacements(Game& game, const GameState& start, vector<Placement>& placements) {
+	unordered_set<BlockKey, BytesHash<BlockKey>> reachedBlocks;
+	unordered_map<BoardKey, int, BytesHash<BoardKey>> placementIndexes; //The index in the output of the placement of each board.
+	GameState state;
+
+	placements.clear();
+	this->nodes.clear();
+
+	if (start.blockType == Game::NO_BLOCK || start.isFailed) {
+		return;
+	}
+
+	SearchNode first = {start, -1, Game::NO_ACTION};
+	this->nodes.push_back(first);
+	reachedBlocks.insert(getBlockKey(start));
+
+	for (size_t i = 0; i < this->nodes.size(); i++) {
+		for (int action = 0; action < ACTIONS_AMOUNT; action++) {
+			game.loadState(this->nodes[i].state);
+			game.tick((Game::eAction)action);
+			game.saveState(state);
+			this->stepsAmount++;
+
+			if (state.blockType != Game::NO_BLOCK) { //The block is still falling.
+				if (reachedBlocks.insert(getBlockKey(state)).second) {
+					SearchNode node = {state, (int)i, (Game::eAction)action};
+					this->nodes.push_back(node);
+				}
+
+				continue;
+			}
+
+			//The block was locked, paused or exploded.
+			BoardKey board = BoardKey::fromState(state);
+			unordered_map<BoardKey, int, BytesHash<BoardKey>>::iterator found = placementIndexes.find(board);
+
+			if (found == placementIndexes.end()) {
+				Placement placement;
+
+				placement.state = state;
+				this->getActions((int)i, (Game::eAction)action, placement.actions);
+				placementIndexes[board] = (int)placements.size();
+				placements.push_back(placement);
+			}
+			else if (state.score > placements[found->second].state.score) {
+				placements[found->second].state = state;
+				this->getActions((int)i, (Game::eAction)action, placements[found->second].actions);
+			}
+		}
+	}
+}
+
+/*
+This function puts the actions that lead from the first node to the given node, followed by the given last action, into the output parameter.
+*/
+void PlacementFinder::getActions(int nodeIndex, Game::eAction lastAction, vector<Game::eAction>& actions) const {
+	actions.clear();
+	actions.push_back(lastAction);
+
+	for (int i = nodeIndex; this->nodes[i].parent != -1; i = this->nodes[i].parent) {
+		actions.push_back(this->nodes[i].action);
+	}
+
+	reverse(actions.begin(), actions.end());
+}
+
+/*
+This function returns how many game steps were run by the searches so far.
+*/
+long long PlacementFinder::getStepsAmount() const {
+	return this->stepsAmount;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef __PLACEMENT_FINDER_H
+#define __PLACEMENT_FINDER_H
+
+#include <vector>
+#include <cstring>
+#include "game.h"
+#include "game_state.h"
+using namespace std;
+
+/*
+The used squares of a board, used as a key for sets and maps of boards.
+*/
+struct BoardKey {
+	unsigned short rowMasks[Board::ROWS];
+
+	bool operator==(const BoardKey& other) const {
+		return memcmp(this->rowMasks, other.rowMasks, sizeof(this->rowMasks)) == 0;
+	}
+
+	static BoardKey fromState(const GameState& state) {
+		BoardKey key;
+		memcpy(key.rowMasks, state.rowMasks, sizeof(key.rowMasks));
+		return key;
+	}
+
+	static BoardKey fromBoard(const Board& board) {
+		BoardKey key;
+		for (int i = 0; i < Board::ROWS; i++) {
+			key.rowMasks[i] = board.getRowMask(i);
+		}
+		return key;
+	}
+};
+
+/*
+FNV-1a hash of the bytes of a key.
+*/
+template <typename Key>
+struct BytesHash {
+	size_t operator()(const Key& key) const {
+		const unsigned char *bytes = (const unsigned char *)&key;
+		unsigned long long hash = 14695981039346656037ull;
+
+		for (size_t i = 0; i < sizeof(Key); i++) {
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+
+		return (size_t)hash;
+	}
+};
+
+/*
+A position the current block can be locked into (or, for a joker, paused at / for a bomb, exploded at), together with the actions that lead to it.
+*/
+struct Placement {
+	GameState state; //The state of the game right after the block was locked.
+	vector<Game::eAction> actions; //The action given to each step of the game, from the moment the block was added.
+};
+
+/*
+Finds every distinct board the current block of a game can be locked into.
+The falling block is moved by running the game's steps with every possible action, so the placements follow the game's rules exactly
+(the gravity, the joker's passing through squares and its pause, and the bomb's explosion).
+*/
+class PlacementFinder {
+public:
+	constexpr static int ACTIONS_AMOUNT = Game::JOKER_PAUSE + 1;
+
+private:
+	//A state of the falling block that was reached during the search.
+	struct SearchNode {
+		GameState state;
+		int parent; //The index of the node the block was at before the last step (-1 for the first node).
+		Game::eAction action; //The action of the last step.
+	};
+
+	vector<SearchNode> nodes;
+	long long stepsAmount = 0;
+
+	void getActions(int nodeIndex, Game::eAction lastAction, vector<Game::eAction>& actions) const;
+
+public:
+	void findPlacements(Game& game, const GameState& start, vector<Placement>& placements);
+
+	long long getStepsAmount() const;
+};
+
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "point.h"
+#include "memory_pool.h"
 
 /*
 Constructor - initializes a new point with given x and y parameters in the console.
@@ -34,4 +35,26 @@ This function returns the y property of the current point.
 */
 int Point::getY() const {
 	return this->y;
+}
+
+/*
+This function returns the pool the points of the current thread are allocated from.
+*/
+static MemoryPool& getPointsPool() {
+	static thread_local MemoryPool pool(sizeof(Point));
+	return pool;
+}
+
+/*
+This function allocates memory for a new point from the pool.
+*/
+void * Point::operator new(size_t size) {
+	return getPointsPool().allocate(size);
+}
+
+/*
+This function returns the memory of a point to the pool.
+*/
+void Point::operator delete(void *p) {
+	MemoryPool::deallocate(p); //The chunk goes back to the pool it came from, which may belong to another thread.
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef __POINT_H
 #define __POINT_H
 
+#include <cstddef>
+
 class Point {
 public:
 	constexpr static int GAME_LOCATION_OFFSET_X = 8;
@@ -18,6 +20,10 @@ public:
 
 	int getX() const;
 	int getY() const;
+
+	//The points are allocated from a pool of the current thread, since the blocks allocate and free them all the time.
+	static void * operator new(size_t size);
+	static void operator delete(void *p);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "random_stream.h"
+
+/*
+Constructor - initializes the stream with the given seed.
+*/
+RandomStream::RandomStream(unsigned int seed) {
+	this->reset(seed);
+}
+
+/*
+This function restarts the stream with the given seed.
+*/
+void RandomStream::reset(unsigned int seed) {
+	this->seed = seed;
+	this->counter = 0;
+}
+
+/*
+This function returns the next number in the stream.
+The number is calculated by mixing the seed and the counter (the splitmix64 finalizer), so there is no other state to keep.
+*/
+unsigned int RandomStream::next() {
+	unsigned long long z = (((unsigned long long)this->seed << 32) | this->counter) + 0x9E3779B97F4A7C15ULL;
+
+	this->counter++;
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z = z ^ (z >> 31);
+
+	return (unsigned int)(z >> 32);
+}
+
+/*
+This function returns the next number in the stream scaled to the range 0 to max - 1.
+*/
+int RandomStream::nextInRange(int max) {
+	return (int)(((unsigned long long)this->next() * (unsigned int)max) >> 32);
+}
+
+/*
+This function returns the seed of the stream.
+*/
+unsigned int RandomStream::getSeed() const {
+	return this->seed;
+}
+
+/*
+This function returns how many numbers were taken from the stream.
+*/
+unsigned int RandomStream::getCounter() const {
+	return this->counter;
+}
+
+/*
+This function moves the stream to the given position.
+*/
+void RandomStream::setCounter(unsigned int counter) {
+	this->counter = counter;
+}
\ No newline at end of file
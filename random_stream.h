@@ -0,0 +1,25 @@
+#ifndef __RANDOM_STREAM_H
+#define __RANDOM_STREAM_H
+
+/*
+A reproducible stream of random numbers - the n-th number of the stream depends only on the seed and on n,
+so a game can be replayed from its seed and the position in the stream can be saved as a single counter.
+*/
+class RandomStream {
+private:
+	unsigned int seed = 0;
+	unsigned int counter = 0; //This property saves how many numbers were taken from the stream.
+
+public:
+	RandomStream(unsigned int seed = 0);
+
+	void reset(unsigned int seed);
+	unsigned int next();
+	int nextInRange(int max);
+
+	unsigned int getSeed() const;
+	unsigned int getCounter() const;
+	void setCounter(unsigned int counter);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "randomizer_config.h"
+#include "blocks_generator.h"
+#include <fstream>
+#include <sstream>
+#include <cmath>
+
+const char *const RandomizerConfig::BLOCK_NAMES[BLOCK_TYPES_AMOUNT] = {"square", "line", "snake", "gamma", "plus", "joker", "bomb"};
+
+static_assert(RandomizerConfig::BLOCK_TYPES_AMOUNT == BlocksGenerator::BOMB_BLOCK + 1, "Every type of block needs a weight.");
+
+/*
+This function returns the settings used by the games that are started from now on.
+*/
+static RandomizerConfig& getCurrentConfig() {
+	static RandomizerConfig current;
+	return current;
+}
+
+/*
+Constructor - initializes the settings to the game's original mix of blocks.
+*/
+RandomizerConfig::RandomizerConfig() {
+	for (int i = 0; i < BLOCK_TYPES_AMOUNT; i++) {
+		this->weights[i] = BlocksGenerator::DEFAULT_WEIGHTS[i];
+	}
+}
+
+/*
+This function reads the settings from a text file and returns whether it succeeded (if not, the error parameter describes the problem).
+Each line of the file is "name = value", and everything after a '#' is a comment. The names are:
+mode (weighted, bag or history), the name of each block (square, line, snake, gamma, plus, joker, bomb), history_size and history_rolls.
+Settings that are not in the file keep their current values. If reading failed, none of the settings is changed.
+*/
+bool RandomizerConfig::loadFromFile(const string& fileName, string& error) {
+	ifstream inFile(fileName);
+	RandomizerConfig loaded = *this;
+	string line;
+	int lineNumber = 0;
+
+	if (!inFile.is_open()) {
+		error = "Cannot open " + fileName + ".";
+		return false;
+	}
+
+	while (getline(inFile, line)) {
+		lineNumber++;
+
+		size_t commentStart = line.find('#');
+		if (commentStart != string::npos) {
+			line.erase(commentStart);
+		}
+
+		size_t separator = line.find('=');
+		stringstream nameStream(line.substr(0, separator));
+		string name, value, rest;
+
+		if (!(nameStream >> name)) { //An empty line.
+			continue;
+		}
+
+		stringstream valueStream(separator == string::npos ? "" : line.substr(separator + 1));
+
+		if (!(valueStream >> value) || (valueStream >> rest)) {
+			error = fileName + ":" + to_string(lineNumber) + ": expected \"name = value\".";
+			return false;
+		}
+
+		bool isKnown = false;
+
+		for (int i = 0; i < BLOCK_TYPES_AMOUNT; i++) {
+			if (name == BLOCK_NAMES[i]) {
+				stringstream number(value);
+				isKnown = (number >> loaded.weights[i]) && number.eof();
+			}
+		}
+
+		if (name == "mode") {
+			isKnown = true;
+
+			if (value == "weighted") {
+				loaded.mode = WEIGHTED_MODE;
+			}
+			else if (value == "bag") {
+				loaded.mode = BAG_MODE;
+			}
+			else if (value == "history") {
+				loaded.mode = HISTORY_MODE;
+			}
+			else {
+				isKnown = false;
+			}
+		}
+		else if (name == "history_size" || name == "history_rolls") {
+			stringstream number(value);
+			isKnown = (number >> (name == "history_size" ? loaded.historySize : loaded.historyRolls)) && number.eof();
+		}
+
+		if (!isKnown) {
+			error = fileName + ":" + to_string(lineNumber) + ": invalid setting \"" + name + " = " + value + "\".";
+			return false;
+		}
+	}
+
+	if (!loaded.validate(error)) {
+		error = fileName + ": " + error;
+		return false;
+	}
+
+	*this = loaded;
+
+	return true;
+}
+
+/*
+This function returns whether the settings can be used (if not, the error parameter describes the problem).
+*/
+bool RandomizerConfig::validate(string& error) const {
+	double sum = 0;
+
+	for (int i = 0; i < BLOCK_TYPES_AMOUNT; i++) {
+		if (!(this->weights[i] >= 0) || std::isinf(this->weights[i])) {
+			error = string("the weight of the ") + BLOCK_NAMES[i] + " must be a non-negative number.";
+			return false;
+		}
+
+		sum += this->weights[i];
+	}
+
+	if (sum <= 0) {
+		error = "at least one of the weights must be positive.";
+		return false;
+	}
+
+	if (this->mode == BAG_MODE && (this->getBagSize() <= 0 || this->getBagSize() > MAX_BAG_SIZE)) {
+		error = "in the bag mode, the weights are rounded to whole numbers, and their sum must be between 1 and " + to_string(MAX_BAG_SIZE) + ".";
+		return false;
+	}
+
+	if (this->historySize < 1 || this->historySize > MAX_HISTORY_SIZE || this->historyRolls < 1 || this->historyRolls > MAX_HISTORY_ROLLS) {
+		error = "history_size and history_rolls must be between 1 and " + to_string(MAX_HISTORY_SIZE) + ".";
+		return false;
+	}
+
+	return true;
+}
+
+/*
+This function returns the amount of blocks in a bag (the sum of the rounded weights).
+*/
+int RandomizerConfig::getBagSize() const {
+	double size = 0;
+
+	for (int i = 0; i < BLOCK_TYPES_AMOUNT; i++) {
+		size += floor(this->weights[i] + 0.5);
+	}
+
+	return (size > MAX_BAG_SIZE) ? MAX_BAG_SIZE + 1 : (int)size;
+}
+
+/*
+This function returns the FNV-1a hash of the given bytes (continuing the given hash).
+*/
+static unsigned int addToHash(const void *data, size_t size, unsigned int hash) {
+	const unsigned char *bytes = (const unsigned char *)data;
+
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+
+	return hash;
+}
+
+/*
+This function returns a hash of the settings, so a saved position can tell whether a game picks its blocks with the same settings.
+*/
+unsigned int RandomizerConfig::getFingerprint() const {
+	unsigned int hash = 2166136261u;
+
+	hash = addToHash(&this->mode, sizeof(this->mode), hash);
+	hash = addToHash(this->weights, sizeof(this->weights), hash);
+	hash = addToHash(&this->historySize, sizeof(this->historySize), hash);
+	hash = addToHash(&this->historyRolls, sizeof(this->historyRolls), hash);
+
+	return hash;
+}
+
+/*
+This function returns the settings used by the games that are started from now on.
+*/
+const RandomizerConfig& RandomizerConfig::getCurrent() {
+	return getCurrentConfig();
+}
+
+/*
+This function sets the settings used by the games that are started from now on (it should be called before any game runs on another thread).
+*/
+void RandomizerConfig::setCurrent(const RandomizerConfig& config) {
+	getCurrentConfig() = config;
+}
\ No newline at end of file
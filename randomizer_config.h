@@ -0,0 +1,43 @@
+#ifndef __RANDOMIZER_CONFIG_H
+#define __RANDOMIZER_CONFIG_H
+
+#include <string>
+using namespace std;
+
+/*
+The settings of the blocks randomizer: how the next block is picked and how often each type of block appears.
+The settings can be loaded from a text file, so the mix of blocks can be changed without building the game again.
+*/
+class RandomizerConfig {
+public:
+	enum eMode {WEIGHTED_MODE, BAG_MODE, HISTORY_MODE};
+
+	constexpr static int BLOCK_TYPES_AMOUNT = 7; //The amount of values of BlocksGenerator::eBlockType.
+	constexpr static int MAX_BAG_SIZE = 1000;
+	constexpr static int MAX_HISTORY_SIZE = 16;
+	constexpr static int MAX_HISTORY_ROLLS = 16;
+
+	constexpr static int DEFAULT_HISTORY_SIZE = 4;
+	constexpr static int DEFAULT_HISTORY_ROLLS = 4;
+
+	static const char *const BLOCK_NAMES[BLOCK_TYPES_AMOUNT]; //The names of the weights in the file, in the order of BlocksGenerator::eBlockType.
+
+	//The weight of each type of block (the chance of a block is its weight divided by the sum of the weights).
+	//In the bag mode, the weights are the amount of copies of each block in a bag, so they are rounded to whole numbers.
+	double weights[BLOCK_TYPES_AMOUNT];
+	eMode mode = WEIGHTED_MODE;
+	int historySize = DEFAULT_HISTORY_SIZE; //In the history mode, a block that is one of the last historySize blocks is picked again,
+	int historyRolls = DEFAULT_HISTORY_ROLLS; //up to historyRolls times.
+
+	RandomizerConfig();
+
+	bool loadFromFile(const string& fileName, string& error);
+	bool validate(string& error) const;
+	int getBagSize() const;
+	unsigned int getFingerprint() const;
+
+	static const RandomizerConfig& getCurrent();
+	static void setCurrent(const RandomizerConfig& config);
+};
+
+#endif
\ No newline at end of file
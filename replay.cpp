@@ -0,0 +1,90 @@
+#include "replay.h"
+
+/*
+This function starts recording a game that was just started (with no actions and no steps yet).
+*/
+void Replay::start(const Game& game) {
+	this->seed = game.getNextBlocks().getSeed();
+	this->speed = game.getSpeed();
+	this->score = 0;
+	this->blocksDropped = 0;
+	this->steps = 0;
+	this->entries.clear();
+	this->pendingGap = 0;
+}
+
+/*
+This function records a move or a rotation that was made between two steps.
+*/
+void Replay::addAction(Game::eAction action) {
+	ReplayEntry entry;
+
+	entry.gap = this->pendingGap;
+	entry.action = (unsigned char)action;
+	this->entries.push_back(entry);
+	this->pendingGap = 0;
+}
+
+/*
+This function records a step of the game with the given action. A move or a rotation of a step is made before the step (Game::tick does the same),
+so it is recorded as a move and a step without an action.
+*/
+void Replay::addStep(Game::eAction action) {
+	if (action == Game::MOVE_DOWN || action == Game::JOKER_PAUSE) {
+		this->addAction(action);
+	}
+	else {
+		if (action != Game::NO_ACTION) {
+			this->addAction(action);
+		}
+
+		this->pendingGap++;
+	}
+
+	this->steps++;
+}
+
+/*
+This function saves the result of the recorded game (when it is over).
+*/
+void Replay::finish(const Game& game) {
+	this->score = game.getScore();
+	this->blocksDropped = game.getNumOfBlocks();
+}
+
+/*
+This function plays the recorded game again from its start. The game's speed is set as well, although the steps do not depend on it.
+*/
+void Replay::play(Game& game) const {
+	long long stepsRun = 0;
+
+	game.setSpeed(this->speed);
+	game.start(this->seed);
+
+	for (const ReplayEntry& entry : this->entries) {
+		for (unsigned int i = 0; i < entry.gap; i++) {
+			game.tick(Game::NO_ACTION);
+		}
+
+		stepsRun += entry.gap;
+
+		if (entry.action == Game::MOVE_DOWN || entry.action == Game::JOKER_PAUSE) {
+			game.tick((Game::eAction)entry.action);
+			stepsRun++;
+		}
+		else {
+			game.act((Game::eAction)entry.action);
+		}
+	}
+
+	for (; stepsRun < this->steps; stepsRun++) {
+		game.tick(Game::NO_ACTION);
+	}
+}
+
+/*
+This function returns whether the game ended the way the recorded game did (after it was played again).
+*/
+bool Replay::isMatching(const Game& game) const {
+	return game.isGameOver() && game.getScore() == this->score && game.getNumOfBlocks() == this->blocksDropped;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef __REPLAY_H
+#define __REPLAY_H
+
+#include <vector>
+using namespace std;
+
+#include "game.h"
+
+/*
+An action of a recorded game, and the amount of steps without an action that were run before it.
+*/
+struct ReplayEntry {
+	unsigned int gap; //The amount of steps without an action since the previous entry (or since the game started).
+	unsigned char action; //A Game::eAction other than NO_ACTION (the game keys of Tetris::eKeys).
+};
+
+/*
+A recorded game: its seed and the player's actions, which is all it takes to play the game again since the game is deterministic.
+A move or a rotation is made between two steps, and dropping the block or pausing the joker is the action of a step (like GameSession handles them),
+so the steps without an action are only counted. The result of the game is saved as well, to check that playing it again ends the same way
+(the blocks depend on the current RandomizerConfig, so a game recorded with another block mix does not).
+*/
+struct Replay {
+	unsigned int seed = 0;
+	int speed = Game::DEFAULT_SPEED;
+	int score = 0;
+	int blocksDropped = 0;
+	long long steps = 0; //The amount of steps of the game (with and without actions).
+	vector<ReplayEntry> entries;
+	unsigned int pendingGap = 0; //The amount of steps without an action since the last entry (only used while the game is recorded).
+
+	void start(const Game& game);
+	void addAction(Game::eAction action);
+	void addStep(Game::eAction action);
+	void finish(const Game& game);
+
+	void play(Game& game) const;
+	bool isMatching(const Game& game) const;
+};
+
+#endif
\ No newline at end of file
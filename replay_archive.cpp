@@ -0,0 +1,862 @@
+#include "replay_archive.h"
+#include <algorithm>
+#include <cstddef>
+
+constexpr unsigned int FILE_MAGIC = 0x414C5052; //"RPLA"
+constexpr unsigned int BLOCK_MAGIC = 0x4B425052; //"RPBK"
+constexpr unsigned int INDEX_MAGIC = 0x58495052; //"RPIX"
+constexpr unsigned int FOOTER_MAGIC = 0x54465052; //"RPFT"
+constexpr unsigned int VERSION = 1;
+
+constexpr int SCALE_BITS = 12; //The frequencies of the bytes of a stream are scaled to add up to 2^SCALE_BITS.
+constexpr unsigned int SCALE = 1u << SCALE_BITS;
+constexpr unsigned int STATE_LOW = 1u << 23; //The state of the coder is kept between STATE_LOW and 2^31 (it is written a byte at a time when it gets larger).
+
+struct FileHeader {
+	unsigned int magic;
+	unsigned int version;
+};
+
+/*
+The header of a block, followed by the compressed streams of the block.
+*/
+struct BlockHeader {
+	unsigned int magic;
+	unsigned int gamesAmount;
+	unsigned int sizes[ReplayArchive::STREAMS_AMOUNT]; //The sizes of the streams before they were compressed.
+	unsigned int encodedSizes[ReplayArchive::STREAMS_AMOUNT];
+	unsigned int dataChecksum; //The checksum of the compressed streams.
+	unsigned int checksum; //The checksum of the fields above.
+};
+
+/*
+The header of the index, followed by the compressed index.
+*/
+struct IndexHeader {
+	unsigned int magic;
+	unsigned int version;
+	long long gamesAmount;
+	unsigned int size; //The size of the index before it was compressed.
+	unsigned int encodedSize;
+	unsigned int reserved;
+	unsigned int checksum; //The checksum of the fields above and of the compressed index.
+};
+
+/*
+The end of the file.
+*/
+struct Footer {
+	long long indexOffset;
+	unsigned int magic;
+	unsigned int checksum; //The checksum of the position of the index.
+};
+
+/*
+This function returns the FNV-1a checksum of the given bytes (continuing the given checksum).
+*/
+static unsigned int getChecksum(const void *data, size_t size, unsigned int checksum = 2166136261u) {
+	const unsigned char *bytes = (const unsigned char *)data;
+
+	for (size_t i = 0; i < size; i++) {
+		checksum = (checksum ^ bytes[i]) * 16777619u;
+	}
+
+	return checksum;
+}
+
+/*
+This function adds a number to the end of the stream as a varint (7 bits in each byte, the highest bit is set on every byte but the last).
+*/
+static void writeVarint(vector<unsigned char>& stream, unsigned long long value) {
+	while (value >= 0x80) {
+		stream.push_back((unsigned char)(value | 0x80));
+		value >>= 7;
+	}
+
+	stream.push_back((unsigned char)value);
+}
+
+/*
+This function adds a signed number to the end of the stream as a zigzag varint (small negative numbers take as few bytes as small positive ones).
+*/
+static void writeSignedVarint(vector<unsigned char>& stream, long long value) {
+	writeVarint(stream, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+/*
+This function reads a varint of the stream and returns false if the stream has ended or the varint is too long.
+*/
+static bool readVarint(const unsigned char *data, size_t size, size_t& position, unsigned long long& value) {
+	unsigned char byte = 0x80;
+
+	value = 0;
+
+	for (int shift = 0; (byte & 0x80) != 0; shift += 7) {
+		if (shift > 63 || position >= size) {
+			return false;
+		}
+
+		byte = data[position++];
+		value |= (unsigned long long)(byte & 0x7F) << shift;
+	}
+
+	return true;
+}
+
+/*
+This function reads a zigzag varint of the stream.
+*/
+static bool readSignedVarint(const unsigned char *data, size_t size, size_t& position, long long& value) {
+	unsigned long long encoded;
+
+	if (!readVarint(data, size, position, encoded)) {
+		return false;
+	}
+
+	value = (long long)(encoded >> 1) ^ -(long long)(encoded & 1);
+
+	return true;
+}
+
+/*
+This function scales the counts of the bytes of a stream to frequencies that add up to SCALE. Every byte that appears keeps a frequency of at least 1.
+*/
+static void normalizeFrequencies(const unsigned int counts[256], size_t total, unsigned int frequencies[256]) {
+	unsigned int sum = 0;
+	int mostCommon = 0;
+
+	for (int i = 0; i < 256; i++) {
+		frequencies[i] = (counts[i] == 0) ? 0 : max(1u, (unsigned int)((unsigned long long)counts[i] * SCALE / total));
+		sum += frequencies[i];
+
+		if (counts[i] > counts[mostCommon]) {
+			mostCommon = i;
+		}
+	}
+
+	//Rounding the rare bytes up to 1 may make the sum too large, so it is taken from the largest frequencies (which are larger than 1, since there are at most 256 bytes).
+	while (sum > SCALE) {
+		int largest = (int)(max_element(frequencies, frequencies + 256) - frequencies);
+
+		frequencies[largest]--;
+		sum--;
+	}
+
+	frequencies[mostCommon] += SCALE - sum;
+}
+
+/*
+This function compresses a stream: it writes the frequencies of its bytes (the amount of bytes that appear, then each byte and its frequency),
+followed by the stream coded with rANS. The bytes are coded from the last one, so the decoder reads them from the first one.
+*/
+void ReplayArchive::encodeStream(const vector<unsigned char>& data, vector<unsigned char>& encoded) {
+	unsigned int counts[256] = {};
+	unsigned int frequencies[256];
+	unsigned int starts[256];
+	unsigned int start = 0;
+	int symbolsAmount = 0;
+
+	encoded.clear();
+
+	if (data.empty()) {
+		return;
+	}
+
+	for (unsigned char byte : data) {
+		counts[byte]++;
+	}
+
+	normalizeFrequencies(counts, data.size(), frequencies);
+
+	for (int i = 0; i < 256; i++) {
+		starts[i] = start;
+		start += frequencies[i];
+		symbolsAmount += (frequencies[i] != 0) ? 1 : 0;
+	}
+
+	encoded.push_back((unsigned char)symbolsAmount); //256 bytes are written as 0.
+
+	for (int i = 0; i < 256; i++) {
+		if (frequencies[i] != 0) {
+			encoded.push_back((unsigned char)i);
+			writeVarint(encoded, frequencies[i]);
+		}
+	}
+
+	vector<unsigned char> buffer(data.size() * 2 + sizeof(unsigned int)); //A byte takes at most SCALE_BITS bits.
+	unsigned char *end = buffer.data() + buffer.size();
+	unsigned char *output = end;
+	unsigned int state = STATE_LOW;
+
+	for (size_t i = data.size(); i-- > 0;) {
+		unsigned int frequency = frequencies[data[i]];
+		unsigned int stateMax = ((STATE_LOW >> SCALE_BITS) << 8) * frequency;
+
+		while (state >= stateMax) {
+			*--output = (unsigned char)(state & 0xFF);
+			state >>= 8;
+		}
+
+		state = ((state / frequency) << SCALE_BITS) + (state % frequency) + starts[data[i]];
+	}
+
+	for (int i = 0; i < 4; i++) {
+		*--output = (unsigned char)(state >> (8 * i)); //The decoder reads the state from its highest byte.
+	}
+
+	encoded.insert(encoded.end(), output, end);
+}
+
+/*
+This function decompresses a stream of the given size, and returns false if the compressed stream is damaged.
+The byte of each state is found in a table of SCALE entries, so decoding a byte takes a lookup, a multiplication and (sometimes) reading a byte.
+*/
+bool ReplayArchive::decodeStream(const unsigned char *encoded, size_t encodedSize, size_t size, vector<unsigned char>& data) {
+	unsigned int frequencies[256] = {};
+	unsigned int starts[256];
+	unsigned char symbols[SCALE];
+	unsigned int start = 0;
+	size_t position = 1;
+
+	data.resize(size);
+
+	if (size == 0 || encodedSize == 0) {
+		return size == 0 && encodedSize == 0;
+	}
+
+	int symbolsAmount = (encoded[0] == 0) ? 256 : encoded[0];
+
+	for (int i = 0; i < symbolsAmount; i++) {
+		unsigned long long frequency;
+
+		if (position >= encodedSize) {
+			return false;
+		}
+
+		unsigned char symbol = encoded[position++];
+
+		if (!readVarint(encoded, encodedSize, position, frequency) || frequency == 0 || frequency > SCALE || frequencies[symbol] != 0) {
+			return false;
+		}
+
+		frequencies[symbol] = (unsigned int)frequency;
+	}
+
+	for (int i = 0; i < 256; i++) {
+		if (start + frequencies[i] > SCALE) {
+			return false;
+		}
+
+		starts[i] = start;
+		fill(symbols + start, symbols + start + frequencies[i], (unsigned char)i);
+		start += frequencies[i];
+	}
+
+	if (start != SCALE || encodedSize - position < 4) {
+		return false;
+	}
+
+	unsigned int state = 0;
+
+	for (int i = 0; i < 4; i++) {
+		state = (state << 8) | encoded[position++];
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		unsigned int slot = state & (SCALE - 1);
+		unsigned char symbol = symbols[slot];
+
+		data[i] = symbol;
+		state = frequencies[symbol] * (state >> SCALE_BITS) + slot - starts[symbol];
+
+		while (state < STATE_LOW) {
+			if (position >= encodedSize) {
+				return false;
+			}
+
+			state = (state << 8) | encoded[position++];
+		}
+	}
+
+	return state == STATE_LOW && position == encodedSize; //The coder started from STATE_LOW, so it ends there when all of the stream was read.
+}
+
+/*
+Destructor - writes the games that are kept in memory and the index.
+*/
+ReplayArchiveWriter::~ReplayArchiveWriter() {
+	this->close();
+}
+
+/*
+This function opens an archive for adding games to it (it is created if it does not exist), and returns false if it cannot be opened
+or it is not a replay archive.
+*/
+bool ReplayArchiveWriter::open(const string& fileName) {
+	this->close();
+
+	//Creating the archive if it does not exist, and finding its size.
+	{
+		ofstream create(fileName, ios::binary | ios::app);
+		if (!create.is_open()) {
+			return false;
+		}
+
+		create.seekp(0, ios::end);
+		this->fileSize = (long long)create.tellp();
+	}
+
+	this->index.clear();
+
+	if (this->fileSize > 0) {
+		ReplayArchiveReader reader;
+
+		if (!reader.open(fileName)) {
+			return false;
+		}
+
+		this->index = reader.getIndex();
+		this->blocksEnd = reader.getBlocksEnd();
+	}
+
+	this->file.open(fileName, ios::binary | ios::in | ios::out);
+
+	if (!this->file.is_open()) {
+		return false;
+	}
+
+	if (this->fileSize == 0) {
+		FileHeader header = {FILE_MAGIC, VERSION};
+
+		this->file.write((const char *)&header, sizeof(header));
+		this->blocksEnd = sizeof(header);
+		this->fileSize = sizeof(header);
+	}
+
+	this->blocksWritten = 0;
+	this->streamsSize = 0;
+	this->isOpen = (bool)this->file;
+
+	return this->isOpen;
+}
+
+/*
+This function adds a game to the archive, and returns false if it cannot be written (or it has an entry with no action).
+*/
+bool ReplayArchiveWriter::append(const Replay& replay) {
+	if (!this->isOpen) {
+		return false;
+	}
+
+	for (const ReplayEntry& entry : replay.entries) {
+		if (entry.action == Game::NO_ACTION || entry.action > Game::JOKER_PAUSE) {
+			return false;
+		}
+	}
+
+	vector<unsigned char>& details = this->streams[ReplayArchive::DETAILS_STREAM];
+	for (int i = 0; i < 4; i++) {
+		details.push_back((unsigned char)(replay.seed >> (8 * i))); //The seeds are random, so a varint would only make them longer.
+	}
+
+	writeVarint(details, (unsigned long long)replay.speed);
+	writeSignedVarint(details, replay.score); //A bomb can make the score negative.
+	writeVarint(details, (unsigned long long)replay.blocksDropped);
+	writeVarint(details, (unsigned long long)replay.steps);
+	writeVarint(details, replay.entries.size());
+
+	for (const ReplayEntry& entry : replay.entries) {
+		unsigned int gapToken = min(entry.gap, (unsigned int)ReplayArchive::GAP_TOKENS - 1);
+
+		this->streams[ReplayArchive::TOKENS_STREAM].push_back((unsigned char)((entry.action - 1) * ReplayArchive::GAP_TOKENS + gapToken));
+
+		if (gapToken == ReplayArchive::GAP_TOKENS - 1) {
+			writeVarint(this->streams[ReplayArchive::GAPS_STREAM], entry.gap - gapToken);
+		}
+	}
+
+	size_t pendingSize = 0;
+
+	this->pendingScores.push_back(replay.score);
+
+	for (int i = 0; i < ReplayArchive::STREAMS_AMOUNT; i++) {
+		pendingSize += this->streams[i].size();
+	}
+
+	if (pendingSize < ReplayArchive::BLOCK_SIZE && (int)this->pendingScores.size() < ReplayArchive::MAX_GAMES_PER_BLOCK) {
+		return true;
+	}
+
+	return this->writeBlock();
+}
+
+/*
+This function writes the games that are kept in memory as a block (after the last block).
+*/
+bool ReplayArchiveWriter::writeBlock() {
+	if (this->pendingScores.empty()) {
+		return true;
+	}
+
+	BlockHeader header = {};
+	vector<unsigned char> encoded[ReplayArchive::STREAMS_AMOUNT];
+	long long dataSize = 0;
+
+	header.magic = BLOCK_MAGIC;
+	header.gamesAmount = (unsigned int)this->pendingScores.size();
+	header.dataChecksum = 2166136261u;
+
+	for (int i = 0; i < ReplayArchive::STREAMS_AMOUNT; i++) {
+		ReplayArchive::encodeStream(this->streams[i], encoded[i]);
+		header.sizes[i] = (unsigned int)this->streams[i].size();
+		this->streamsSize += header.sizes[i];
+		header.encodedSizes[i] = (unsigned int)encoded[i].size();
+		header.dataChecksum = getChecksum(encoded[i].data(), encoded[i].size(), header.dataChecksum);
+		dataSize += encoded[i].size();
+	}
+
+	header.checksum = getChecksum(&header, offsetof(BlockHeader, checksum));
+
+	this->file.seekp(this->blocksEnd);
+	this->file.write((const char *)&header, sizeof(header));
+
+	for (int i = 0; i < ReplayArchive::STREAMS_AMOUNT; i++) {
+		this->file.write((const char *)encoded[i].data(), encoded[i].size());
+	}
+
+	if (!this->file) {
+		return false;
+	}
+
+	for (size_t i = 0; i < this->pendingScores.size(); i++) {
+		this->index.push_back({this->blocksEnd, (unsigned int)i, this->pendingScores[i]});
+	}
+
+	this->blocksEnd += sizeof(header) + dataSize;
+	this->fileSize = max(this->fileSize, this->blocksEnd);
+	this->blocksWritten++;
+	this->pendingScores.clear();
+
+	for (int i = 0; i < ReplayArchive::STREAMS_AMOUNT; i++) {
+		this->streams[i].clear();
+	}
+
+	return true;
+}
+
+/*
+This function writes the index and the footer after the last block. If the file is longer (it had a damaged block at its end),
+the footer is written at the end of the file, since there is no portable way to make a file shorter.
+*/
+bool ReplayArchiveWriter::writeIndex() {
+	IndexHeader header = {};
+	Footer footer = {};
+	vector<unsigned char> stream;
+	vector<unsigned char> encoded;
+	long long previousOffset = 0;
+
+	//Each block is written as the distance from the previous block and its amount of games, followed by the scores of its games.
+	for (size_t i = 0; i < this->index.size(); i++) {
+		const ReplayArchiveEntry& entry = this->index[i];
+
+		if (entry.gameInBlock == 0) {
+			size_t end = i + 1;
+
+			while (end < this->index.size() && this->index[end].gameInBlock != 0) {
+				end++;
+			}
+
+			writeVarint(stream, (unsigned long long)(entry.blockOffset - previousOffset));
+			writeVarint(stream, end - i);
+			previousOffset = entry.blockOffset;
+		}
+
+		writeSignedVarint(stream, entry.score);
+	}
+
+	ReplayArchive::encodeStream(stream, encoded);
+
+	header.magic = INDEX_MAGIC;
+	header.version = VERSION;
+	header.gamesAmount = (long long)this->index.size();
+	header.size = (unsigned int)stream.size();
+	header.encodedSize = (unsigned int)encoded.size();
+	header.checksum = getChecksum(encoded.data(), encoded.size(), getChecksum(&header, offsetof(IndexHeader, checksum)));
+
+	long long indexEnd = this->blocksEnd + sizeof(header) + encoded.size();
+
+	this->file.seekp(this->blocksEnd);
+	this->file.write((const char *)&header, sizeof(header));
+	this->file.write((const char *)encoded.data(), encoded.size());
+
+	if (this->fileSize > indexEnd + (long long)sizeof(footer)) {
+		vector<char> padding((size_t)(this->fileSize - indexEnd - sizeof(footer)), 0);
+
+		this->file.write(padding.data(), padding.size());
+	}
+
+	footer.indexOffset = this->blocksEnd;
+	footer.magic = FOOTER_MAGIC;
+	footer.checksum = getChecksum(&footer, offsetof(Footer, checksum));
+	this->file.write((const char *)&footer, sizeof(footer));
+	this->file.flush();
+
+	this->fileSize = max(this->fileSize, indexEnd + (long long)sizeof(footer));
+
+	return (bool)this->file;
+}
+
+/*
+This function writes the games that are kept in memory and the index, so the archive can be read.
+The next games are written in a new block.
+*/
+bool ReplayArchiveWriter::flush() {
+	return this->isOpen && this->writeBlock() && this->writeIndex();
+}
+
+/*
+This function writes the games that are kept in memory and the index, and closes the archive.
+*/
+bool ReplayArchiveWriter::close() {
+	if (!this->isOpen) {
+		return true;
+	}
+
+	bool isWritten = this->flush();
+
+	this->file.close();
+	this->isOpen = false;
+
+	return isWritten;
+}
+
+/*
+This function returns the amount of games in the archive (with the games that are kept in memory).
+*/
+long long ReplayArchiveWriter::getGamesAmount() const {
+	return (long long)(this->index.size() + this->pendingScores.size());
+}
+
+/*
+This function returns the amount of blocks that were written since the archive was opened.
+*/
+long long ReplayArchiveWriter::getBlocksWritten() const {
+	return this->blocksWritten;
+}
+
+/*
+This function opens an archive for reading and loads its index, and returns false if it cannot be opened or it is not a replay archive.
+*/
+bool ReplayArchiveReader::open(const string& fileName) {
+	FileHeader header;
+
+	this->close();
+	this->file.open(fileName, ios::binary);
+
+	if (!this->file.read((char *)&header, sizeof(header)) || header.magic != FILE_MAGIC || header.version != VERSION) {
+		this->close();
+		return false;
+	}
+
+	this->file.seekg(0, ios::end);
+
+	if (!this->loadIndex((long long)this->file.tellg())) {
+		this->rebuildIndex();
+	}
+
+	this->rewind();
+
+	return true;
+}
+
+/*
+This function closes the archive.
+*/
+void ReplayArchiveReader::close() {
+	this->file.close();
+	this->file.clear();
+	this->index.clear();
+	this->blocksEnd = 0;
+	this->rewind();
+}
+
+/*
+This function reads the index from the end of the file, and returns false if the footer or the index is missing or damaged.
+*/
+bool ReplayArchiveReader::loadIndex(long long fileSize) {
+	Footer footer;
+	IndexHeader header;
+	vector<unsigned char> stream;
+	size_t position = 0;
+	long long offset = 0;
+
+	if (fileSize < (long long)(sizeof(FileHeader) + sizeof(IndexHeader) + sizeof(Footer))) {
+		return false;
+	}
+
+	this->file.seekg(fileSize - sizeof(footer));
+
+	if (!this->file.read((char *)&footer, sizeof(footer)) || footer.magic != FOOTER_MAGIC || footer.checksum != getChecksum(&footer, offsetof(Footer, checksum))
+		|| footer.indexOffset < (long long)sizeof(FileHeader) || footer.indexOffset > fileSize - (long long)(sizeof(header) + sizeof(footer))) {
+		return false;
+	}
+
+	this->file.seekg(footer.indexOffset);
+
+	if (!this->file.read((char *)&header, sizeof(header)) || header.magic != INDEX_MAGIC || header.version != VERSION || header.gamesAmount < 0
+		|| header.encodedSize > fileSize - footer.indexOffset - sizeof(header)) {
+		return false;
+	}
+
+	this->encoded.resize(header.encodedSize);
+
+	if (!this->file.read((char *)this->encoded.data(), header.encodedSize)
+		|| header.checksum != getChecksum(this->encoded.data(), header.encodedSize, getChecksum(&header, offsetof(IndexHeader, checksum)))
+		|| !ReplayArchive::decodeStream(this->encoded.data(), header.encodedSize, header.size, stream)) {
+		return false;
+	}
+
+	this->index.clear();
+
+	while (position < stream.size()) {
+		unsigned long long distance;
+		unsigned long long gamesAmount;
+
+		if (!readVarint(stream.data(), stream.size(), position, distance) || !readVarint(stream.data(), stream.size(), position, gamesAmount)
+			|| gamesAmount == 0 || gamesAmount > ReplayArchive::MAX_GAMES_PER_BLOCK) {
+			this->index.clear();
+			return false;
+		}
+
+		offset += (long long)distance;
+
+		for (unsigned int i = 0; i < (unsigned int)gamesAmount; i++) {
+			long long score;
+
+			if (!readSignedVarint(stream.data(), stream.size(), position, score)) {
+				this->index.clear();
+				return false;
+			}
+
+			this->index.push_back({offset, i, (int)score});
+		}
+	}
+
+	if ((long long)this->index.size() != header.gamesAmount) {
+		this->index.clear();
+		return false;
+	}
+
+	this->blocksEnd = footer.indexOffset;
+
+	return true;
+}
+
+/*
+This function rebuilds the index by reading the blocks from the beginning of the file, until the first block that is missing or damaged.
+*/
+bool ReplayArchiveReader::rebuildIndex() {
+	long long offset = sizeof(FileHeader);
+	Replay replay;
+
+	this->index.clear();
+
+	while (this->readBlock(offset)) {
+		for (unsigned int i = 0; i < this->gamesInBlock; i++) {
+			if (!this->decodeGame(replay)) {
+				this->blocksEnd = offset;
+				return false;
+			}
+
+			this->index.push_back({offset, i, replay.score});
+		}
+
+		offset = this->nextBlockOffset;
+	}
+
+	this->blocksEnd = offset;
+
+	return true;
+}
+
+/*
+This function reads and decodes the block at the given position, and returns false if it is missing or damaged.
+*/
+bool ReplayArchiveReader::readBlock(long long offset) {
+	BlockHeader header;
+	size_t dataSize = 0;
+	size_t position = 0;
+
+	this->blockOffset = -1;
+	this->file.clear();
+	this->file.seekg(offset);
+
+	if (!this->file.read((char *)&header, sizeof(header)) || header.magic != BLOCK_MAGIC || header.checksum != getChecksum(&header, offsetof(BlockHeader, checksum))
+		|| header.gamesAmount == 0 || header.gamesAmount > ReplayArchive::MAX_GAMES_PER_BLOCK) {
+		return false;
+	}
+
+	for (int i = 0; i < ReplayArchive::STREAMS_AMOUNT; i++) {
+		dataSize += header.encodedSizes[i];
+	}
+
+	this->encoded.resize(dataSize);
+
+	if (!this->file.read((char *)this->encoded.data(), dataSize) || header.dataChecksum != getChecksum(this->encoded.data(), dataSize)) {
+		return false;
+	}
+
+	for (int i = 0; i < ReplayArchive::STREAMS_AMOUNT; i++) {
+		if (!ReplayArchive::decodeStream(this->encoded.data() + position, header.encodedSizes[i], header.sizes[i], this->streams[i])) {
+			return false;
+		}
+
+		position += header.encodedSizes[i];
+		this->positions[i] = 0;
+	}
+
+	this->blockOffset = offset;
+	this->nextBlockOffset = offset + sizeof(header) + dataSize;
+	this->gamesInBlock = header.gamesAmount;
+	this->nextGameInBlock = 0;
+
+	return true;
+}
+
+/*
+This function decodes the next game of the current block, and returns false if the block does not hold it.
+*/
+bool ReplayArchiveReader::decodeGame(Replay& replay) {
+	const vector<unsigned char>& details = this->streams[ReplayArchive::DETAILS_STREAM];
+	const vector<unsigned char>& tokens = this->streams[ReplayArchive::TOKENS_STREAM];
+	const vector<unsigned char>& gaps = this->streams[ReplayArchive::GAPS_STREAM];
+	size_t& tokensPosition = this->positions[ReplayArchive::TOKENS_STREAM];
+	size_t& detailsPosition = this->positions[ReplayArchive::DETAILS_STREAM];
+	unsigned long long speed, blocksDropped, steps, entriesAmount;
+	long long score;
+
+	if (this->nextGameInBlock >= this->gamesInBlock || details.size() - detailsPosition < 4) {
+		return false;
+	}
+
+	replay.seed = 0;
+
+	for (int i = 0; i < 4; i++) {
+		replay.seed |= (unsigned int)details[detailsPosition++] << (8 * i);
+	}
+
+	if (!readVarint(details.data(), details.size(), detailsPosition, speed) || !readSignedVarint(details.data(), details.size(), detailsPosition, score)
+		|| !readVarint(details.data(), details.size(), detailsPosition, blocksDropped) || !readVarint(details.data(), details.size(), detailsPosition, steps)
+		|| !readVarint(details.data(), details.size(), detailsPosition, entriesAmount) || entriesAmount > tokens.size() - tokensPosition) {
+		return false;
+	}
+
+	replay.speed = (int)speed;
+	replay.score = (int)score;
+	replay.blocksDropped = (int)blocksDropped;
+	replay.steps = (long long)steps;
+	replay.entries.resize((size_t)entriesAmount);
+	replay.pendingGap = 0;
+
+	for (ReplayEntry& entry : replay.entries) {
+		unsigned char token = tokens[tokensPosition++];
+
+		entry.action = (unsigned char)(token / ReplayArchive::GAP_TOKENS + 1);
+		entry.gap = token % ReplayArchive::GAP_TOKENS;
+
+		if (entry.action > Game::JOKER_PAUSE) {
+			return false;
+		}
+
+		if (entry.gap == ReplayArchive::GAP_TOKENS - 1) {
+			unsigned long long rest;
+
+			if (!readVarint(gaps.data(), gaps.size(), this->positions[ReplayArchive::GAPS_STREAM], rest)) {
+				return false;
+			}
+
+			entry.gap += (unsigned int)rest;
+		}
+	}
+
+	this->nextGameInBlock++;
+
+	return true;
+}
+
+/*
+This function reads the next game of the archive, and returns false when there are no more games (or the next block is damaged).
+*/
+bool ReplayArchiveReader::readNext(Replay& replay) {
+	if (this->blockOffset < 0 || this->nextGameInBlock >= this->gamesInBlock) {
+		if (this->nextBlockOffset >= this->blocksEnd || !this->readBlock(this->nextBlockOffset)) {
+			return false;
+		}
+	}
+
+	return this->decodeGame(replay);
+}
+
+/*
+This function reads the game with the given position in the index (the next call to readNext reads the game after it).
+The block is only read again if the game is not after the current game of the current block.
+*/
+bool ReplayArchiveReader::readGame(long long game, Replay& replay) {
+	if (game < 0 || game >= (long long)this->index.size()) {
+		return false;
+	}
+
+	const ReplayArchiveEntry& entry = this->index[(size_t)game];
+
+	if (this->blockOffset != entry.blockOffset || this->nextGameInBlock > entry.gameInBlock) {
+		if (!this->readBlock(entry.blockOffset)) {
+			return false;
+		}
+	}
+
+	while (this->nextGameInBlock < entry.gameInBlock) {
+		if (!this->decodeGame(replay)) {
+			return false;
+		}
+	}
+
+	return this->decodeGame(replay);
+}
+
+/*
+This function makes the next call to readNext read the first game of the archive.
+*/
+void ReplayArchiveReader::rewind() {
+	this->blockOffset = -1;
+	this->nextBlockOffset = sizeof(FileHeader);
+	this->gamesInBlock = 0;
+	this->nextGameInBlock = 0;
+}
+
+/*
+This function returns the amount of games in the archive.
+*/
+long long ReplayArchiveReader::getGamesAmount() const {
+	return (long long)this->index.size();
+}
+
+/*
+This function returns the position after the last block of the archive (where its index starts).
+*/
+long long ReplayArchiveReader::getBlocksEnd() const {
+	return this->blocksEnd;
+}
+
+/*
+This function returns the index of the archive.
+*/
+const vector<ReplayArchiveEntry>& ReplayArchiveReader::getIndex() const {
+	return this->index;
+}
+
+/*
+This function returns the size of the streams of the blocks that were written since the archive was opened, before they were compressed.
+*/
+long long ReplayArchiveWriter::getStreamsSize() const {
+	return this->streamsSize;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef __REPLAY_ARCHIVE_H
+#define __REPLAY_ARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+using namespace std;
+
+#include "replay.h"
+
+/*
+The entry of a game in the index of a replay archive.
+*/
+struct ReplayArchiveEntry {
+	long long blockOffset; //The position of the game's block in the file.
+	unsigned int gameInBlock; //The position of the game in its block.
+	int score; //The game's score (so the best games can be found without decoding them).
+};
+
+/*
+The format of a replay archive, which stores many recorded games (see Replay) in a single file.
+
+The file starts with a header, then the games are stored in blocks, and the file ends with the index of the games and a footer (which holds the position of the index).
+A block holds the games that were added until its streams reached BLOCK_SIZE bytes, in three streams:
+	the details of each game (its seed, speed, result and amount of entries),
+	a token for each entry that combines its action with its gap (the gaps of GAP_TOKENS - 1 steps or more share a token),
+	and the rest of each of these long gaps as varints.
+Each stream is compressed on its own with rANS (an entropy coder) with the frequencies of its bytes in the block, which are saved before the stream.
+Most entries are a single token, and a common token takes a few bits.
+The index holds the position and the amount of games of each block and the score of each game, as varints that are compressed the same way,
+and it is loaded into memory as an entry for each game.
+
+A block has a checksum, so a block that was cut or damaged is detected. If the footer is missing (the archive was not closed), the index is
+rebuilt by scanning the blocks, and the games after the first bad block are lost.
+*/
+class ReplayArchive {
+public:
+	constexpr static int BLOCK_SIZE = 1 << 16; //The size of the streams of a block (before they are compressed) at which the block is written.
+	constexpr static int MAX_GAMES_PER_BLOCK = 4096; //Reading a game by its position decodes the games before it in its block, so a block of tiny games is written earlier.
+	constexpr static int GAP_TOKENS = 51; //The amount of tokens of each action (Game::JOKER_PAUSE actions times GAP_TOKENS must fit in a byte).
+	constexpr static int STREAMS_AMOUNT = 3;
+	enum eStream {DETAILS_STREAM, TOKENS_STREAM, GAPS_STREAM};
+
+	static_assert(Game::JOKER_PAUSE * GAP_TOKENS <= 256, "The tokens of the replays must fit in a byte.");
+
+	static void encodeStream(const vector<unsigned char>& data, vector<unsigned char>& encoded);
+	static bool decodeStream(const unsigned char *encoded, size_t encodedSize, size_t size, vector<unsigned char>& data);
+};
+
+/*
+Writes games to a replay archive. The games are kept in memory until their block is full, and the index is written when the archive is closed.
+Opening an existing archive adds the games after its games (the new blocks are written over the old index).
+*/
+class ReplayArchiveWriter {
+private:
+	fstream file;
+	bool isOpen = false;
+	long long blocksEnd = 0; //This property saves the position after the last block (where the next block is written).
+	long long fileSize = 0;
+	vector<ReplayArchiveEntry> index;
+	vector<unsigned char> streams[ReplayArchive::STREAMS_AMOUNT]; //The streams of the games that were not written yet.
+	vector<int> pendingScores;
+	long long blocksWritten = 0;
+	long long streamsSize = 0; //This property saves the size of the streams of the blocks that were written, before they were compressed.
+
+	bool writeBlock();
+	bool writeIndex();
+
+	ReplayArchiveWriter(const ReplayArchiveWriter& other) = delete;
+
+public:
+	ReplayArchiveWriter() = default;
+	~ReplayArchiveWriter();
+
+	bool open(const string& fileName);
+	bool append(const Replay& replay);
+	bool flush();
+	bool close();
+
+	long long getGamesAmount() const;
+	long long getBlocksWritten() const;
+	long long getStreamsSize() const;
+};
+
+/*
+Reads the games of a replay archive, in order (a block is decoded once for all of its games) or by their position in the index.
+*/
+class ReplayArchiveReader {
+private:
+	ifstream file;
+	long long blocksEnd = 0;
+	vector<ReplayArchiveEntry> index;
+	vector<unsigned char> encoded; //This property saves the data of the last block that was read.
+	vector<unsigned char> streams[ReplayArchive::STREAMS_AMOUNT]; //This property saves the decoded streams of the current block.
+	size_t positions[ReplayArchive::STREAMS_AMOUNT] = {}; //This property saves the position of the next game in each of the streams.
+	long long blockOffset = -1; //This property saves the position of the current block (or -1 before the first block is read).
+	long long nextBlockOffset = 0;
+	unsigned int gamesInBlock = 0;
+	unsigned int nextGameInBlock = 0;
+
+	bool loadIndex(long long fileSize);
+	bool rebuildIndex();
+	bool readBlock(long long offset);
+	bool decodeGame(Replay& replay);
+
+	ReplayArchiveReader(const ReplayArchiveReader& other) = delete;
+
+public:
+	ReplayArchiveReader() = default;
+
+	bool open(const string& fileName);
+	void close();
+
+	bool readNext(Replay& replay);
+	bool readGame(long long game, Replay& replay);
+	void rewind();
+
+	long long getGamesAmount() const;
+	long long getBlocksEnd() const;
+	const vector<ReplayArchiveEntry>& getIndex() const;
+};
+
+#endif
\ No newline at end of file
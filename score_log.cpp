@@ -0,0 +1,582 @@
+#include "score_log.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+constexpr unsigned int RECORD_MAGIC = 0x53435231; //"SCR1"
+constexpr unsigned int INDEX_MAGIC = 0x53434958; //"SCIX"
+constexpr unsigned int INDEX_VERSION = 1;
+constexpr int INDEX_COPY_BATCH = 4096; //The amount of index entries copied at once when the index is written again.
+
+/*
+A record as it is saved in the log. It is written from zeroed memory, so the padding bytes are part of the checksum as well.
+*/
+struct StoredRecord {
+	unsigned int magic;
+	unsigned int checksum; //The checksum of the record.
+	ScoreRecord record;
+};
+
+/*
+The header of the index file, followed by indexEntriesAmount entries.
+*/
+struct IndexHeader {
+	unsigned int magic;
+	unsigned int version;
+	long long indexedSlots;
+	long long entriesAmount;
+	long long logSize; //The size of the log when the index was written (if the log is smaller now, it was damaged and the index is rebuilt).
+	unsigned int checksum; //The checksum of the fields above.
+	unsigned int reserved;
+};
+
+constexpr long long RECORD_SIZE = sizeof(StoredRecord);
+
+/*
+This function writes the data of the given file that the system still holds in its buffers to the disk, and returns whether it succeeded.
+*/
+static bool syncFile(const string& fileName) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	bool isSynced = (FlushFileBuffers(file) != 0);
+	CloseHandle(file);
+#else
+	int file = ::open(fileName.c_str(), O_WRONLY);
+	if (file == -1) {
+		return false;
+	}
+
+	bool isSynced = (fsync(file) == 0);
+	::close(file);
+#endif
+
+	return isSynced;
+}
+
+/*
+This function replaces the given file with the new file, and returns whether it succeeded.
+*/
+static bool replaceFile(const string& newFileName, const string& fileName) {
+#ifdef _WIN32
+	return MoveFileExA(newFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0; //rename does not replace an existing file on Windows.
+#else
+	return rename(newFileName.c_str(), fileName.c_str()) == 0; //rename replaces the old file atomically.
+#endif
+}
+
+/*
+Destructor - saves the records that were added since the index was written.
+*/
+ScoreLog::~ScoreLog() {
+	this->close();
+}
+
+/*
+This function opens the log and its index (both are created if they do not exist) and loads the best scores.
+It returns false if the log cannot be opened.
+*/
+bool ScoreLog::open(const string& logFileName, const string& indexFileName) {
+	this->close();
+
+	this->logFileName = logFileName;
+	this->indexFileName = indexFileName;
+
+	//Creating the log if it does not exist, and finding its size.
+	{
+		ofstream create(logFileName, ios::binary | ios::app);
+		if (!create.is_open()) {
+			return false;
+		}
+	}
+
+	this->logReader.open(logFileName, ios::binary);
+	this->logReader.seekg(0, ios::end);
+	this->logSize = (long long)this->logReader.tellg();
+	this->logSlots = (this->logSize + RECORD_SIZE - 1) / RECORD_SIZE; //A record that was cut still takes a slot, so the next records stay aligned.
+	this->isOpen = true;
+
+	this->topHeap.clear();
+	this->pendingEntries.clear();
+
+	if (!this->loadIndex()) {
+		return this->rebuildIndex();
+	}
+
+	//The best scores are the first entries of the index and the records that were added after it.
+	for (long long i = 0; i < min((long long)TOP_AMOUNT, this->indexEntriesAmount); i++) {
+		IndexEntry entry;
+		ScoreRecord record;
+
+		if (this->readIndexEntry(i, entry) && this->readRecord(entry.recordIndex, record)) {
+			this->offerToTop(entry, record);
+		}
+	}
+
+	this->scanLog(this->indexedSlots, this->pendingEntries);
+	sort(this->pendingEntries.begin(), this->pendingEntries.end(), ScoreLog::isBetter);
+
+	return true;
+}
+
+/*
+This function writes the index (if records were added since it was written) and closes the files.
+*/
+void ScoreLog::close() {
+	if (this->isOpen && !this->pendingEntries.empty()) {
+		this->saveIndex();
+	}
+
+	this->indexReader.close();
+	this->logReader.close();
+	this->isOpen = false;
+}
+
+/*
+This function reads the header of the index file and returns whether the index matches the log.
+*/
+bool ScoreLog::loadIndex() {
+	IndexHeader header;
+
+	this->indexReader.close();
+	this->indexReader.clear();
+	this->indexReader.open(this->indexFileName, ios::binary);
+
+	if (!this->indexReader.is_open() || !this->indexReader.read((char *)&header, sizeof(header))) {
+		return false;
+	}
+
+	this->indexReader.seekg(0, ios::end);
+	long long indexSize = (long long)this->indexReader.tellg();
+
+	if (header.magic != INDEX_MAGIC || header.version != INDEX_VERSION || header.checksum != ScoreLog::getChecksum(&header, offsetof(IndexHeader, checksum)) ||
+		header.indexedSlots > this->logSlots || header.logSize > this->logSize || indexSize != (long long)sizeof(IndexHeader) + header.entriesAmount * (long long)sizeof(IndexEntry)) {
+		return false;
+	}
+
+	this->indexedSlots = header.indexedSlots;
+	this->indexEntriesAmount = header.entriesAmount;
+
+	return true;
+}
+
+/*
+This function builds the index from a scan of the whole log (when the index is missing or does not match the log).
+*/
+bool ScoreLog::rebuildIndex() {
+	vector<IndexEntry> entries;
+
+	this->indexReader.close();
+	this->indexEntriesAmount = 0;
+	this->indexedSlots = 0;
+	this->topHeap.clear();
+	this->pendingEntries.clear();
+
+	this->scanLog(0, entries);
+	sort(entries.begin(), entries.end(), ScoreLog::isBetter);
+
+	if (!this->writeIndex(entries)) { //The log can still be used, and the records are kept in memory until the index can be written.
+		this->pendingEntries = entries;
+	}
+
+	return true;
+}
+
+/*
+This function reads the valid records of the log from the given slot to its end, adds their entries to the given vector and offers them to the best scores.
+*/
+void ScoreLog::scanLog(long long firstSlot, vector<IndexEntry>& entries) {
+	for (long long slot = firstSlot; slot < this->logSlots; slot++) {
+		ScoreRecord record;
+
+		if (this->readRecord((unsigned int)slot, record)) {
+			IndexEntry entry = {record.score, (unsigned int)slot};
+
+			entries.push_back(entry);
+			this->offerToTop(entry, record);
+		}
+	}
+}
+
+/*
+This function writes a new index file that holds the entries of the current index and the given entries (sorted), and covers the whole log.
+The new index is written to a temporary file that replaces the old one, so a crash leaves either the old index or the new one
+(or no index, which is rebuilt from the log).
+*/
+bool ScoreLog::writeIndex(const vector<IndexEntry>& newEntries) {
+	string tempFileName = this->indexFileName + ".tmp";
+	ofstream outFile(tempFileName, ios::binary | ios::trunc);
+	IndexHeader header;
+
+	if (!outFile.is_open()) {
+		return false;
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.magic = INDEX_MAGIC;
+	header.version = INDEX_VERSION;
+	header.indexedSlots = this->logSlots;
+	header.entriesAmount = this->indexEntriesAmount + (long long)newEntries.size();
+	header.logSize = this->logSize;
+	header.checksum = ScoreLog::getChecksum(&header, offsetof(IndexHeader, checksum));
+	outFile.write((const char *)&header, sizeof(header));
+
+	//Merging the entries of the current index (read in batches) with the new entries.
+	vector<IndexEntry> batch(INDEX_COPY_BATCH);
+	size_t newIndex = 0;
+	long long position = 0;
+
+	while (position < this->indexEntriesAmount) {
+		int batchSize = (int)min((long long)INDEX_COPY_BATCH, this->indexEntriesAmount - position);
+
+		this->indexReader.clear();
+		this->indexReader.seekg(sizeof(IndexHeader) + position * sizeof(IndexEntry));
+		if (!this->indexReader.read((char *)batch.data(), batchSize * sizeof(IndexEntry))) {
+			return false;
+		}
+
+		for (int i = 0; i < batchSize; i++) {
+			while (newIndex < newEntries.size() && ScoreLog::isBetter(newEntries[newIndex], batch[i])) {
+				outFile.write((const char *)&newEntries[newIndex++], sizeof(IndexEntry));
+			}
+
+			outFile.write((const char *)&batch[i], sizeof(IndexEntry));
+		}
+
+		position += batchSize;
+	}
+
+	for (; newIndex < newEntries.size(); newIndex++) {
+		outFile.write((const char *)&newEntries[newIndex], sizeof(IndexEntry));
+	}
+
+	outFile.close();
+	if (outFile.fail() || !syncFile(tempFileName)) { //The new index must be on the disk before it replaces the old one.
+		return false;
+	}
+
+	this->indexReader.close(); //A file that is open cannot be replaced on Windows.
+
+	if (!replaceFile(tempFileName, this->indexFileName)) {
+		return false;
+	}
+
+	return this->loadIndex();
+}
+
+/*
+This function adds a finished game to the log and to the best scores, and returns whether it was saved.
+*/
+bool ScoreLog::append(const ScoreRecord& record) {
+	return this->append(&record, 1);
+}
+
+/*
+This function adds the given amount of finished games to the log and to the best scores, and returns whether they were saved.
+*/
+bool ScoreLog::append(const ScoreRecord *records, int amount) {
+	if (!this->isOpen || amount <= 0) {
+		return false;
+	}
+
+	ofstream outFile(this->logFileName, ios::binary | ios::app);
+	if (!outFile.is_open()) {
+		return false;
+	}
+
+	//If the last record was cut, the new records start at the next slot.
+	long long padding = this->logSlots * RECORD_SIZE - this->logSize;
+	if (padding > 0) {
+		outFile.write(string((size_t)padding, '\0').data(), padding);
+	}
+
+	for (int i = 0; i < amount; i++) {
+		StoredRecord stored;
+
+		memset(&stored, 0, sizeof(stored));
+		stored.magic = RECORD_MAGIC;
+		stored.record.score = records[i].score;
+		stored.record.blocksDropped = records[i].blocksDropped;
+		stored.record.durationSeconds = records[i].durationSeconds;
+		stored.record.seed = records[i].seed;
+		stored.record.speed = records[i].speed;
+		stored.record.finishedAt = records[i].finishedAt;
+		stored.checksum = ScoreLog::getChecksum(&stored.record, sizeof(stored.record));
+
+		outFile.write((const char *)&stored, sizeof(stored));
+	}
+
+	outFile.close();
+
+	if (outFile.fail()) {
+		return false;
+	}
+
+	//The stream buffers the records, so they reach the file together, and a crash can cut any of them (the checksums find it).
+	//The records are counted even if they could not be synced to the disk, since they were written to the file.
+	bool isSynced = syncFile(this->logFileName);
+
+	//Adding the new entries to the sorted pending entries.
+	size_t oldPendingAmount = this->pendingEntries.size();
+
+	for (int i = 0; i < amount; i++) {
+		IndexEntry entry = {records[i].score, (unsigned int)(this->logSlots + i)};
+
+		this->pendingEntries.push_back(entry);
+		this->offerToTop(entry, records[i]);
+	}
+
+	sort(this->pendingEntries.begin() + oldPendingAmount, this->pendingEntries.end(), ScoreLog::isBetter);
+	inplace_merge(this->pendingEntries.begin(), this->pendingEntries.begin() + oldPendingAmount, this->pendingEntries.end(), ScoreLog::isBetter);
+
+	this->logSlots += amount;
+	this->logSize = this->logSlots * RECORD_SIZE;
+
+	//The index is written again when the pending entries are a part of it, so writing it costs O(1) per record over time.
+	if ((long long)this->pendingEntries.size() >= max((long long)MIN_PENDING_ENTRIES, this->indexEntriesAmount / PENDING_ENTRIES_RATIO)) {
+		this->saveIndex();
+	}
+
+	return isSynced;
+}
+
+/*
+This function writes the entries of the records that were added since the index was written into the index.
+*/
+bool ScoreLog::saveIndex() {
+	if (!this->isOpen || !this->writeIndex(this->pendingEntries)) {
+		return false;
+	}
+
+	this->pendingEntries.clear();
+
+	return true;
+}
+
+/*
+This function adds a record to the best scores if it is better than the worst of them (or there are less than TOP_AMOUNT of them).
+*/
+void ScoreLog::offerToTop(const IndexEntry& entry, const ScoreRecord& record) {
+	TopEntry topEntry = {entry, record};
+
+	if ((int)this->topHeap.size() < TOP_AMOUNT) {
+		this->topHeap.push_back(topEntry);
+		push_heap(this->topHeap.begin(), this->topHeap.end(), ScoreLog::isTopEntryBetter);
+	}
+	else if (ScoreLog::isBetter(entry, this->topHeap.front().entry)) {
+		pop_heap(this->topHeap.begin(), this->topHeap.end(), ScoreLog::isTopEntryBetter);
+		this->topHeap.back() = topEntry;
+		push_heap(this->topHeap.begin(), this->topHeap.end(), ScoreLog::isTopEntryBetter);
+	}
+}
+
+/*
+This function returns the best scores, from the best.
+*/
+void ScoreLog::getTop(vector<ScoreRecord>& records) const {
+	vector<TopEntry> sorted = this->topHeap;
+
+	sort(sorted.begin(), sorted.end(), ScoreLog::isTopEntryBetter);
+
+	records.clear();
+	for (size_t i = 0; i < sorted.size(); i++) {
+		records.push_back(sorted[i].record);
+	}
+}
+
+/*
+This function puts the best score in the output parameter and returns whether there is any score.
+*/
+bool ScoreLog::getBestScore(int& score) const {
+	if (this->topHeap.empty()) {
+		return false;
+	}
+
+	score = this->topHeap.front().entry.score;
+
+	for (size_t i = 1; i < this->topHeap.size(); i++) {
+		score = max(score, this->topHeap[i].entry.score);
+	}
+
+	return true;
+}
+
+/*
+This function returns the place (starting from 1) a game with the given score would take in the leaderboard.
+*/
+long long ScoreLog::getRank(int score) const {
+	IndexEntry entry = {score, 0}; //Before every record with the same score.
+	long long better = this->countBetterInIndex(entry);
+
+	better += lower_bound(this->pendingEntries.begin(), this->pendingEntries.end(), entry, ScoreLog::isBetter) - this->pendingEntries.begin();
+
+	return better + 1;
+}
+
+/*
+This function returns the amount of entries of the index file that are better than the given entry (a binary search in the file).
+*/
+long long ScoreLog::countBetterInIndex(const IndexEntry& entry) const {
+	long long low = 0;
+	long long high = this->indexEntriesAmount;
+
+	while (low < high) {
+		long long middle = (low + high) / 2;
+		IndexEntry middleEntry;
+
+		if (!this->readIndexEntry(middle, middleEntry)) {
+			break;
+		}
+
+		if (ScoreLog::isBetter(middleEntry, entry)) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+/*
+This function puts the records at the given places of the leaderboard (starting from 0) in the output parameter.
+The leaderboard is the merge of the index file and the entries that were added after it: the amount of entries taken from each of them
+before the first place is found with a binary search, and then the two are merged for the requested amount of places.
+*/
+bool ScoreLog::getLeaderboard(long long first, int amount, vector<ScoreRecord>& records) const {
+	long long pendingAmount = (long long)this->pendingEntries.size();
+	long long low = max(0LL, first - this->indexEntriesAmount);
+	long long high = min(first, pendingAmount);
+	long long fromPending = low;
+
+	records.clear();
+
+	if (first < 0 || first >= this->indexEntriesAmount + pendingAmount) {
+		return false;
+	}
+
+	while (low <= high) {
+		fromPending = (low + high) / 2;
+		long long fromIndex = first - fromPending;
+		IndexEntry indexEntry;
+
+		if (fromPending < pendingAmount && fromIndex > 0 && this->readIndexEntry(fromIndex - 1, indexEntry) &&
+			ScoreLog::isBetter(this->pendingEntries[(size_t)fromPending], indexEntry)) {
+			low = fromPending + 1; //The next pending entry comes before the places that were taken from the index.
+		}
+		else if (fromPending > 0 && fromIndex < this->indexEntriesAmount && this->readIndexEntry(fromIndex, indexEntry) &&
+			ScoreLog::isBetter(indexEntry, this->pendingEntries[(size_t)fromPending - 1])) {
+			high = fromPending - 1; //The next index entry comes before the places that were taken from the pending entries.
+		}
+		else {
+			break;
+		}
+	}
+
+	long long fromIndex = first - fromPending;
+	IndexEntry indexEntry;
+	bool hasIndexEntry = (fromIndex < this->indexEntriesAmount) && this->readIndexEntry(fromIndex, indexEntry);
+
+	while ((int)records.size() < amount && (hasIndexEntry || fromPending < pendingAmount)) {
+		IndexEntry entry;
+
+		if (hasIndexEntry && (fromPending == pendingAmount || ScoreLog::isBetter(indexEntry, this->pendingEntries[(size_t)fromPending]))) {
+			entry = indexEntry;
+			fromIndex++;
+			hasIndexEntry = (fromIndex < this->indexEntriesAmount) && this->readIndexEntry(fromIndex, indexEntry);
+		}
+		else {
+			entry = this->pendingEntries[(size_t)fromPending++];
+		}
+
+		ScoreRecord record;
+		if (!this->readRecord(entry.recordIndex, record)) {
+			return false;
+		}
+
+		records.push_back(record);
+	}
+
+	return true;
+}
+
+/*
+This function returns the amount of valid records in the log.
+*/
+long long ScoreLog::getRecordsAmount() const {
+	return this->indexEntriesAmount + (long long)this->pendingEntries.size();
+}
+
+/*
+This function reads the entry at the given place of the index file.
+*/
+bool ScoreLog::readIndexEntry(long long position, IndexEntry& entry) const {
+	this->indexReader.clear();
+	this->indexReader.seekg(sizeof(IndexHeader) + position * sizeof(IndexEntry));
+
+	return (bool)this->indexReader.read((char *)&entry, sizeof(entry));
+}
+
+/*
+This function reads the record at the given slot of the log and returns whether it is valid (whole and with a matching checksum).
+*/
+bool ScoreLog::readRecord(unsigned int recordIndex, ScoreRecord& record) const {
+	StoredRecord stored;
+
+	this->logReader.clear();
+	this->logReader.seekg(recordIndex * RECORD_SIZE);
+
+	if (!this->logReader.read((char *)&stored, sizeof(stored)) || stored.magic != RECORD_MAGIC ||
+		stored.checksum != ScoreLog::getChecksum(&stored.record, sizeof(stored.record))) {
+		return false;
+	}
+
+	record = stored.record;
+
+	return true;
+}
+
+/*
+This function returns whether the first entry comes before the second one in the leaderboard:
+a higher score comes first, and of two equal scores the earlier game comes first.
+*/
+bool ScoreLog::isBetter(const IndexEntry& a, const IndexEntry& b) {
+	if (a.score != b.score) {
+		return a.score > b.score;
+	}
+
+	return a.recordIndex < b.recordIndex;
+}
+
+/*
+This function compares the entries of the best scores heap (the heap keeps the worst of them first).
+*/
+bool ScoreLog::isTopEntryBetter(const TopEntry& a, const TopEntry& b) {
+	return ScoreLog::isBetter(a.entry, b.entry);
+}
+
+/*
+This function returns the FNV-1a checksum of the given bytes.
+*/
+unsigned int ScoreLog::getChecksum(const void *data, size_t size) {
+	const unsigned char *bytes = (const unsigned char *)data;
+	unsigned int checksum = 2166136261u;
+
+	for (size_t i = 0; i < size; i++) {
+		checksum = (checksum ^ bytes[i]) * 16777619u;
+	}
+
+	return checksum;
+}
\ No newline at end of file
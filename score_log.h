@@ -0,0 +1,94 @@
+#ifndef __SCORE_LOG_H
+#define __SCORE_LOG_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+using namespace std;
+
+/*
+A finished game, as it is saved in the score log.
+*/
+struct ScoreRecord {
+	int score;
+	int blocksDropped;
+	unsigned int durationSeconds; //The time the game was played (without the time it was paused).
+	unsigned int seed; //The seed of the game's blocks.
+	int speed; //The game's speed when it ended (in miliseconds per step).
+	long long finishedAt; //The time the game ended (seconds since 1970).
+};
+
+/*
+The log of the scores of all of the finished games.
+
+The log file is append-only: each game is a fixed-size record with a checksum, and the log is synced to the disk after each append,
+so a record that was cut by a crash is detected and skipped (and the next record starts at the next record boundary).
+The index file holds the position of every record in the log sorted by the score (from the highest), and how many records of the log it covers.
+On startup only the header of the index, its first entries and the records that were added after it was written are read,
+so the log is never scanned in full unless the index is missing or damaged.
+The best scores are kept in memory in a min-heap, and a leaderboard page is read from the index with a binary search.
+*/
+class ScoreLog {
+public:
+	constexpr static int TOP_AMOUNT = 10; //The amount of best scores kept in memory.
+	//The index is written again when the amount of records that were added after it reaches MIN_PENDING_ENTRIES
+	//or 1/PENDING_ENTRIES_RATIO of the index (the larger of them).
+	constexpr static int MIN_PENDING_ENTRIES = 256;
+	constexpr static int PENDING_ENTRIES_RATIO = 8;
+
+	struct IndexEntry {
+		int score;
+		unsigned int recordIndex;
+	};
+
+private:
+	struct TopEntry {
+		IndexEntry entry;
+		ScoreRecord record;
+	};
+
+	string logFileName;
+	string indexFileName;
+	bool isOpen = false;
+
+	long long logSize = 0;
+	long long logSlots = 0; //This property saves the amount of record-sized slots in the log (the last one may be a record that was cut).
+	long long indexedSlots = 0; //This property saves the amount of slots of the log that the index file covers.
+	long long indexEntriesAmount = 0; //This property saves the amount of entries in the index file.
+	vector<IndexEntry> pendingEntries; //The valid records after the indexed slots, sorted like the index.
+	vector<TopEntry> topHeap; //The best TOP_AMOUNT records, as a min-heap (the worst of them is first).
+
+	mutable ifstream indexReader;
+	mutable ifstream logReader;
+
+	bool loadIndex();
+	bool rebuildIndex();
+	void scanLog(long long firstSlot, vector<IndexEntry>& entries);
+	bool writeIndex(const vector<IndexEntry>& newEntries);
+	void offerToTop(const IndexEntry& entry, const ScoreRecord& record);
+	long long countBetterInIndex(const IndexEntry& entry) const;
+	bool readIndexEntry(long long position, IndexEntry& entry) const;
+	bool readRecord(unsigned int recordIndex, ScoreRecord& record) const;
+
+	static bool isBetter(const IndexEntry& a, const IndexEntry& b);
+	static bool isTopEntryBetter(const TopEntry& a, const TopEntry& b);
+	static unsigned int getChecksum(const void *data, size_t size);
+
+public:
+	~ScoreLog();
+
+	bool open(const string& logFileName, const string& indexFileName);
+	void close();
+
+	bool append(const ScoreRecord& record);
+	bool append(const ScoreRecord *records, int amount);
+	bool saveIndex();
+
+	void getTop(vector<ScoreRecord>& records) const;
+	bool getBestScore(int& score) const;
+	long long getRank(int score) const;
+	bool getLeaderboard(long long first, int amount, vector<ScoreRecord>& records) const;
+	long long getRecordsAmount() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "session_pool.h"
+
+#include <algorithm>
+
+/*
+Destructor - stops the workers.
+*/
+SessionPool::~SessionPool() {
+	this->stop();
+}
+
+/*
+This function starts the given amount of worker threads (sessions can be added only after the workers were started).
+*/
+void SessionPool::start(int workersAmount) {
+	for (int i = 0; i < workersAmount; i++) {
+		Worker *worker = new Worker();
+
+		worker->isStopping = false;
+		worker->resumesAmount = 0;
+		worker->stepsAmount = 0;
+		worker->finishedAmount = 0;
+		worker->measuredStepsAmount = 0;
+		worker->totalLateness = chrono::steady_clock::duration::zero();
+		worker->workerThread = thread(&SessionPool::workerLoop, this, worker);
+
+		this->workers.push_back(worker);
+	}
+}
+
+/*
+This function stops the workers (a session that is being resumed is finished first) and removes all of the sessions from the pool.
+*/
+void SessionPool::stop() {
+	for (size_t i = 0; i < this->workers.size(); i++) {
+		Worker *worker = this->workers[i];
+
+		{
+			lock_guard<mutex> lock(worker->workerMutex);
+			worker->isStopping = true;
+		}
+
+		worker->wakeChanged.notify_all();
+		worker->workerThread.join();
+		delete worker;
+	}
+
+	this->workers.clear();
+	this->sessionsAmount = 0;
+}
+
+/*
+This function adds a session to the pool and returns its index in the pool. The session is resumed right away.
+*/
+int SessionPool::add(GameSession& session) {
+	int sessionIndex = this->sessionsAmount++;
+	Worker *worker = this->workers[sessionIndex % this->workers.size()];
+	lock_guard<mutex> lock(worker->workerMutex);
+	SessionSlot slot = {&session, TimePoint(), false, false, false};
+
+	worker->slots.push_back(slot);
+	this->scheduleSlot(worker, (int)worker->slots.size() - 1, chrono::steady_clock::now());
+
+	return sessionIndex;
+}
+
+/*
+This function makes the pool resume the session with the given index right away (called after an action was pushed to it).
+*/
+void SessionPool::wake(int sessionIndex) {
+	Worker *worker = this->workers[sessionIndex % this->workers.size()];
+	int slotIndex = sessionIndex / (int)this->workers.size();
+	lock_guard<mutex> lock(worker->workerMutex);
+	SessionSlot& slot = worker->slots[slotIndex];
+
+	if (slot.isRunning) {
+		slot.isWakeRequested = true;
+	}
+	else if (slot.isScheduled) {
+		this->scheduleSlot(worker, slotIndex, chrono::steady_clock::now());
+	}
+}
+
+/*
+This function puts a session of the given worker in its heap with the given time (the worker's mutex must be locked).
+*/
+void SessionPool::scheduleSlot(Worker *worker, int slotIndex, TimePoint wakeTime) {
+	WakeEntry entry = {wakeTime, slotIndex};
+	bool isFirst = worker->wakeHeap.empty() || wakeTime < worker->wakeHeap.front().wakeTime;
+
+	worker->slots[slotIndex].wakeTime = wakeTime;
+	worker->slots[slotIndex].isScheduled = true;
+	worker->wakeHeap.push_back(entry);
+	push_heap(worker->wakeHeap.begin(), worker->wakeHeap.end(), isLater);
+
+	if (isFirst) { //The worker waits until the first time in its heap, so it should wait for the new time instead.
+		worker->wakeChanged.notify_one();
+	}
+}
+
+/*
+This function runs on each worker thread: it waits until the first session in the worker's heap should be resumed, resumes it and puts it back in the heap.
+*/
+void SessionPool::workerLoop(Worker *worker) {
+	unique_lock<mutex> lock(worker->workerMutex);
+
+	while (!worker->isStopping) {
+		if (worker->wakeHeap.empty()) {
+			worker->wakeChanged.wait(lock);
+			continue;
+		}
+
+		WakeEntry entry = worker->wakeHeap.front();
+		TimePoint now = chrono::steady_clock::now();
+
+		if (entry.wakeTime > now) {
+			worker->wakeChanged.wait_until(lock, entry.wakeTime);
+			continue;
+		}
+
+		pop_heap(worker->wakeHeap.begin(), worker->wakeHeap.end(), isLater);
+		worker->wakeHeap.pop_back();
+
+		if (!worker->slots[entry.slotIndex].isScheduled || worker->slots[entry.slotIndex].wakeTime != entry.wakeTime) { //A newer entry of the session replaced this one.
+			continue;
+		}
+
+		GameSession *session = worker->slots[entry.slotIndex].session;
+
+		worker->slots[entry.slotIndex].isScheduled = false;
+		worker->slots[entry.slotIndex].isRunning = true;
+		lock.unlock(); //Actions can be pushed and sessions can be added while the session is resumed.
+
+		TimePoint stepTime = session->getNextStepTime();
+
+		now = chrono::steady_clock::now();
+		int stepsAmount = session->resume(now);
+
+		lock.lock();
+		SessionSlot& slot = worker->slots[entry.slotIndex]; //The slots may have been moved while the mutex was unlocked.
+
+		slot.isRunning = false;
+		worker->resumesAmount++;
+
+		if (stepsAmount > 0) {
+			worker->stepsAmount += stepsAmount;
+			worker->measuredStepsAmount++; //Only the lateness of the first step is measured (the steps that were caught up after it were due even earlier).
+			worker->totalLateness += now - stepTime;
+		}
+
+		if (session->isFinished()) {
+			worker->finishedAmount++;
+			continue;
+		}
+
+		this->scheduleSlot(worker, entry.slotIndex, slot.isWakeRequested ? now : session->getNextStepTime());
+		slot.isWakeRequested = false;
+	}
+}
+
+/*
+This function returns whether the first entry should be resumed after the second one (the order of the min-heap).
+*/
+bool SessionPool::isLater(const WakeEntry& a, const WakeEntry& b) {
+	return a.wakeTime > b.wakeTime;
+}
+
+/*
+This function returns the amount of times sessions were resumed.
+*/
+long long SessionPool::getResumesAmount() const {
+	long long amount = 0;
+
+	for (size_t i = 0; i < this->workers.size(); i++) {
+		lock_guard<mutex> lock(this->workers[i]->workerMutex);
+		amount += this->workers[i]->resumesAmount;
+	}
+
+	return amount;
+}
+
+/*
+This function returns the amount of game steps that were run.
+*/
+long long SessionPool::getStepsAmount() const {
+	long long amount = 0;
+
+	for (size_t i = 0; i < this->workers.size(); i++) {
+		lock_guard<mutex> lock(this->workers[i]->workerMutex);
+		amount += this->workers[i]->stepsAmount;
+	}
+
+	return amount;
+}
+
+/*
+This function returns the amount of sessions whose game is over.
+*/
+long long SessionPool::getFinishedAmount() const {
+	long long amount = 0;
+
+	for (size_t i = 0; i < this->workers.size(); i++) {
+		lock_guard<mutex> lock(this->workers[i]->workerMutex);
+		amount += this->workers[i]->finishedAmount;
+	}
+
+	return amount;
+}
+
+/*
+This function returns the average delay between the time a session's step was due and the time the session was resumed (in microseconds).
+*/
+double SessionPool::getAverageLateness() const {
+	chrono::steady_clock::duration totalLateness = chrono::steady_clock::duration::zero();
+	long long stepsAmount = 0;
+
+	for (size_t i = 0; i < this->workers.size(); i++) {
+		lock_guard<mutex> lock(this->workers[i]->workerMutex);
+		totalLateness += this->workers[i]->totalLateness;
+		stepsAmount += this->workers[i]->measuredStepsAmount;
+	}
+
+	if (stepsAmount == 0) {
+		return 0;
+	}
+
+	return chrono::duration<double, micro>(totalLateness).count() / stepsAmount;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef __SESSION_POOL_H
+#define __SESSION_POOL_H
+
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+using namespace std;
+
+#include "game_session.h"
+
+/*
+Runs many game sessions on a small amount of worker threads.
+Each worker keeps its sessions in a min-heap by the time they should be resumed (their next step, or right away when an action was pushed to them),
+resumes the first session whose time has come, then puts it back in the heap by its next step. Between these times nothing of a session
+is kept on the worker's stack, so a worker can run any amount of sessions, and a session whose game is over leaves the pool.
+
+Each session always runs on the same worker (the sessions are divided between the workers when they are added),
+because the blocks of a game are allocated from the memory pools of the thread that runs it.
+The sessions are owned by the caller and must stay alive until the pool is stopped.
+*/
+class SessionPool {
+private:
+	typedef chrono::steady_clock::time_point TimePoint;
+
+	struct WakeEntry {
+		TimePoint wakeTime;
+		int slotIndex;
+	};
+
+	struct SessionSlot {
+		GameSession *session;
+		TimePoint wakeTime; //The time of the slot's latest entry in the heap (older entries of the slot are skipped).
+		bool isScheduled;
+		bool isRunning;
+		bool isWakeRequested; //An action was pushed while the session was being resumed, so it is resumed again right away.
+	};
+
+	struct Worker {
+		thread workerThread;
+		mutex workerMutex;
+		condition_variable wakeChanged;
+		bool isStopping;
+		vector<SessionSlot> slots;
+		vector<WakeEntry> wakeHeap; //The times the worker's sessions should be resumed, as a min-heap.
+
+		long long resumesAmount;
+		long long stepsAmount;
+		long long finishedAmount;
+		long long measuredStepsAmount; //The amount of steps whose lateness was measured (the first step of each resume).
+		chrono::steady_clock::duration totalLateness; //The sum of the delays between the times these steps were due and the times they were run.
+	};
+
+	vector<Worker *> workers;
+	int sessionsAmount = 0;
+
+	void workerLoop(Worker *worker);
+	void scheduleSlot(Worker *worker, int slotIndex, TimePoint wakeTime);
+
+	static bool isLater(const WakeEntry& a, const WakeEntry& b);
+
+public:
+	SessionPool() = default;
+	SessionPool(const SessionPool& other) = delete;
+	~SessionPool();
+
+	void start(int workersAmount);
+	void stop();
+
+	int add(GameSession& session);
+	void wake(int sessionIndex);
+
+	long long getResumesAmount() const;
+	long long getStepsAmount() const;
+	long long getFinishedAmount() const;
+	double getAverageLateness() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,613 @@
+#include "spectator_feed.h"
+
+//The parts of the view a delta message holds (the flags are the first byte after the message's header).
+constexpr unsigned char ROWS_CHANGED = 1; //The mask of the changed rows (2 bytes), followed by the new mask of each changed row (2 bytes each).
+constexpr unsigned char BLOCK_MOVED = 2; //The amount of columns and rows the falling block moved by (1 byte each).
+constexpr unsigned char BLOCK_REPLACED = 4; //The kind of the falling block and all of its squares.
+constexpr unsigned char SCORE_CHANGED = 8; //The change of the score (a zigzag varint).
+constexpr unsigned char BLOCKS_DROPPED_CHANGED = 16; //The change of the amount of blocks dropped (a zigzag varint).
+constexpr unsigned char NEXT_BLOCKS_CHANGED = 32; //The upcoming blocks (1 byte each).
+constexpr unsigned char FAILED_CHANGED = 64; //Whether the game is over (1 byte).
+
+/*
+This function adds a byte to the end of the message.
+*/
+static void writeByte(SpectatorMessage& message, unsigned char value) {
+	message.data[message.size++] = value;
+}
+
+/*
+This function adds a number to the end of the message as a varint (7 bits in each byte, the highest bit is set on every byte but the last).
+*/
+static void writeVarint(SpectatorMessage& message, unsigned long long value) {
+	while (value >= 0x80) {
+		writeByte(message, (unsigned char)(value | 0x80));
+		value >>= 7;
+	}
+
+	writeByte(message, (unsigned char)value);
+}
+
+/*
+This function adds a signed number to the end of the message as a zigzag varint (small negative numbers take as few bytes as small positive ones).
+*/
+static void writeSignedVarint(SpectatorMessage& message, long long value) {
+	writeVarint(message, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+/*
+This function adds the header of a message (the size is filled in by finishMessage).
+*/
+static void startMessage(SpectatorMessage& message, SpectatorMessage::eKind kind, long long sequence) {
+	message.sequence = sequence;
+	message.size = SpectatorMessage::HEADER_SIZE;
+	writeByte(message, (unsigned char)kind);
+	writeVarint(message, (unsigned long long)sequence);
+}
+
+/*
+This function writes the size of the message at its beginning.
+*/
+static void finishMessage(SpectatorMessage& message) {
+	message.data[0] = (unsigned char)(message.size & 0xFF);
+	message.data[1] = (unsigned char)(message.size >> 8);
+}
+
+/*
+This function reads a byte of a message and returns false if the message has ended.
+*/
+static bool readByte(const unsigned char *data, int size, int& position, unsigned char& value) {
+	if (position >= size) {
+		return false;
+	}
+
+	value = data[position++];
+
+	return true;
+}
+
+/*
+This function reads a varint of a message and returns false if the message has ended or the varint is too long.
+*/
+static bool readVarint(const unsigned char *data, int size, int& position, unsigned long long& value) {
+	unsigned char byte = 0x80;
+
+	value = 0;
+
+	for (int shift = 0; (byte & 0x80) != 0; shift += 7) {
+		if (shift > 63 || !readByte(data, size, position, byte)) {
+			return false;
+		}
+
+		value |= (unsigned long long)(byte & 0x7F) << shift;
+	}
+
+	return true;
+}
+
+/*
+This function reads a zigzag varint of a message.
+*/
+static bool readSignedVarint(const unsigned char *data, int size, int& position, long long& value) {
+	unsigned long long encoded;
+
+	if (!readVarint(data, size, position, encoded)) {
+		return false;
+	}
+
+	value = (long long)(encoded >> 1) ^ -(long long)(encoded & 1);
+
+	return true;
+}
+
+/*
+This function returns the amount of squares the given kind of block is made of.
+*/
+static int getBlockSquaresAmount(char blockType) {
+	if (blockType == Game::NO_BLOCK) {
+		return 0;
+	}
+
+	return (blockType == Game::REGULAR_BLOCK) ? GameState::MAX_BLOCK_SQUARES : 1;
+}
+
+/*
+This function sets the view to what a spectator sees of the given game.
+*/
+void SpectatorView::setFromGame(const Game& game) {
+	GameState state;
+
+	game.saveState(state);
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		this->rowMasks[i] = state.rowMasks[i];
+	}
+
+	this->blockType = state.blockType;
+
+	for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+		this->blockSquares[i][0] = state.blockSquares[i][0];
+		this->blockSquares[i][1] = state.blockSquares[i][1];
+	}
+
+	this->score = state.score;
+	this->blocksDropped = state.blocksDropped;
+
+	for (int i = 0; i < NEXT_BLOCKS_AMOUNT; i++) {
+		this->nextBlocks[i] = (unsigned char)game.getNextBlocks().peek(i);
+	}
+
+	this->isFailed = state.isFailed;
+}
+
+/*
+This function returns whether the two views show the same game.
+*/
+bool SpectatorView::operator==(const SpectatorView& other) const {
+	for (int i = 0; i < Board::ROWS; i++) {
+		if (this->rowMasks[i] != other.rowMasks[i]) {
+			return false;
+		}
+	}
+
+	for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+		if (this->blockSquares[i][0] != other.blockSquares[i][0] || this->blockSquares[i][1] != other.blockSquares[i][1]) {
+			return false;
+		}
+	}
+
+	for (int i = 0; i < NEXT_BLOCKS_AMOUNT; i++) {
+		if (this->nextBlocks[i] != other.nextBlocks[i]) {
+			return false;
+		}
+	}
+
+	return this->blockType == other.blockType && this->score == other.score && this->blocksDropped == other.blocksDropped && this->isFailed == other.isFailed;
+}
+
+/*
+This function returns the size of the message that starts at the given data (the data must hold at least the message's header).
+*/
+int SpectatorMessage::readSize(const unsigned char *data) {
+	return data[0] | (data[1] << 8);
+}
+
+/*
+This function encodes the whole view as a keyframe.
+*/
+void SpectatorFeed::encodeKeyframe(const SpectatorView& view, long long sequence, SpectatorMessage& message) {
+	startMessage(message, SpectatorMessage::KEYFRAME, sequence);
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		writeByte(message, (unsigned char)(view.rowMasks[i] & 0xFF));
+		writeByte(message, (unsigned char)(view.rowMasks[i] >> 8));
+	}
+
+	writeByte(message, (unsigned char)view.blockType);
+
+	for (int i = 0; i < getBlockSquaresAmount(view.blockType); i++) {
+		writeByte(message, (unsigned char)view.blockSquares[i][0]);
+		writeByte(message, (unsigned char)view.blockSquares[i][1]);
+	}
+
+	writeSignedVarint(message, view.score);
+	writeSignedVarint(message, view.blocksDropped);
+
+	for (int i = 0; i < SpectatorView::NEXT_BLOCKS_AMOUNT; i++) {
+		writeByte(message, view.nextBlocks[i]);
+	}
+
+	writeByte(message, view.isFailed ? 1 : 0);
+	finishMessage(message);
+}
+
+/*
+This function encodes the changes from one view to the next as a delta.
+A falling block that only moved is sent as the amount it moved by, and a board is sent as its changed rows only.
+*/
+void SpectatorFeed::encodeDelta(const SpectatorView& from, const SpectatorView& to, long long sequence, SpectatorMessage& message) {
+	unsigned int changedRows = 0;
+	unsigned char flags = 0;
+	int squaresAmount = getBlockSquaresAmount(to.blockType);
+	int colsMoved = 0;
+	int rowsMoved = 0;
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		if (from.rowMasks[i] != to.rowMasks[i]) {
+			changedRows |= 1u << i;
+		}
+	}
+
+	if (changedRows != 0) {
+		flags |= ROWS_CHANGED;
+	}
+
+	if (from.blockType != to.blockType) {
+		flags |= BLOCK_REPLACED;
+	}
+	else if (squaresAmount > 0) {
+		//Checking if every square of the block moved by the same amount (otherwise the block was rotated or replaced by a block of the same kind).
+		colsMoved = to.blockSquares[0][0] - from.blockSquares[0][0];
+		rowsMoved = to.blockSquares[0][1] - from.blockSquares[0][1];
+
+		for (int i = 1; i < squaresAmount; i++) {
+			if (to.blockSquares[i][0] - from.blockSquares[i][0] != colsMoved || to.blockSquares[i][1] - from.blockSquares[i][1] != rowsMoved) {
+				flags |= BLOCK_REPLACED;
+				break;
+			}
+		}
+
+		if ((flags & BLOCK_REPLACED) == 0 && (colsMoved != 0 || rowsMoved != 0)) {
+			flags |= BLOCK_MOVED;
+		}
+	}
+
+	if (from.score != to.score) {
+		flags |= SCORE_CHANGED;
+	}
+
+	if (from.blocksDropped != to.blocksDropped) {
+		flags |= BLOCKS_DROPPED_CHANGED;
+	}
+
+	for (int i = 0; i < SpectatorView::NEXT_BLOCKS_AMOUNT; i++) {
+		if (from.nextBlocks[i] != to.nextBlocks[i]) {
+			flags |= NEXT_BLOCKS_CHANGED;
+		}
+	}
+
+	if (from.isFailed != to.isFailed) {
+		flags |= FAILED_CHANGED;
+	}
+
+	startMessage(message, SpectatorMessage::DELTA, sequence);
+	writeByte(message, flags);
+
+	if (flags & ROWS_CHANGED) {
+		writeByte(message, (unsigned char)(changedRows & 0xFF));
+		writeByte(message, (unsigned char)(changedRows >> 8));
+
+		for (int i = 0; i < Board::ROWS; i++) {
+			if (changedRows & (1u << i)) {
+				writeByte(message, (unsigned char)(to.rowMasks[i] & 0xFF));
+				writeByte(message, (unsigned char)(to.rowMasks[i] >> 8));
+			}
+		}
+	}
+
+	if (flags & BLOCK_MOVED) {
+		writeByte(message, (unsigned char)colsMoved);
+		writeByte(message, (unsigned char)rowsMoved);
+	}
+
+	if (flags & BLOCK_REPLACED) {
+		writeByte(message, (unsigned char)to.blockType);
+
+		for (int i = 0; i < squaresAmount; i++) {
+			writeByte(message, (unsigned char)to.blockSquares[i][0]);
+			writeByte(message, (unsigned char)to.blockSquares[i][1]);
+		}
+	}
+
+	if (flags & SCORE_CHANGED) {
+		writeSignedVarint(message, (long long)to.score - from.score);
+	}
+
+	if (flags & BLOCKS_DROPPED_CHANGED) {
+		writeSignedVarint(message, (long long)to.blocksDropped - from.blocksDropped);
+	}
+
+	if (flags & NEXT_BLOCKS_CHANGED) {
+		for (int i = 0; i < SpectatorView::NEXT_BLOCKS_AMOUNT; i++) {
+			writeByte(message, to.nextBlocks[i]);
+		}
+	}
+
+	if (flags & FAILED_CHANGED) {
+		writeByte(message, to.isFailed ? 1 : 0);
+	}
+
+	finishMessage(message);
+}
+
+/*
+This function forgets the game the feed was following (the next update starts from a keyframe for every spectator).
+*/
+void SpectatorFeed::reset() {
+	this->hasView = false;
+	this->keyframeSequence = -1;
+}
+
+/*
+This function adds a delta message with the changes the last step made in the game, and returns false if nothing changed (no message is added then).
+*/
+bool SpectatorFeed::update(const Game& game) {
+	SpectatorView next;
+
+	next.setFromGame(game);
+
+	if (!this->hasView) {
+		this->view = next;
+		this->hasView = true;
+		this->lastSequence++; //The first view has no delta (the spectators start from a keyframe of it).
+		this->firstSequence = this->lastSequence + 1;
+
+		return false;
+	}
+
+	if (next == this->view) {
+		return false;
+	}
+
+	SpectatorMessage& message = this->messages[(this->lastSequence + 1) & (HISTORY - 1)];
+
+	encodeDelta(this->view, next, this->lastSequence + 1, message);
+
+	this->view = next;
+	this->lastSequence++;
+	this->deltaBytes += message.size;
+
+	return true;
+}
+
+/*
+This function returns the sequence number of the last message of the feed.
+*/
+long long SpectatorFeed::getLastSequence() const {
+	return this->lastSequence;
+}
+
+/*
+This function returns whether the delta message with the given sequence number is still kept in the history.
+*/
+bool SpectatorFeed::hasMessage(long long sequence) const {
+	return sequence >= this->firstSequence && sequence <= this->lastSequence && sequence > this->lastSequence - HISTORY;
+}
+
+/*
+This function returns the delta message with the given sequence number (which must be kept in the history, see hasMessage).
+*/
+const SpectatorMessage& SpectatorFeed::getMessage(long long sequence) const {
+	return this->messages[sequence & (HISTORY - 1)];
+}
+
+/*
+This function returns a keyframe of the current view (after the first update). The keyframe is encoded once for all of the spectators that join between two updates.
+*/
+const SpectatorMessage& SpectatorFeed::getKeyframe() {
+	if (this->keyframeSequence != this->lastSequence) {
+		encodeKeyframe(this->view, this->lastSequence, this->keyframe);
+		this->keyframeSequence = this->lastSequence;
+		this->keyframesEncoded++;
+	}
+
+	return this->keyframe;
+}
+
+/*
+This function returns the view after the last message.
+*/
+const SpectatorView& SpectatorFeed::getView() const {
+	return this->view;
+}
+
+/*
+This function returns the amount of keyframes that were encoded.
+*/
+long long SpectatorFeed::getKeyframesEncoded() const {
+	return this->keyframesEncoded;
+}
+
+/*
+This function returns the total size of the delta messages that were encoded.
+*/
+long long SpectatorFeed::getDeltaBytes() const {
+	return this->deltaBytes;
+}
+
+/*
+This function applies a message of the feed to the view, and returns false if the message is damaged or it is a delta that does not follow the last message
+(the spectator then needs a keyframe).
+*/
+bool SpectatorDecoder::apply(const unsigned char *data, int size) {
+	int position = SpectatorMessage::HEADER_SIZE;
+	unsigned char kind, byte;
+	unsigned long long sequence;
+
+	if (size < SpectatorMessage::HEADER_SIZE || SpectatorMessage::readSize(data) != size || !readByte(data, size, position, kind) || !readVarint(data, size, position, sequence)) {
+		return false;
+	}
+
+	SpectatorView next = this->view;
+	long long value;
+
+	if (kind == SpectatorMessage::KEYFRAME) {
+		for (int i = 0; i < Board::ROWS; i++) {
+			unsigned char low, high;
+
+			if (!readByte(data, size, position, low) || !readByte(data, size, position, high)) {
+				return false;
+			}
+
+			next.rowMasks[i] = (unsigned short)(low | (high << 8));
+		}
+
+		if (!readByte(data, size, position, byte)) {
+			return false;
+		}
+
+		next.blockType = (char)byte;
+
+		for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+			next.blockSquares[i][0] = 0;
+			next.blockSquares[i][1] = 0;
+		}
+
+		for (int i = 0; i < getBlockSquaresAmount(next.blockType); i++) {
+			if (!readByte(data, size, position, byte)) {
+				return false;
+			}
+
+			next.blockSquares[i][0] = (signed char)byte;
+
+			if (!readByte(data, size, position, byte)) {
+				return false;
+			}
+
+			next.blockSquares[i][1] = (signed char)byte;
+		}
+
+		if (!readSignedVarint(data, size, position, value)) {
+			return false;
+		}
+
+		next.score = (int)value;
+
+		if (!readSignedVarint(data, size, position, value)) {
+			return false;
+		}
+
+		next.blocksDropped = (int)value;
+
+		for (int i = 0; i < SpectatorView::NEXT_BLOCKS_AMOUNT; i++) {
+			if (!readByte(data, size, position, next.nextBlocks[i])) {
+				return false;
+			}
+		}
+
+		if (!readByte(data, size, position, byte)) {
+			return false;
+		}
+
+		next.isFailed = (byte != 0);
+	}
+	else if (kind == SpectatorMessage::DELTA) {
+		unsigned char flags;
+
+		if (this->sequence == -1 || (long long)sequence != this->sequence + 1 || !readByte(data, size, position, flags)) {
+			return false;
+		}
+
+		if (flags & ROWS_CHANGED) {
+			unsigned char low, high;
+
+			if (!readByte(data, size, position, low) || !readByte(data, size, position, high)) {
+				return false;
+			}
+
+			unsigned int changedRows = low | (high << 8);
+
+			for (int i = 0; i < Board::ROWS; i++) {
+				if (changedRows & (1u << i)) {
+					if (!readByte(data, size, position, low) || !readByte(data, size, position, high)) {
+						return false;
+					}
+
+					next.rowMasks[i] = (unsigned short)(low | (high << 8));
+				}
+			}
+		}
+
+		if (flags & BLOCK_MOVED) {
+			unsigned char colsMoved, rowsMoved;
+
+			if (!readByte(data, size, position, colsMoved) || !readByte(data, size, position, rowsMoved)) {
+				return false;
+			}
+
+			for (int i = 0; i < getBlockSquaresAmount(next.blockType); i++) {
+				next.blockSquares[i][0] += (signed char)colsMoved;
+				next.blockSquares[i][1] += (signed char)rowsMoved;
+			}
+		}
+
+		if (flags & BLOCK_REPLACED) {
+			if (!readByte(data, size, position, byte)) {
+				return false;
+			}
+
+			next.blockType = (char)byte;
+
+			for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+				next.blockSquares[i][0] = 0;
+				next.blockSquares[i][1] = 0;
+			}
+
+			for (int i = 0; i < getBlockSquaresAmount(next.blockType); i++) {
+				unsigned char col, row;
+
+				if (!readByte(data, size, position, col) || !readByte(data, size, position, row)) {
+					return false;
+				}
+
+				next.blockSquares[i][0] = (signed char)col;
+				next.blockSquares[i][1] = (signed char)row;
+			}
+		}
+
+		if (flags & SCORE_CHANGED) {
+			if (!readSignedVarint(data, size, position, value)) {
+				return false;
+			}
+
+			next.score += (int)value;
+		}
+
+		if (flags & BLOCKS_DROPPED_CHANGED) {
+			if (!readSignedVarint(data, size, position, value)) {
+				return false;
+			}
+
+			next.blocksDropped += (int)value;
+		}
+
+		if (flags & NEXT_BLOCKS_CHANGED) {
+			for (int i = 0; i < SpectatorView::NEXT_BLOCKS_AMOUNT; i++) {
+				if (!readByte(data, size, position, next.nextBlocks[i])) {
+					return false;
+				}
+			}
+		}
+
+		if (flags & FAILED_CHANGED) {
+			if (!readByte(data, size, position, byte)) {
+				return false;
+			}
+
+			next.isFailed = (byte != 0);
+		}
+	}
+	else {
+		return false;
+	}
+
+	if (position != size) { //The message is longer than its contents.
+		return false;
+	}
+
+	this->view = next;
+	this->sequence = (long long)sequence;
+
+	return true;
+}
+
+/*
+This function returns whether a keyframe was applied (so the view shows a game).
+*/
+bool SpectatorDecoder::hasView() const {
+	return this->sequence != -1;
+}
+
+/*
+This function returns the sequence number of the last message that was applied.
+*/
+long long SpectatorDecoder::getSequence() const {
+	return this->sequence;
+}
+
+/*
+This function returns the spectator's view of the game.
+*/
+const SpectatorView& SpectatorDecoder::getView() const {
+	return this->view;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef __SPECTATOR_FEED_H
+#define __SPECTATOR_FEED_H
+
+#include "game.h"
+
+/*
+What a spectator sees of a game: the board, the falling block, the upcoming blocks and the details.
+It does not hold the seed of the game's blocks, so a spectator cannot tell the blocks that are further ahead.
+*/
+struct SpectatorView {
+	constexpr static int NEXT_BLOCKS_AMOUNT = 3;
+
+	unsigned short rowMasks[Board::ROWS]; //The board's used squares, as returned by Board::getRowMask.
+	char blockType; //The kind of the current block (Game::NO_BLOCK, REGULAR_BLOCK, JOKER_BLOCK or BOMB_BLOCK).
+	signed char blockSquares[GameState::MAX_BLOCK_SQUARES][2]; //The column and row of each square of the current block (a joker and a bomb use only the first one).
+	int score;
+	int blocksDropped;
+	unsigned char nextBlocks[NEXT_BLOCKS_AMOUNT];
+	bool isFailed;
+
+	void setFromGame(const Game& game);
+	bool operator==(const SpectatorView& other) const;
+};
+
+/*
+A message of the spectator feed, encoded once and sent as it is to every spectator.
+A message starts with its size (2 bytes, little endian), its kind and its sequence number (a varint):
+a keyframe holds the whole view after the message with that sequence number, and a delta holds only what changed since the previous message.
+*/
+struct SpectatorMessage {
+	enum eKind {KEYFRAME = 1, DELTA = 2};
+
+	constexpr static int HEADER_SIZE = 2; //The size of the message's size.
+	constexpr static int MAX_SIZE = 128; //Larger than the largest keyframe.
+
+	long long sequence; //The sequence number is kept next to the data as well, so a sender can tell when a slot of the history was reused.
+	int size;
+	unsigned char data[MAX_SIZE];
+
+	static int readSize(const unsigned char *data);
+};
+
+/*
+The spectator feed of one game: after every step it encodes what changed in the game as a delta message.
+The last HISTORY messages are kept in a ring buffer, so each message is encoded once however many spectators there are,
+and every spectator only keeps the sequence number of the next message it needs (a cursor into the feed).
+A spectator that joins, or that fell behind by more than the history, starts from a keyframe of the current view.
+*/
+class SpectatorFeed {
+public:
+	constexpr static int HISTORY = 64;
+
+private:
+	static_assert((HISTORY & (HISTORY - 1)) == 0, "The history of the feed must be a power of two.");
+
+	SpectatorView view; //This property saves the view after the last message.
+	bool hasView = false;
+	long long lastSequence = 0; //This property saves the sequence number of the last message.
+	long long firstSequence = 1; //This property saves the sequence number of the first delta of the current game.
+	SpectatorMessage messages[HISTORY];
+	SpectatorMessage keyframe;
+	long long keyframeSequence = -1; //This property saves the sequence number the cached keyframe was encoded at.
+
+	long long keyframesEncoded = 0;
+	long long deltaBytes = 0;
+
+	SpectatorFeed(const SpectatorFeed& other) = delete;
+
+	static void encodeDelta(const SpectatorView& from, const SpectatorView& to, long long sequence, SpectatorMessage& message);
+	static void encodeKeyframe(const SpectatorView& view, long long sequence, SpectatorMessage& message);
+
+public:
+	SpectatorFeed() = default;
+
+	void reset();
+	bool update(const Game& game);
+
+	long long getLastSequence() const;
+	bool hasMessage(long long sequence) const;
+	const SpectatorMessage& getMessage(long long sequence) const;
+	const SpectatorMessage& getKeyframe();
+	const SpectatorView& getView() const;
+
+	long long getKeyframesEncoded() const;
+	long long getDeltaBytes() const;
+};
+
+/*
+The side of a spectator: it applies the messages of a feed to its own copy of the view.
+*/
+class SpectatorDecoder {
+private:
+	SpectatorView view;
+	long long sequence = -1; //This property saves the sequence number of the last message that was applied (-1 before the first keyframe).
+
+public:
+	bool apply(const unsigned char *data, int size);
+
+	bool hasView() const;
+	long long getSequence() const;
+	const SpectatorView& getView() const;
+};
+
+#endif
\ No newline at end of file
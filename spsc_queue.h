@@ -0,0 +1,84 @@
+#ifndef __SPSC_QUEUE_H
+#define __SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+using namespace std;
+
+/*
+A wait-free ring buffer that passes values from a single producer thread to a single consumer thread.
+Each side only writes its own position (and reads the other's), so pushing and popping never wait for the other thread and never allocate.
+CAPACITY must be a power of two, and the queue holds up to CAPACITY values.
+*/
+template <typename T, int CAPACITY>
+class SpscQueue {
+private:
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "The capacity of the queue must be a power of two.");
+
+	constexpr static int CACHE_LINE_SIZE = 64;
+
+	//The positions only grow (they wrap around at the end of the range of size_t), and the slot of a position is position % CAPACITY.
+	alignas(CACHE_LINE_SIZE) atomic<size_t> head; //This property saves the position of the next value to pop (it is only written by the consumer).
+	alignas(CACHE_LINE_SIZE) atomic<size_t> tail; //This property saves the position of the next value to push (it is only written by the producer).
+	alignas(CACHE_LINE_SIZE) T values[CAPACITY];
+
+public:
+	SpscQueue() : head(0), tail(0) {
+	}
+
+	SpscQueue(const SpscQueue& other) = delete;
+	SpscQueue& operator=(const SpscQueue& other) = delete;
+
+	/*
+	This function adds a value to the end of the queue and returns true, or returns false if the queue is full (only called by the producer).
+	*/
+	bool push(const T& value) {
+		size_t position = this->tail.load(memory_order_relaxed);
+
+		if (position - this->head.load(memory_order_acquire) == (size_t)CAPACITY) {
+			return false;
+		}
+
+		this->values[position & (CAPACITY - 1)] = value;
+		this->tail.store(position + 1, memory_order_release);
+
+		return true;
+	}
+
+	/*
+	This function copies the first value of the queue without removing it and returns true, or returns false if the queue is empty (only called by the consumer).
+	*/
+	bool peek(T& value) const {
+		size_t position = this->head.load(memory_order_relaxed);
+
+		if (position == this->tail.load(memory_order_acquire)) {
+			return false;
+		}
+
+		value = this->values[position & (CAPACITY - 1)];
+
+		return true;
+	}
+
+	/*
+	This function removes the first value of the queue and copies it, or returns false if the queue is empty (only called by the consumer).
+	*/
+	bool pop(T& value) {
+		if (!this->peek(value)) {
+			return false;
+		}
+
+		this->head.store(this->head.load(memory_order_relaxed) + 1, memory_order_release);
+
+		return true;
+	}
+
+	/*
+	This function returns whether the queue is empty (it may be out of date by the time it returns, unless it is called by the consumer and the result is false).
+	*/
+	bool isEmpty() const {
+		return this->head.load(memory_order_acquire) == this->tail.load(memory_order_acquire);
+	}
+};
+
+#endif
\ No newline at end of file
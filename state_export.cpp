@@ -0,0 +1,474 @@
+#include "state_export.h"
+
+#include <cstring>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#endif
+
+/*
+Destructor - frees the claimed slot and unmaps the segment (and removes it, if this object was its last writer).
+*/
+StateExport::~StateExport() {
+	this->close();
+}
+
+/*
+This function creates the segment with the given name and amount of slots for this process alone, and returns whether it was created.
+It fails if there is already a segment with this name (another process exports to it). All of the slots start empty, and all of them belong to this process.
+*/
+bool StateExport::create(const string& name, int slotsAmount) {
+	this->close();
+
+	if (slotsAmount <= 0 || slotsAmount > MAX_SLOTS) {
+		return false;
+	}
+
+	this->name = name;
+
+	bool isCreated = false;
+
+	if (!this->map(true, slotsAmount, isCreated)) {
+		return false;
+	}
+
+	if (!isCreated) {
+		this->unmap(false);
+		return false;
+	}
+
+	this->initialize(slotsAmount, getProcessId());
+	this->isWriter = true;
+
+	return true;
+}
+
+/*
+This function opens the segment with the given name for writing (it creates the segment with the given amount of slots if there is none),
+and claims a free slot for this process. It returns false if the segment cannot be opened or all of its slots are taken.
+*/
+bool StateExport::join(const string& name, int slotsAmount) {
+	this->close();
+
+	if (slotsAmount <= 0 || slotsAmount > MAX_SLOTS) {
+		return false;
+	}
+
+	this->name = name;
+
+	//The segment may be in the middle of being created or removed by another process, so it is opened again until it can be joined.
+	for (int attempt = 0; attempt < JOIN_ATTEMPTS && this->memory == nullptr; attempt++) {
+		bool isCreated = false;
+
+		if (this->map(true, slotsAmount, isCreated)) {
+			if (isCreated) {
+				this->initialize(slotsAmount, 0);
+			}
+			else if (!this->isValid() || !this->addWriter()) {
+				this->unmap(false);
+			}
+		}
+
+		if (this->memory == nullptr) {
+			this_thread::sleep_for(chrono::milliseconds((int)JOIN_RETRY_DELAY));
+		}
+	}
+
+	if (this->memory == nullptr) {
+		return false;
+	}
+
+	this->isWriter = true;
+
+	unsigned int processId = getProcessId();
+	int slotsAmountInSegment = this->getSlotsAmount();
+
+	//Claiming the first slot that is free or was left by a process that has ended. The compare-and-swap makes sure no other process claims it as well.
+	for (int i = 0; i < slotsAmountInSegment; i++) {
+		Slot *slot = this->getSlot(i);
+		unsigned int writer = slot->writerProcessId.load(memory_order_relaxed);
+
+		if ((writer == 0 || !isProcessRunning(writer)) && slot->writerProcessId.compare_exchange_strong(writer, processId, memory_order_acquire)) {
+			unsigned int sequence = slot->sequence.load(memory_order_relaxed);
+
+			//A process that ended while it was writing left the sequence odd, so it is made even before the first publish.
+			slot->sequence.store((sequence + 1) & ~1u, memory_order_relaxed);
+
+			//A process that ended without closing is still counted as a writer (and this process is counted as well, so this is not the last writer).
+			if (writer != 0) {
+				this->getHeader()->writersAmount.fetch_sub(1, memory_order_acq_rel);
+			}
+
+			this->joinedSlot = i;
+			return true;
+		}
+	}
+
+	this->close();
+	return false;
+}
+
+/*
+This function opens an existing segment for reading and returns false if there is no such segment or it was made by a different version of the game.
+*/
+bool StateExport::open(const string& name) {
+	this->close();
+	this->name = name;
+
+	bool isCreated = false;
+
+	if (!this->map(false, 0, isCreated)) {
+		return false;
+	}
+
+	if (!this->isValid()) {
+		this->unmap(false);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+This function sets up the header and the slots of a segment that was just created, with the given writer for all of the slots (0 for free slots).
+*/
+void StateExport::initialize(int slotsAmount, unsigned int slotsWriter) {
+	for (int i = 0; i < slotsAmount; i++) {
+		Slot *slot = new (this->getSlot(i)) Slot();
+
+		slot->sequence.store(0, memory_order_relaxed);
+		slot->writerProcessId.store(slotsWriter, memory_order_relaxed);
+
+		for (int j = 0; j < STATE_WORDS; j++) {
+			slot->words[j].store(0, memory_order_relaxed);
+		}
+	}
+
+	Header *header = new (this->getHeader()) Header();
+
+	header->version = VERSION;
+	header->slotsAmount = (unsigned int)slotsAmount;
+	header->slotSize = (unsigned int)sizeof(Slot);
+	header->writersAmount.store(1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	header->magic = MAGIC; //The magic is written last, so a monitor does not read a segment that is being created.
+}
+
+/*
+This function returns whether the mapped segment was made by this version of the game and is as big as its header says.
+*/
+bool StateExport::isValid() const {
+	Header *header = this->getHeader();
+
+	if (this->size < sizeof(Header) || header->magic != MAGIC) {
+		return false;
+	}
+
+	atomic_thread_fence(memory_order_acquire); //The rest of the header was written before the magic.
+
+	return header->version == VERSION && header->slotSize == sizeof(Slot)
+		&& header->slotsAmount != 0 && header->slotsAmount <= MAX_SLOTS && this->size >= sizeof(Slot) * (header->slotsAmount + 1);
+}
+
+/*
+This function counts this process as a writer of the segment, and returns false if the segment is being removed by its last writer.
+*/
+bool StateExport::addWriter() {
+	atomic<unsigned int>& writersAmount = this->getHeader()->writersAmount;
+	unsigned int amount = writersAmount.load(memory_order_relaxed);
+
+	do {
+		if (amount == REMOVED_WRITERS) {
+			return false;
+		}
+	} while (!writersAmount.compare_exchange_weak(amount, amount + 1, memory_order_acq_rel));
+
+	return true;
+}
+
+/*
+This function stops counting this process as a writer of the segment, and returns whether it was the last writer.
+The last writer marks the segment as removed, so no process joins it between the check and the removal of its name.
+*/
+bool StateExport::removeWriter() {
+	atomic<unsigned int>& writersAmount = this->getHeader()->writersAmount;
+	unsigned int amount = writersAmount.load(memory_order_relaxed);
+
+#ifdef _WIN32
+	unsigned int lastAmount = 0; //The mapping is removed with its last handle and not by its name, so it is left for the next game to join.
+#else
+	unsigned int lastAmount = REMOVED_WRITERS;
+#endif
+
+	while (!writersAmount.compare_exchange_weak(amount, (amount == 1) ? lastAmount : amount - 1, memory_order_acq_rel)) {
+	}
+
+	return amount == 1;
+}
+
+/*
+This function maps the segment into memory: for writing, it creates the segment for the given amount of slots or opens the existing one
+(isCreated tells which), and for reading it opens the existing segment.
+The header takes a whole slot, so every slot starts at the beginning of a cache line.
+*/
+bool StateExport::map(bool isWriting, int slotsAmount, bool& isCreated) {
+	static_assert(sizeof(Header) <= sizeof(Slot), "The header must fit in the first slot of the segment.");
+
+	isCreated = false;
+
+#ifdef _WIN32
+	string mappingName = "Local\\" + this->name;
+	HANDLE mapping;
+
+	if (isWriting) {
+		this->size = sizeof(Slot) * (slotsAmount + 1);
+		mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)this->size, mappingName.c_str());
+		isCreated = (mapping != NULL && GetLastError() != ERROR_ALREADY_EXISTS);
+	}
+	else {
+		mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, mappingName.c_str());
+	}
+
+	if (mapping == NULL) {
+		return false;
+	}
+
+	this->memory = MapViewOfFile(mapping, isWriting ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, isCreated ? this->size : 0);
+
+	if (this->memory == NULL) {
+		CloseHandle(mapping);
+		return false;
+	}
+
+	if (!isCreated) {
+		MEMORY_BASIC_INFORMATION information;
+
+		VirtualQuery(this->memory, &information, sizeof(information));
+		this->size = information.RegionSize;
+	}
+
+	this->mappingHandle = mapping;
+#else
+	string objectName = "/" + this->name;
+	int descriptor;
+	struct stat information;
+
+	if (isWriting) {
+		descriptor = shm_open(objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		isCreated = (descriptor >= 0);
+
+		if (!isCreated && errno == EEXIST) {
+			descriptor = shm_open(objectName.c_str(), O_RDWR, 0);
+		}
+	}
+	else {
+		descriptor = shm_open(objectName.c_str(), O_RDONLY, 0);
+	}
+
+	if (descriptor < 0) {
+		return false;
+	}
+
+	if (isCreated) {
+		this->size = sizeof(Slot) * (slotsAmount + 1);
+
+		if (ftruncate(descriptor, (off_t)this->size) != 0) {
+			::close(descriptor);
+			shm_unlink(objectName.c_str());
+			return false;
+		}
+	}
+	else {
+		this->size = (fstat(descriptor, &information) == 0) ? (size_t)information.st_size : 0;
+	}
+
+	this->memory = (this->size > 0) ? mmap(NULL, this->size, isWriting ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, descriptor, 0) : MAP_FAILED;
+	::close(descriptor); //The mapping stays after the descriptor is closed.
+
+	if (this->memory == MAP_FAILED) {
+		this->memory = nullptr;
+
+		if (isCreated) {
+			shm_unlink(objectName.c_str());
+		}
+
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+/*
+This function unmaps the segment, and removes its name if requested (the monitors that have it open keep their mapping).
+*/
+void StateExport::unmap(bool isRemoving) {
+#ifdef _WIN32
+	UnmapViewOfFile(this->memory);
+	CloseHandle((HANDLE)this->mappingHandle); //The mapping is removed when the last process closes it.
+	this->mappingHandle = nullptr;
+#else
+	munmap(this->memory, this->size);
+
+	if (isRemoving) {
+		shm_unlink(("/" + this->name).c_str());
+	}
+#endif
+
+	this->memory = nullptr;
+	this->size = 0;
+}
+
+/*
+This function frees the slot this object has claimed, unmaps the segment and removes it if this object was its last writer.
+*/
+void StateExport::close() {
+	if (this->memory == nullptr) {
+		return;
+	}
+
+	if (this->joinedSlot != -1) {
+		ExportedState empty = {};
+
+		this->publish(this->joinedSlot, empty); //A slot with no process is empty for the monitors.
+		this->getSlot(this->joinedSlot)->writerProcessId.store(0, memory_order_release);
+		this->joinedSlot = -1;
+	}
+
+	bool isRemoving = this->isWriter && this->removeWriter();
+
+	this->unmap(isRemoving);
+	this->isWriter = false;
+}
+
+/*
+This function returns whether a segment is mapped.
+*/
+bool StateExport::isOpen() const {
+	return this->memory != nullptr;
+}
+
+/*
+This function writes the state of a game to its slot (only called by the game's thread, after the segment was created).
+*/
+void StateExport::publish(int slot, const ExportedState& state) {
+	Slot *target = this->getSlot(slot);
+	unsigned int words[STATE_WORDS] = {};
+	unsigned int sequence = target->sequence.load(memory_order_relaxed);
+
+	memcpy(words, &state, sizeof(ExportedState));
+
+	target->sequence.store(sequence + 1, memory_order_relaxed); //An odd sequence tells the monitors that the slot is being written.
+	atomic_thread_fence(memory_order_release);
+
+	for (int i = 0; i < STATE_WORDS; i++) {
+		target->words[i].store(words[i], memory_order_relaxed);
+	}
+
+	target->sequence.store(sequence + 2, memory_order_release);
+}
+
+/*
+This function copies the state of a game from its slot, and returns false if the slot is empty (or it was being written during every attempt).
+*/
+bool StateExport::read(int slot, ExportedState& state) const {
+	const Slot *source = this->getSlot(slot);
+	unsigned int words[STATE_WORDS];
+
+	for (int attempt = 0; attempt < READ_ATTEMPTS; attempt++) {
+		unsigned int sequence = source->sequence.load(memory_order_acquire);
+
+		if (sequence & 1) { //The slot is being written.
+			continue;
+		}
+
+		for (int i = 0; i < STATE_WORDS; i++) {
+			words[i] = source->words[i].load(memory_order_relaxed);
+		}
+
+		atomic_thread_fence(memory_order_acquire);
+
+		if (source->sequence.load(memory_order_relaxed) == sequence) { //The slot was not written while it was copied.
+			memcpy(&state, words, sizeof(ExportedState));
+			return state.processId != 0; //A slot that was never written is all zeros.
+		}
+	}
+
+	return false;
+}
+
+/*
+This function returns the amount of slots of the segment.
+*/
+int StateExport::getSlotsAmount() const {
+	return (this->memory != nullptr) ? (int)this->getHeader()->slotsAmount : 0;
+}
+
+/*
+This function returns the slot this object has claimed with join (or -1 if it has not claimed a slot).
+*/
+int StateExport::getJoinedSlot() const {
+	return this->joinedSlot;
+}
+
+/*
+This function returns the header at the beginning of the segment.
+*/
+StateExport::Header * StateExport::getHeader() const {
+	return (Header *)this->memory;
+}
+
+/*
+This function returns the slot with the given index (the header takes the place of the first slot).
+*/
+StateExport::Slot * StateExport::getSlot(int slot) const {
+	return (Slot *)this->memory + 1 + slot;
+}
+
+/*
+This function returns the identifier of the current process.
+*/
+unsigned int StateExport::getProcessId() {
+#ifdef _WIN32
+	return (unsigned int)GetCurrentProcessId();
+#else
+	return (unsigned int)getpid();
+#endif
+}
+
+/*
+This function returns whether the process with the given identifier is running (a process that cannot be accessed is counted as running).
+*/
+bool StateExport::isProcessRunning(unsigned int processId) {
+#ifdef _WIN32
+	HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)processId);
+
+	if (process == NULL) {
+		return GetLastError() == ERROR_ACCESS_DENIED;
+	}
+
+	bool isRunning = (WaitForSingleObject(process, 0) == WAIT_TIMEOUT);
+
+	CloseHandle(process);
+	return isRunning;
+#else
+	return kill((pid_t)processId, 0) == 0 || errno == EPERM;
+#endif
+}
+
+/*
+This function returns the time of the steady clock in nanoseconds (the time that ExportedState::updatedAt is saved in).
+*/
+long long StateExport::getTime() {
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
\ No newline at end of file
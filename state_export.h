@@ -0,0 +1,111 @@
+#ifndef __STATE_EXPORT_H
+#define __STATE_EXPORT_H
+
+#include <atomic>
+#include <string>
+#include "board.h"
+using namespace std;
+
+/*
+The state of a running game as it is exported to the monitors.
+*/
+struct ExportedState {
+	enum eStatus {IN_MENU, PLAYING, GAME_OVER};
+
+	unsigned int processId; //The process that runs the game.
+	unsigned char status;
+	int score;
+	int blocksDropped;
+	int speed; //In miliseconds per step.
+	long long steps; //The amount of steps run since the process has started.
+	long long gamesPlayed;
+	long long updatedAt; //The time of the update in nanoseconds of the steady clock (which all of the processes of a computer share).
+	unsigned short rowMasks[Board::ROWS]; //The board's used squares, as returned by Board::getRowMask.
+};
+
+/*
+The states of running games, exported to a named shared memory segment so any amount of local monitors can watch them.
+The segment holds a header and a slot for each game. Each slot is a seqlock: the game's thread (the only writer of its slot) makes the slot's sequence odd,
+writes the state and makes the sequence even again, and a monitor copies the state and checks that the sequence did not change while it was copying.
+Writing a state is a plain memory copy with no locks and no system calls, and a monitor never stops the game (it copies again instead).
+On Windows the segment is a named file mapping (in the session's namespace), and on other systems it is a POSIX shared memory object.
+
+Several games share a segment: the first game creates it, and each game claims a free slot of its own by writing its process to the slot's writer
+with a compare-and-swap (the slot of a process that has ended is free as well). The header counts the processes that write to the segment,
+so the name of the segment is removed only by the last of them. A process that ended without closing is dropped from the count by the game
+that claims its slot, so until then the segment is not removed.
+*/
+class StateExport {
+public:
+	constexpr static const char *DEFAULT_NAME = "tetris_state";
+	constexpr static unsigned int MAGIC = 0x54535445; //"ETST" in little endian.
+	constexpr static unsigned int VERSION = 2; //Increased whenever the layout of the segment or of ExportedState changes.
+	constexpr static int MAX_SLOTS = 256;
+	constexpr static int DEFAULT_SLOTS = 16; //The slots of a segment that is created by a game (the most games that are exported at once).
+	constexpr static int READ_ATTEMPTS = 1000; //The most copies a monitor makes before it gives up on a slot that is being written all of the time.
+
+private:
+	constexpr static int CACHE_LINE_SIZE = 64;
+	constexpr static int STATE_WORDS = (sizeof(ExportedState) + sizeof(unsigned int) - 1) / sizeof(unsigned int);
+	constexpr static unsigned int REMOVED_WRITERS = 0xFFFFFFFF; //The writers amount of a segment whose name is being removed, so it cannot be joined anymore.
+	constexpr static int JOIN_ATTEMPTS = 100;
+	constexpr static int JOIN_RETRY_DELAY = 10; //The time to wait for a segment that is being created or removed by another process (in miliseconds).
+
+	static_assert(ATOMIC_INT_LOCK_FREE == 2, "The atomics in the shared memory must be lock-free to be shared between processes.");
+
+	struct Header {
+		unsigned int magic;
+		unsigned int version;
+		unsigned int slotsAmount;
+		unsigned int slotSize;
+		atomic<unsigned int> writersAmount; //The processes that write to the segment.
+	};
+
+	//The state is copied in words, and each word is an atomic so the copy that races with the writer is not undefined (the sequence tells the monitor to retry).
+	//The words are 32 bits, since a 64-bit atomic load is a write on 32-bit x86 and the monitors map the segment read-only.
+	struct alignas(CACHE_LINE_SIZE) Slot {
+		atomic<unsigned int> sequence;
+		atomic<unsigned int> writerProcessId; //The process that writes to the slot (0 if the slot is free).
+		atomic<unsigned int> words[STATE_WORDS];
+	};
+
+	string name;
+	bool isWriter = false; //This property saves whether this object writes to the segment (so the segment is removed when the last writer closes it).
+	int joinedSlot = -1; //This property saves the slot this object has claimed with join (or -1).
+	void *memory = nullptr;
+	size_t size = 0;
+	void *mappingHandle = nullptr; //Only used on Windows.
+
+	Header *getHeader() const;
+	Slot *getSlot(int slot) const;
+	bool map(bool isWriting, int slotsAmount, bool& isCreated);
+	void unmap(bool isRemoving);
+	void initialize(int slotsAmount, unsigned int slotsWriter);
+	bool isValid() const;
+	bool addWriter();
+	bool removeWriter();
+
+	StateExport(const StateExport& other) = delete;
+
+public:
+	StateExport() = default;
+	~StateExport();
+
+	bool create(const string& name, int slotsAmount);
+	bool join(const string& name, int slotsAmount);
+	bool open(const string& name);
+	void close();
+	bool isOpen() const;
+
+	void publish(int slot, const ExportedState& state);
+	bool read(int slot, ExportedState& state) const;
+
+	int getSlotsAmount() const;
+	int getJoinedSlot() const;
+
+	static unsigned int getProcessId();
+	static bool isProcessRunning(unsigned int processId);
+	static long long getTime();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,399 @@
+#include "surface_placements.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+
+/*
+This function returns the location and rotation of the falling block of a state, used as a key for the block states that were already reached.
+*/
+static string getBlockKey(const GameState& state) {
+	string key((const char *)state.blockSquares, sizeof(state.blockSquares));
+
+	key += (char)(state.blockRotatedAmount & 1); //Only the parity of the rotations affects the next rotation.
+
+	return key;
+}
+
+/*
+Constructor - finds the orientations and the drops of every shape, by searching the moves of each shape on an empty board.
+*/
+SurfacePlacementFinder::SurfacePlacementFinder() {
+	Game game;
+
+	for (int i = 0; i < BlocksGenerator::SHAPES_AMOUNT; i++) {
+		this->prepareShape(game, (BlocksGenerator::eBlockType)i);
+	}
+}
+
+/*
+This function searches the moves of a shape on an empty board (in a breadth-first order, like PlacementFinder) and keeps the first way found to each
+orientation at each column, which is the shortest one. Moving the block down is left out, since the block falls by one row in every step anyway.
+*/
+void SurfacePlacementFinder::prepareShape(Game& game, BlocksGenerator::eBlockType blockType) {
+	//A state of the block that was reached during the search.
+	struct PathNode {
+		GameState state;
+		int parent;
+		Game::eAction action;
+	};
+
+	const Game::eAction MOVES[] = {Game::NO_ACTION, Game::MOVE_LEFT, Game::MOVE_RIGHT, Game::ROTATE_RIGHT};
+	Shape& shape = this->shapes[blockType];
+	Board emptyBoard;
+	GameState start, state;
+	vector<PathNode> nodes;
+	unordered_set<string> reachedBlocks;
+
+	game.start(0);
+	game.setBoard(emptyBoard);
+	game.addBlock(blockType);
+	game.saveState(start);
+	memcpy(shape.blockSquares, start.blockSquares, sizeof(shape.blockSquares));
+
+	PathNode first = {start, -1, Game::NO_ACTION};
+	nodes.push_back(first);
+	reachedBlocks.insert(getBlockKey(start));
+
+	for (size_t i = 0; i < nodes.size(); i++) {
+		GameState node = nodes[i].state;
+		int orientation = this->addOrientation(shape, node);
+		int col = Board::COLS;
+		int row = Board::ROWS;
+		bool isNewDrop = true;
+
+		for (int j = 0; j < GameState::MAX_BLOCK_SQUARES; j++) {
+			col = min(col, (int)node.blockSquares[j][0]);
+			row = min(row, (int)node.blockSquares[j][1]);
+		}
+
+		for (size_t j = 0; j < shape.drops.size() && isNewDrop; j++) {
+			isNewDrop = (shape.drops[j].orientation != orientation || shape.drops[j].col != col);
+		}
+
+		if (isNewDrop) {
+			Drop drop;
+
+			drop.orientation = orientation;
+			drop.col = col;
+			drop.row = row;
+			memcpy(drop.blockSquares, node.blockSquares, sizeof(drop.blockSquares));
+			drop.rotatedAmount = node.blockRotatedAmount;
+			drop.actions.push_back(Game::MOVE_DOWN);
+
+			for (int j = (int)i; nodes[j].parent != -1; j = nodes[j].parent) {
+				drop.actions.push_back(nodes[j].action);
+			}
+
+			reverse(drop.actions.begin(), drop.actions.end());
+			this->setPath(game, start, drop);
+			shape.drops.push_back(drop);
+		}
+
+		for (Game::eAction action : MOVES) {
+			bool isInBoard = true;
+
+			game.loadState(node);
+			game.tick(action);
+			game.saveState(state);
+
+			for (int j = 0; j < GameState::MAX_BLOCK_SQUARES; j++) {
+				isInBoard = isInBoard && state.blockSquares[j][1] >= 0;
+			}
+
+			//The block was locked at the bottom, or it is above the board (where the board cannot tell whether its squares are free).
+			if (state.blockType == Game::NO_BLOCK || !isInBoard) {
+				continue;
+			}
+
+			if (reachedBlocks.insert(getBlockKey(state)).second) {
+				PathNode next = {state, (int)i, action};
+				nodes.push_back(next);
+			}
+		}
+	}
+}
+
+/*
+This function returns the index of the orientation of the falling block of the given state in the shape's orientations, adding it if it is new.
+A new orientation comes with the landing of each profile of the columns under it.
+*/
+int SurfacePlacementFinder::addOrientation(Shape& shape, const GameState& state) {
+	Orientation orientation;
+	int squares[BlocksGenerator::SHAPE_SIZE];
+	int minCol = Board::COLS;
+	int minRow = Board::ROWS;
+
+	for (int i = 0; i < BlocksGenerator::SHAPE_SIZE; i++) {
+		minCol = min(minCol, (int)state.blockSquares[i][0]);
+		minRow = min(minRow, (int)state.blockSquares[i][1]);
+	}
+
+	//The squares are sorted (by row and then by column), so the same orientation is found whatever the order of the block's squares is.
+	for (int i = 0; i < BlocksGenerator::SHAPE_SIZE; i++) {
+		squares[i] = (state.blockSquares[i][1] - minRow) * Board::COLS + state.blockSquares[i][0] - minCol;
+	}
+
+	sort(squares, squares + BlocksGenerator::SHAPE_SIZE);
+	memset(&orientation, 0, sizeof(orientation));
+
+	for (int i = 0; i < BlocksGenerator::SHAPE_SIZE; i++) {
+		orientation.squares[i][0] = (signed char)(squares[i] % Board::COLS);
+		orientation.squares[i][1] = (signed char)(squares[i] / Board::COLS);
+	}
+
+	for (size_t i = 0; i < shape.orientations.size(); i++) {
+		if (memcmp(shape.orientations[i].squares, orientation.squares, sizeof(orientation.squares)) == 0) {
+			return (int)i;
+		}
+	}
+
+	for (int i = 0; i < BlocksGenerator::SHAPE_SIZE; i++) {
+		int col = orientation.squares[i][0];
+
+		orientation.width = max(orientation.width, col + 1);
+		orientation.bottoms[col] = max(orientation.bottoms[col], (int)orientation.squares[i][1]);
+	}
+
+	//The digits of a profile are the depths of the columns under the block below the highest of them (the leftmost column is the most significant digit).
+	//The block's top row lands above the square that stops its first column.
+	int profilesAmount = 1;
+
+	for (int i = 0; i < orientation.width; i++) {
+		profilesAmount *= MAX_DEPTH + 1;
+	}
+
+	for (int profile = 0; profile < profilesAmount; profile++) {
+		int rest = profile;
+		int landing = MAX_DEPTH;
+
+		for (int col = orientation.width - 1; col >= 0; col--) {
+			landing = min(landing, rest % (MAX_DEPTH + 1) - 1 - orientation.bottoms[col]);
+			rest /= MAX_DEPTH + 1;
+		}
+
+		orientation.landings[profile] = (signed char)landing;
+	}
+
+	shape.orientations.push_back(orientation);
+
+	return (int)shape.orientations.size() - 1;
+}
+
+/*
+This function runs the actions of a drop on an empty board and saves the squares the block passes through: after each action and after each fall.
+A board whose squares on this path are free lets the block take the same way.
+*/
+void SurfacePlacementFinder::setPath(Game& game, const GameState& start, Drop& drop) {
+	GameState state = start;
+
+	memset(drop.path, 0, sizeof(drop.path));
+	drop.firstPathRow = Board::ROWS;
+	drop.lastPathRow = -1;
+
+	//Adds the squares of the block to the path.
+	auto addBlock = [&drop](const GameState& state) {
+		for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+			int row = state.blockSquares[i][1];
+
+			drop.path[row] |= (unsigned short)(1u << state.blockSquares[i][0]);
+			drop.firstPathRow = min(drop.firstPathRow, row);
+			drop.lastPathRow = max(drop.lastPathRow, row);
+		}
+	};
+
+	addBlock(state);
+	game.loadState(start);
+
+	for (size_t i = 0; i + 1 < drop.actions.size(); i++) { //The last action is the drop itself.
+		game.act(drop.actions[i]);
+		game.saveState(state);
+		addBlock(state);
+
+		game.tick(Game::NO_ACTION);
+		game.saveState(state);
+		addBlock(state);
+	}
+}
+
+/*
+This function returns the shape of the falling block of the given state, or -1 if it is not a shape that was just added to the board.
+*/
+int SurfacePlacementFinder::findShape(const GameState& start) const {
+	if (start.blockType != Game::REGULAR_BLOCK || start.blockRotatedAmount != 0) {
+		return -1;
+	}
+
+	for (int i = 0; i < BlocksGenerator::SHAPES_AMOUNT; i++) {
+		if (memcmp(start.blockSquares, this->shapes[i].blockSquares, sizeof(start.blockSquares)) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+This function puts the top used row of each column into the output parameter (Board::ROWS for an empty column)
+and returns false if a square of the board is free below a used square.
+*/
+bool SurfacePlacementFinder::getSurface(const unsigned short rowMasks[Board::ROWS], int tops[Board::COLS]) {
+	unsigned int coveredCols = 0; //The columns that have a used square above the current row.
+
+	for (int i = 0; i < Board::COLS; i++) {
+		tops[i] = Board::ROWS;
+	}
+
+	for (int row = 0; row < Board::ROWS; row++) {
+		unsigned int rowMask = rowMasks[row];
+		unsigned int newCols = rowMask & ~coveredCols;
+
+		if ((coveredCols & ~rowMask) != 0) {
+			return false;
+		}
+
+		for (; newCols != 0; newCols &= newCols - 1) {
+			tops[Board::countTrailingZeros(newCols)] = row;
+		}
+
+		coveredCols |= rowMask;
+	}
+
+	return true;
+}
+
+/*
+This function returns the top row of the given orientation when it is dropped at the given column, looked up by the profile of the columns under it.
+*/
+int SurfacePlacementFinder::getLandingRow(const Orientation& orientation, int col, const int tops[Board::COLS]) const {
+	int highest = Board::ROWS;
+	int profile = 0;
+
+	for (int i = 0; i < orientation.width; i++) {
+		highest = min(highest, tops[col + i]);
+	}
+
+	for (int i = 0; i < orientation.width; i++) {
+		profile = profile * (MAX_DEPTH + 1) + min(tops[col + i] - highest, (int)MAX_DEPTH);
+	}
+
+	return highest + orientation.landings[profile];
+}
+
+/*
+This function puts the placement of every drop of the shape into the output parameter, and returns false if the way to one of the drops is blocked
+(a longer way may lead there, so the board is left to the search).
+Each drop is moved straight to its landing row and locked with one step of the game, with the score of moving it to the bottom from where it was dropped.
+*/
+bool SurfacePlacementFinder::findDrops(Game& game, const GameState& start, const Shape& shape, const int tops[Board::COLS], vector<Placement>& placements) {
+	for (const Drop& drop : shape.drops) {
+		for (int row = drop.firstPathRow; row <= drop.lastPathRow; row++) {
+			if ((start.rowMasks[row] & drop.path[row]) != 0) {
+				return false;
+			}
+		}
+	}
+
+	for (const Drop& drop : shape.drops) {
+		int distance = this->getLandingRow(shape.orientations[drop.orientation], drop.col, tops) - drop.row;
+		GameState state = start;
+		bool isNewBoard = true;
+
+		if (distance < 0) {
+			return false;
+		}
+
+		for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+			state.blockSquares[i][0] = drop.blockSquares[i][0];
+			state.blockSquares[i][1] = (signed char)(drop.blockSquares[i][1] + distance);
+		}
+
+		state.blockRotatedAmount = drop.rotatedAmount;
+		state.score += distance * Game::MOVE_TO_BOTTOM_SCORE_MULTIPLIER;
+
+		game.loadState(state);
+		game.tick(Game::NO_ACTION); //The block cannot move down, so it is locked.
+		game.saveState(state);
+		this->stepsAmount++;
+
+		//Two drops lead to the same board only when full rows were removed, so the placements are compared directly.
+		for (size_t i = 0; i < placements.size() && isNewBoard; i++) {
+			if (memcmp(placements[i].state.rowMasks, state.rowMasks, sizeof(state.rowMasks)) == 0) {
+				isNewBoard = false;
+
+				if (state.score > placements[i].state.score) {
+					placements[i].state = state;
+					placements[i].actions = drop.actions;
+				}
+			}
+		}
+
+		if (isNewBoard) {
+			Placement placement;
+
+			placement.state = state;
+			placement.actions = drop.actions;
+			placements.push_back(placement);
+		}
+	}
+
+	return true;
+}
+
+/*
+This function receives the game to run the steps with and a state with a falling block, and puts every distinct placement of the block into the output parameter,
+the same placements PlacementFinder finds (the highest score of each board, with the shortest list of actions that leads to it).
+The given game is used for running the steps, so its state is changed.
+*/
+void SurfacePlacementFinder::findPlacements(Game& game, const GameState& start, vector<Placement>& placements) {
+	int tops[Board::COLS];
+	int shape;
+
+	placements.clear();
+
+	if (start.blockType == Game::NO_BLOCK || start.isFailed) {
+		return;
+	}
+
+	shape = this->findShape(start);
+
+	if (shape != -1 && getSurface(start.rowMasks, tops) && this->findDrops(game, start, this->shapes[shape], tops, placements)) {
+		this->surfaceSearches++;
+		return;
+	}
+
+	this->fallbackSearches++;
+	this->finder.findPlacements(game, start, placements);
+}
+
+/*
+This function returns how many searches were answered from the surface of the board.
+*/
+long long SurfacePlacementFinder::getSurfaceSearches() const {
+	return this->surfaceSearches;
+}
+
+/*
+This function returns how many searches were left to PlacementFinder.
+*/
+long long SurfacePlacementFinder::getFallbackSearches() const {
+	return this->fallbackSearches;
+}
+
+/*
+This function returns how many game steps were run by the searches so far (a step for each placement found from the surface, and the steps of the fallback searches).
+*/
+long long SurfacePlacementFinder::getStepsAmount() const {
+	return this->stepsAmount + this->finder.getStepsAmount();
+}
+
+/*
+This function returns how many drops the given shape has on an empty board.
+*/
+int SurfacePlacementFinder::getDropsAmount(BlocksGenerator::eBlockType blockType) const {
+	if (blockType >= BlocksGenerator::SHAPES_AMOUNT) {
+		return 0;
+	}
+
+	return (int)this->shapes[blockType].drops.size();
+}
\ No newline at end of file
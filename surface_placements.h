@@ -0,0 +1,80 @@
+#ifndef __SURFACE_PLACEMENTS_H
+#define __SURFACE_PLACEMENTS_H
+
+#include <vector>
+#include "placement_finder.h"
+using namespace std;
+
+/*
+Finds the placements of a block like PlacementFinder, but from the surface of the board (the top used square of each column) instead of running
+the game's steps for every position of the block.
+
+A block that is dropped lands according to the tops of the columns under it only, so the landing of each orientation of each shape is precomputed
+for every profile of the columns under it (relative to the highest of them). The orientations, the columns each of them can reach and the squares
+the block passes through on its way there are found once, by searching the moves of each shape on an empty board with the game itself.
+The placements of a board are then the drops whose way is free, each one locked with a single step of the game.
+
+This is exact only when no square of the board is free below a used square: the block can slide under an overhang into places that a drop cannot reach,
+and a way that is blocked may have a longer way around it. Such boards, jokers, bombs and blocks that were already moved are searched with PlacementFinder.
+*/
+class SurfacePlacementFinder {
+public:
+	constexpr static int MAX_DEPTH = BlocksGenerator::SHAPE_SIZE; //A column this deep below the highest column under the block cannot stop the block.
+	constexpr static int PROFILES_AMOUNT = 625; //(MAX_DEPTH + 1) to the power of the widest block.
+
+private:
+	//A shape of the block, as it lands.
+	struct Orientation {
+		signed char squares[BlocksGenerator::SHAPE_SIZE][2]; //The column and row of each square relative to the block's leftmost column and top row.
+		int width;
+		int bottoms[BlocksGenerator::SHAPE_SIZE]; //The row of the lowest square of each column of the block, relative to its top row.
+		signed char landings[PROFILES_AMOUNT]; //The top row of the landed block relative to the top of the highest column under it, for each profile.
+	};
+
+	//A column an orientation can be dropped at, and the shortest way to it from where the block is added.
+	struct Drop {
+		int orientation;
+		int col; //The leftmost column of the block.
+		int row; //The top row of the block when it is dropped.
+		signed char blockSquares[GameState::MAX_BLOCK_SQUARES][2]; //The block's squares when it is dropped (in the order the game keeps them).
+		unsigned char rotatedAmount;
+		unsigned short path[Board::ROWS]; //The squares the block passes through until it is dropped, as row masks.
+		int firstPathRow;
+		int lastPathRow;
+		vector<Game::eAction> actions; //The actions that lead to the drop, including the drop itself.
+	};
+
+	struct Shape {
+		signed char blockSquares[GameState::MAX_BLOCK_SQUARES][2]; //The block's squares when it is added to the board.
+		vector<Orientation> orientations;
+		vector<Drop> drops;
+	};
+
+	Shape shapes[BlocksGenerator::SHAPES_AMOUNT];
+	PlacementFinder finder; //The search for the boards the surface cannot handle.
+	long long surfaceSearches = 0;
+	long long fallbackSearches = 0;
+	long long stepsAmount = 0;
+
+	void prepareShape(Game& game, BlocksGenerator::eBlockType blockType);
+	int addOrientation(Shape& shape, const GameState& state);
+	void setPath(Game& game, const GameState& start, Drop& drop);
+
+	int findShape(const GameState& start) const;
+	int getLandingRow(const Orientation& orientation, int col, const int tops[Board::COLS]) const;
+	bool findDrops(Game& game, const GameState& start, const Shape& shape, const int tops[Board::COLS], vector<Placement>& placements);
+
+	static bool getSurface(const unsigned short rowMasks[Board::ROWS], int tops[Board::COLS]);
+
+public:
+	SurfacePlacementFinder();
+
+	void findPlacements(Game& game, const GameState& start, vector<Placement>& placements);
+
+	long long getSurfaceSearches() const;
+	long long getFallbackSearches() const;
+	long long getStepsAmount() const;
+	int getDropsAmount(BlocksGenerator::eBlockType blockType) const;
+};
+
+#endif
\ No newline at end of file
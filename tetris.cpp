@@ -1,10 +1,33 @@
 #include "tetris.h"
 
-Tetris::Tetris() {
+#pragma comment(lib, "winmm.lib") //For timeBeginPeriod.
+
+Tetris::Tetris() : session(game) {
 	changeConsoleSize(WINDOW_WIDTH, WINDOW_HEIGHT); //Changing the console's size to 450x550 px.
 
-	srand((unsigned int)time(NULL)); //Seeding the rand function so it doesn't give the same results for each game.
-	this->displayMenu();
+	timeBeginPeriod(TIMER_RESOLUTION); //The default resolution of the sleeps is about 15 miliseconds, which is too coarse for the game's steps.
+	srand((unsigned int)time(NULL)); //Seeding the rand function so each game gets a different seed for its blocks.
+	this->startRendering(); //From here on only the render thread writes to the console.
+	this->input.start();
+	this->loadRandomizerConfig();
+
+	if (!this->scores.open(SCORES_FILE_NAME, SCORES_INDEX_FILE_NAME)) {
+		this->showNotice("Cannot open the scores file, the scores will not be saved.");
+	}
+
+	this->stateExport.join(StateExport::DEFAULT_NAME, StateExport::DEFAULT_SLOTS); //The monitors are optional, so the game runs the same when the state cannot be exported.
+
+	this->run();
+}
+
+/*
+Destructor - stops the input and render threads and saves the trace (the scores index is saved by the scores' destructor).
+*/
+Tetris::~Tetris() {
+	this->input.stop();
+	this->stopRendering();
+	TRACE_SAVE(TRACE_FILE_NAME);
+	timeEndPeriod(TIMER_RESOLUTION);
 }
 
 /*
@@ -20,856 +43,600 @@ void Tetris::changeConsoleSize(int width, int height) {
 }
 
 /*
-Destructor - removes the current block from the memory.
+This function loads the settings of the blocks randomizer from the file, if there is one.
+If the file is invalid, the game's original mix of blocks is used and a notice explains the problem.
 */
-Tetris::~Tetris() {
-	delete this->currentBlock;
+void Tetris::loadRandomizerConfig() {
+	ifstream inFile(RANDOMIZER_FILE_NAME);
+	RandomizerConfig config;
+	string error;
+
+	if (!inFile.is_open()) { //There are no settings, so the original mix of blocks is used.
+		return;
+	}
+
+	inFile.close();
+
+	if (config.loadFromFile(RANDOMIZER_FILE_NAME, error)) {
+		RandomizerConfig::setCurrent(config);
+	}
+	else {
+		this->showNotice(error);
+	}
 }
 
 /*
-This function displays the game's menu and handles keypresses for the menu's actions.
+This function runs the game's menu and the games until the user exits.
+The game is a state machine: in the menu the thread sleeps until a keypress is made, and while a game is played it sleeps until a keypress is made
+or the next step of the game is due. Every keypress and step returns to this loop, so the stack does not grow with the games that are played.
 */
-void Tetris::displayMenu() {
-	gotoxy(0, 0); //Going to the start of the console.
+void Tetris::run() {
+	KeyEvent event;
 
-	cout << "Please select an option:" << endl;
-	cout << "1) Start game" << endl;
-	cout << "2) Pause / continue game" << endl;
-	cout << "3) Increase the speed" << endl;
-	cout << "4) Decrease the speed" << endl;
-	cout << "5) Save game" << endl;
-	cout << "6) Load game" << endl;
-	cout << "9) Exit" << endl;
+	this->updateFrame(); //Displaying the game's details such as score and amount of dropped blocks.
+
+	while (this->state != EXITING) {
+		if (this->state == PLAYING) {
+			this->resumeGame();
+		}
+		else {
+			this->input.waitForKey(event);
+			this->traceKey(event);
+			this->menuActionHandler(event.key);
+		}
+	}
+}
+
+/*
+This function changes the state of the game, and counts the time the game is played (without the time it was paused).
+When a game starts or continues, its next step is due one step after now.
+*/
+void Tetris::setState(eState state) {
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
 
-	this->displayGameDetails(); //Displaying the game's details such as score and amount of dropped blocks.
-	this->waitForMenuAction(); //Handling the keypresses by the user.
+	if (this->state == PLAYING && state != PLAYING) {
+		this->playTime += now - this->playStartTime;
+	}
+	else if (this->state != PLAYING && state == PLAYING) {
+		this->playStartTime = now;
+		this->session.schedule(now);
+	}
+
+	this->state = state;
+	this->exportState();
+}
+
+/*
+This function starts the render thread.
+*/
+void Tetris::startRendering() {
+	this->isRendering = true;
+	this->renderThread = thread(&Tetris::renderLoop, this);
 }
 
 /*
-This function handles the menu button presses received from the user using a given key that was pressed and a boolean value indicating whether the function
-was called from an ongoing game or from the waitForMenuAction function.
+This function stops the render thread after it has displayed the last published frame.
 */
-bool Tetris::menuActionHandler(char keyPressed, bool arrivedFromOngoingGame) {
-	if (!arrivedFromOngoingGame) {
+void Tetris::stopRendering() {
+	if (!this->renderThread.joinable()) {
+		return;
+	}
+
+	this->isRendering = false;
+	this->renderThread.join();
+}
+
+/*
+This function handles the menu button presses received from the user using a given key that was pressed.
+Some of the keys do different things while a game is played and while the menu is displayed.
+*/
+void Tetris::menuActionHandler(char keyPressed) {
+	if (this->state != PLAYING) {
 		if (keyPressed == GAME_START_KEY) {
 			this->startGame();
-			return true;
 		}
 		else if (keyPressed == GAME_PAUSE_KEY) {
 			this->continueGame();
-			return true;
 		}
 	}
-	else {
-		if (keyPressed == GAME_PAUSE_KEY) {
-			this->pauseGame();
-			return true;
-		}
+	else if (keyPressed == GAME_PAUSE_KEY) {
+		this->pauseGame();
 	}
 
 	if (keyPressed == GAME_INCREASE_SPEED_KEY) {
 		this->increaseSpeed(GAME_SPEED_CHANGE_AMOUNT);
-
-		return false;
 	}
 	else if (keyPressed == GAME_DECREASE_SPEED_KEY) {
 		this->decreaseSpeed(GAME_SPEED_CHANGE_AMOUNT);
-
-		return false;
 	}
 	else if (keyPressed == GAME_SAVE_KEY) {
-		if (this->isStarted || this->isFailed) {
+		if (this->isStarted || this->game.isGameOver()) {
 			this->saveToFile();
 			this->showNotice("The game has been saved.");
 		}
 		else {
 			this->showNotice("Cannot save a game that has not been started.");
 		}
-
-		return false;
 	}
 	else if (keyPressed == GAME_LOAD_KEY) {
-		this->loadFromFile();
-		this->paintBoard();
-
-		if (this->currentBlock != nullptr) {
-			this->currentBlock->paint();
-			this->isStarted = true;
-			this->isFailed = false;
-		}
-		else { //If the current block is null, then the game was saved after it was ended.
-			this->isStarted = false;
+		this->loadGame();
+	}
+	else if (keyPressed == UNDO_KEY || keyPressed == REDO_KEY) {
+		if (this->isStarted && !this->game.isGameOver()) { //Moves can be undone while the game is running or paused.
+			this->undoMove(keyPressed == REDO_KEY);
 		}
-
-		this->updateGameDetails();
-		this->showNotice("The game has been loaded from the file.");
-		this->gameEngine();
-
-		return true;
 	}
 	else if (keyPressed == GAME_EXIT_KEY) {
 		this->exitGame();
-		return true;
-	}
-
-	return false;
-}
-
-/*
-This function handles the keypresses made by the user when the game is paused / was not started.
-*/
-void Tetris::waitForMenuAction() {
-	char selectedOption = 0;
-
-	while (true) {
-		if (_kbhit()) { //Checking if a keypress was made and if so, getting the keypress.
-			selectedOption = _getch();
-
-			if (this->menuActionHandler(selectedOption, false)) {
-				break;
-			}
-
-			selectedOption = 0;
-		}
-
-		Sleep(MENU_WAIT_FOR_ACTION_DELAY); //Waiting some time so we do not overload the CPU.
 	}
 }
 
 /*
-This function exits the game.
+This function exits the game (the loop of the game ends, and the threads are stopped by the destructor).
 */
 void Tetris::exitGame() {
-	delete this->currentBlock;
-	this->currentBlock = nullptr;
-
-	exit(0);
+	this->setState(EXITING);
 }
 
 /*
-This function displays a notice that the game was ended and waits for a menu action.
+This function displays a notice that the game was ended and returns to the menu.
 This function is only called when the game has ended.
 */
 void Tetris::endGame() {
-	delete this->currentBlock;
-	this->currentBlock = nullptr;
-
-	this->showNotice("The game was ended.");
-	this->waitForMenuAction();
-}
-
-/*
-This function handles the keypresses made by the user and displays new blocks if the block reached the bottom of the board.
-This is the core of the game.
-*/
-void Tetris::gameEngine() {
-	this->drawBoundaries(); //Drawing the board's boundaries.
-
-	while (this->isStarted && !this->isFailed) { //Looping until the pause key was pressed or a block reached the end of the board.
-		if (this->currentBlock == nullptr) { //If the current block that is dropping is null, then the previous block has reached the bottom of the board / the game has just started.
-			this->addNewBlock(); //Adding a new block to the board.
-			this->updateGameDetails(); //Updating the amount of blocks dropped.
-		}
-		else {
-			char keyPressed = 0;
-			if (_kbhit()) { //Checking if there's any keypress in the buffer.
-				keyPressed = _getch(); //Getting the first keypress from the buffer.
-
-				this->removeKeypressFromBuffer(); //Removing the rest of the keypresses from the buffer.
-
-				if (keyPressed == MOVE_LEFT_KEY) {
-					checkAndExplode(keyPressed); //Checking if the current block is a bomb, and if so we should explode if possible.
-					this->moveBlockLeft(); //If the current block was a bomb and it has exploded, this function will not do anything.
-				}
-				else if (keyPressed == MOVE_DOWN_KEY) {
-					this->moveBlockToBottom();
-				}
-				else if (keyPressed == MOVE_RIGHT_KEY) {
-					checkAndExplode(keyPressed); //Checking if the current block is a bomb, and if so we should explode if possible.
-					this->moveBlockRight(); //If the current block was a bomb and it has exploded, this function will not do anything.
-				}
-				else if (keyPressed == ROTATE_RIGHT_KEY) {
-					this->rotateBlockRight();
-				}
-				else {
-					this->menuActionHandler(keyPressed, true);
-				}
-			}
-
-			checkAndExplode(); //Checking if the current block is a bomb, if it is and it hits a square beneath it, it will explode.
-
-			//If the joker pause key was pressed and the current block is a joker block, then we should pause it.
-			if (keyPressed == JOKER_PAUSE_KEY && this->currentBlock != nullptr && BlocksGenerator::isJoker(this->currentBlock)) {
-				vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-				vector<Point *>::iterator itr = blockLocations.begin();
-
-				this->setUsedPoints(); //Setting the joker's location in the usedPoints array.
-
-				//Checking if we should remove the row the joker paused at.
-				//If so, we should increase the score by 50.
-				if (this->checkAndRemoveRow(((*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y))) {
-					this->increaseScore(JOKER_LINE_REMOVED_SCORE); //Increasing the score by 50.
-					this->paintBoard(); //Painting the new board after the row was removed.
-					this->updateGameDetails(); //Updating the score that is displayed to the user.
-				}
-
-				delete this->currentBlock; //Deleting the current block from the memory since we don't need it anymore.
-				this->currentBlock = nullptr; //Setting the current block's pointer to null so we know we should add a new block.
-			}
-			else if (this->currentBlock != nullptr && this->canBlockMoveDown()) { //If the current block is not a joker / the joker key was not pressed and it can move down, we should move the block down in the console.
-				this->moveBlockDown();
-			}
-			else if (this->currentBlock != nullptr) { //Checking if we still have a block in the instance (it may have been removed if it was a bomb and it has exploded).
-				int removed = 0; //Indicating how many rows we have removed (if any).
-
-				vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-				vector<Point *>::iterator itr = blockLocations.begin();
-				vector<Point *>::iterator itrEnd = blockLocations.end();
-
-				//Looping through each square in the block and checking if it fills a row and if it does, we remove it.
-				for (; itr != itrEnd; ++itr) {
-					if (this->checkAndRemoveRow(((*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y))) {
-						removed++;
-					}
-				}
+	this->setState(IN_MENU);
 
-				//Checking how many rows we have removed.
-				switch (removed) {
-				case 1: //If we removed 1 row, we should check if it was removed by a joker or not because it affects the score.
-					if (BlocksGenerator::isJoker(this->currentBlock)) {
-						this->increaseScore(JOKER_LINE_REMOVED_SCORE);
-					}
-					else {
-						this->increaseScore(LINES_REMOVED_SCORE_1);
-					}
-
-					break;
-				case 2:
-					this->increaseScore(LINES_REMOVED_SCORE_2);
-					break;
-				case 3:
-					this->increaseScore(LINES_REMOVED_SCORE_3);
-					break;
-				case 4:
-					this->increaseScore(LINES_REMOVED_SCORE_4);
-					break;
-				}
-
-				//If we removed at least one row, we should update the console's board and the displayed score.
-				if (removed) {
-					this->paintBoard();
-					this->updateGameDetails();
-				}
-
-				delete this->currentBlock; //Deleting the current block from the memory since we don't need it anymore.
-				this->currentBlock = nullptr; //Setting the current block's pointer to null so we know we should add a new block.
-			}
-		}
-
-		Sleep(this->speed);
+	if (this->game.isGameOver() && !this->isScoreRecorded) {
+		this->recordScore();
+	}
+	else {
+		this->showNotice("The game was ended.");
 	}
-
-	this->endGame(); //The game has ended so we should call the end game function.
 }
 
 /*
-This function starts a new game.
+This function adds the score of the game that has just ended to the scores, and displays its place among all of the games.
 */
-void Tetris::startGame() {
-	this->clearBoard(); //Clearing the board from the previous game.
-	this->setScore(0); //Resetting the score.
-	this->setBlocksDropped(0); //Resetting the amount of blocks dropped.
-	this->showNotice(""); //Resetting the notice.
+void Tetris::recordScore() {
+	ScoreRecord record;
 
-	this->isStarted = true; //Indicating that the game has started.
-	this->isFailed = false; //Indicating that the game was not failed yet.
+	record.score = this->game.getScore();
+	record.blocksDropped = this->game.getNumOfBlocks();
+	record.durationSeconds = (unsigned int)chrono::duration_cast<chrono::seconds>(this->playTime).count();
+	record.seed = this->game.getNextBlocks().getSeed();
+	record.speed = this->game.getSpeed();
+	record.finishedAt = (long long)time(NULL);
 
-	this->gameEngine();
-}
+	this->isScoreRecorded = true;
 
-/*
-This function displays a notice that the game was paused and waits for a menu action.
-This function is only called when the game was paused.
-*/
-void Tetris::pauseGame() {
-	this->showNotice("The game was paused.");
-	this->waitForMenuAction();
+	if (this->scores.append(record)) {
+		this->updateFrame(); //Displaying the new best score (if it is).
+		this->showNotice("The game was ended. Place " + to_string(this->scores.getRank(record.score)) + " of " + to_string(this->scores.getRecordsAmount()) + ".");
+	}
+	else {
+		this->showNotice("The game was ended. The score could not be saved.");
+	}
 }
 
 /*
-This function clears the game paused notice.
-This function is only called when the continue game keypress was made.
+This function runs the game once: it handles the keypresses that were made, runs the game's steps that are due and publishes a frame of the game
+to the render thread (so a slow console does not delay the game's steps), then waits until a keypress is made or the next step is due.
 */
-void Tetris::continueGame() {
-	this->showNotice("");
-}
+void Tetris::resumeGame() {
+	int stepsAmount;
 
-/*
-This function returns whether the current block can move down by 1 square.
-*/
-bool Tetris::canBlockMoveDown() {
-	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
-		return false;
+	{
+		TRACE_ZONE("input");
+		this->handleKeys();
 	}
 
-	const vector<Point *> points = this->currentBlock->getBlockLocations();
-	vector<Point *>::const_iterator itr = points.begin();
-	Point *p;
-
-	if (BlocksGenerator::isJoker(this->currentBlock)) {
-		p = *itr;
-		int pX = p->getX();
-		int pY = p->getY();
-
-		//Checking if the joker has room anywehre in the same column it's moving down at.
-		for (int movedPosition = pY - Point::GAME_LOCATION_OFFSET_Y + 1; movedPosition < ROWS; movedPosition++) {
-			if (this->usedPoints[movedPosition][pX - Point::GAME_LOCATION_OFFSET_X] == 0) {
-				return true;
-			}
-		}
-
-		//Setting the current's block location in the usedPoints array so we know the room was filled there because it cannot move down.
-		this->setUsedPoints();
-		return false;
+	if (this->state != PLAYING) { //The game was paused or exited by a menu keypress.
+		return;
 	}
 
-	vector<Point *>::const_iterator itrEnd = points.end();
+	int blocksDropped = this->game.getNumOfBlocks();
 
-	//If the block is not a joker, we handle it normally.
-	for (; itr != itrEnd; ++itr) {
-		p = *itr;
+	{
+		TRACE_ZONE("tick");
+		chrono::steady_clock::time_point now = chrono::steady_clock::now();
 
-		if (p->getY() == ROWS + Point::GAME_LOCATION_OFFSET_Y - 1) { //Checking if the block reached the end of the board.
-			//Setting the current's block locations in the usedPoints array so we know the room was filled there because it cannot move down.
-			this->setUsedPoints();
-			return false;
+		if (now >= this->session.getNextStepTime()) {
+			TRACE_COUNTER_ADD(STEP_LATENESS_US, chrono::duration_cast<chrono::microseconds>(now - this->session.getNextStepTime()).count());
 		}
 
-		if (this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y + 1][p->getX() - Point::GAME_LOCATION_OFFSET_X] != 0) { //Checking if there is a part of another block beneath the current block.
-			//Setting the current's block locations in the usedPoints array so we know the room was filled there because it cannot move down.
-			this->setUsedPoints();
-			return false;
-		}
+		stepsAmount = this->session.resume(now);
+		this->stepsRun += stepsAmount;
 	}
 
-	return true;
-}
+	if (this->game.getNumOfBlocks() != blocksDropped) { //Saving the state at the moment each block is added, so the player can go back to it.
+		GameState state;
 
-/*
-This function returns whether the current block can move right.
-*/
-bool Tetris::canBlockMoveRight() {
-	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
-		return false;
+		this->game.saveState(state);
+		this->history.record(state);
 	}
 
-	//If the current block is a joker, we assume it can move right because we handle it in the moveBlockRight method instead (to avoid code duplication).
-	if (BlocksGenerator::isJoker(this->currentBlock)) {
-		return true;
+	{
+		TRACE_ZONE("publish");
+		this->updateFrame();
 	}
 
-	const vector<Point *> points = this->currentBlock->getBlockLocations();
-	vector<Point *>::const_iterator itr = points.begin();
-	vector<Point *>::const_iterator itrEnd = points.end();
-	Point *p;
+	if (stepsAmount > 0) {
+		TRACE_COUNTER_ADD(TICKS, stepsAmount);
+		TRACE_SAMPLE_COUNTERS();
+	}
 
-	for (; itr != itrEnd; ++itr) {
-		p = *itr;
+	if (this->game.isGameOver()) {
+		this->endGame();
+		return;
+	}
 
-		if (p->getX() - Point::GAME_LOCATION_OFFSET_X == COLS - 1) { //Checking if the block reached the end of the board.
-			return false;
-		}
+	TRACE_ZONE("wait");
+	KeyEvent event;
 
-		if (this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y][p->getX() - Point::GAME_LOCATION_OFFSET_X + 1] != 0) { //Checking if there is a part of another block to the right of the current block.
-			return false;
-		}
+	if (this->input.peekKey(event)) { //The session has no room for more moves until the next step.
+		this_thread::sleep_until(this->session.getNextStepTime());
+	}
+	else {
+		this->input.waitForKeyUntil(this->session.getNextStepTime());
 	}
-
-	return true;
 }
 
 /*
-This function returns whether the current block can move left.
+This function receives a keypress made by the user and returns the game action it represents (or NO_ACTION if it is not a game action).
 */
-bool Tetris::canBlockMoveLeft() {
-	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
-		return false;
-	}
-
-	//If the current block is a joker, we assume it can move right because we handle it in the moveBlockRight method instead (to avoid code duplication).
-	if (BlocksGenerator::isJoker(this->currentBlock)) {
-		return true;
-	}
-
-	const vector<Point *> points = this->currentBlock->getBlockLocations();
-	vector<Point *>::const_iterator itr = points.begin();
-	vector<Point *>::const_iterator itrEnd = points.end();
-	Point *p;
-
-	for (; itr != itrEnd; ++itr) {
-		p = *itr;
-
-		if (p->getX() == Point::GAME_LOCATION_OFFSET_X) { //Checking if the block reached the end of the board.
-			return false;
-		}
-
-		if (this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y][p->getX() - Point::GAME_LOCATION_OFFSET_X - 1] != 0) { //Checking if there is a part of another block to the left of the current block.
-			return false;
-		}
+Game::eAction Tetris::getActionFromKey(char keyPressed) const {
+	switch (keyPressed) {
+	case MOVE_LEFT_KEY:
+		return Game::MOVE_LEFT;
+	case MOVE_DOWN_KEY:
+		return Game::MOVE_DOWN;
+	case MOVE_RIGHT_KEY:
+		return Game::MOVE_RIGHT;
+	case ROTATE_RIGHT_KEY:
+		return Game::ROTATE_RIGHT;
+	case JOKER_PAUSE_KEY:
+		return Game::JOKER_PAUSE;
 	}
 
-	return true;
+	return Game::NO_ACTION;
 }
 
 /*
-This function receives an output parameter which is an array of rotated points of the current block 
-and returns whether any of the rotated squares is overlapping an existing square in the board.
+This function handles all of the keypresses that were made while a game is played, in the order they were made.
+The game actions are passed to the game's session, and a menu keypress is handled after the session has made the moves that were made before it.
+A keypress that the session has no room for stays in the queue until the next step.
 */
-bool Tetris::canBlockRotateRight() {
-	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
-		return false;
-	}
-
-	//If the current block is not a line, then we cannot rotate it (because the other shapes cannot rotate).
-	if (!this->currentBlock->isRotateable()) {
-		return false;
-	}
+void Tetris::handleKeys() {
+	KeyEvent event;
 
-	vector<Point *> rotatedPoints = this->currentBlock->getRotatedPosition();
-	vector<Point *>::iterator itr = rotatedPoints.begin();
-	vector<Point *>::iterator itrEnd = rotatedPoints.end();
-	bool ret = true;
+	while (this->state == PLAYING && this->input.peekKey(event)) {
+		Game::eAction action = this->getActionFromKey(event.key);
 
-	//Checking if any square of the rotated block is not in a legal location.
-	for (; itr != itrEnd && ret; ++itr) {
-		Point *p = *itr;
-
-		if (p->getY() > ROWS + Point::GAME_LOCATION_OFFSET_Y - 1) { //Checking if the current square reached beyond the bottom of the board.
-			ret = false;
-		}
-		else if (p->getX() < Point::GAME_LOCATION_OFFSET_X) { //Checking if the current square reached beyond the left side of the board.
-			ret = false;
+		if (action == Game::NO_ACTION) { //A menu keypress (or a key with no action).
+			this->session.applyActions();
+			this->input.getKey(event);
+			this->traceKey(event);
+			this->menuActionHandler(event.key);
 		}
-		else if (p->getX() > COLS + Point::GAME_LOCATION_OFFSET_X - 1) { //Checking if the current square reached beyond the right of the board.
-			ret = false;
+		else if (this->session.pushAction(action)) {
+			this->input.getKey(event);
+			this->traceKey(event);
 		}
-		else if (this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y][p->getX() - Point::GAME_LOCATION_OFFSET_X] != 0) { //Checking if the current square is overlapping an existing square in the board.
-			ret = false;
+		else {
+			break;
 		}
 	}
-
-	Block::clearVectorOfDynamicPoints(rotatedPoints);
-
-	return ret;
 }
 
 /*
-This function moves the current block down by 1 square.
+This function records the time that passed since the given keypress was made (only when the game is built with TETRIS_TRACE).
 */
-void Tetris::moveBlockDown() {
-	if (this->currentBlock == nullptr) { //Checking that the current block exists and it was not removed in a previous method.
-		return;
-	}
-
-	this->currentBlock->removeBlockFromConsole(); //Removing the block from the console since we are going to paint it 1 square down from its current position.
-	vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-	vector<Point *>::iterator itr = blockLocations.begin();
-
-	if (BlocksGenerator::isJoker(this->currentBlock)) { //If the current block is a joker, we should try to find the first position it can fit into.
-		Point *p = *itr;
-
-		for (int movedPosition = p->getY() - Point::GAME_LOCATION_OFFSET_Y + 1; movedPosition < ROWS; movedPosition++) {
-			if (this->usedPoints[movedPosition][p->getX() - Point::GAME_LOCATION_OFFSET_X] == 0) {
-				p->setY(movedPosition + Point::GAME_LOCATION_OFFSET_Y);
-				break;
-			}
-		}
-	}
-	else { //Moving all of the block's locations 1 square down.
-		vector<Point *>::iterator itrEnd = blockLocations.end();
-
-		for (; itr != itrEnd; ++itr) {
-			(*itr)->setY((*itr)->getY() + 1);
-		}
-
-		this->currentBlock->updateBlockProperties();
-	}
-
-	//Painting the updated block to the console.
-	this->currentBlock->paint();
+void Tetris::traceKey(const KeyEvent& event) const {
+	TRACE_COUNTER_ADD(KEYS_HANDLED, 1);
+	TRACE_COUNTER_ADD(INPUT_DELAY_US, chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - event.time).count());
 }
 
 /*
-This function moves the current block 1 square to the right.
+This function starts a new game.
 */
-void Tetris::moveBlockRight() {
-	if (!this->canBlockMoveRight()) { //Validating that the block can move right before we move it.
-		return;
-	}
-
-	this->currentBlock->removeBlockFromConsole(); //Removing the block from the console since we are going to paint it 1 square right from its current position.
-	vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-	vector<Point *>::iterator itr = blockLocations.begin();
-
-	//If the current block is a joker, we should try to find the first position it can fit into.
-	if (BlocksGenerator::isJoker(this->currentBlock)) {
-		Point *p = *itr;
-
-		int pX = p->getX();
-		int pY = p->getY();
-
-		for (int movedPosition = pX - Point::GAME_LOCATION_OFFSET_X + 1; movedPosition < COLS; movedPosition++) {
-			if (this->usedPoints[pY - Point::GAME_LOCATION_OFFSET_Y][movedPosition] == 0) {
-				p->setX(movedPosition + Point::GAME_LOCATION_OFFSET_X);
-				break;
-			}
-		}
-	}
-	else { //If the current block is not a joker, we should move all of its squares 1 square to the right.
-		vector<Point *>::iterator itrEnd = blockLocations.end();
-
-		for (; itr != itrEnd; ++itr) {
-			(*itr)->setX((*itr)->getX() + 1);
-		}
+void Tetris::startGame() {
+	this->session.cancelActions();
+	this->game.start(this->getNewGameSeed()); //Clearing the board and the score from the previous game and generating the blocks of the new game.
+	this->history.clear();
+	this->playTime = chrono::steady_clock::duration::zero();
+	this->isScoreRecorded = false;
+	this->isStarted = true; //Indicating that the game has started.
+	this->gamesPlayed++;
 
-		this->currentBlock->updateBlockProperties();
-	}
+	this->frame.isBoardVisible = true; //Displaying the board's boundaries and the upcoming blocks.
+	this->updateFrame(); //Removing the previous game's squares from the console.
+	this->showNotice(""); //Resetting the notice.
 
-	//Painting the updated block to the console.
-	this->currentBlock->paint();
+	this->setState(PLAYING);
 }
 
 /*
-This function moves the current block 1 square to the right.
+This function loads the game from the file and continues it (or, if the game was saved after it was ended, displays that it was ended).
 */
-void Tetris::moveBlockLeft() {
-	if (!this->canBlockMoveLeft()) { //Validating that the block can move right before we move it.
-		return;
-	}
+void Tetris::loadGame() {
+	this->setState(IN_MENU); //Counting the time of the current game before it is replaced.
+	this->session.cancelActions();
+	this->loadFromFile();
 
-	this->currentBlock->removeBlockFromConsole(); //Removing the block from the console since we are going to paint it 1 square left from its current position.
-	vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-	vector<Point *>::iterator itr = blockLocations.begin();
-	
-	//If the current block is a joker, we should try to find the first position it can fit into.
-	if (BlocksGenerator::isJoker(this->currentBlock)) {
-		int pX = (*itr)->getX();
-		int pY = (*itr)->getY();
-
-		for (int movedPosition = pX - Point::GAME_LOCATION_OFFSET_X - 1; movedPosition >= 0; movedPosition--) {
-			if (this->usedPoints[pY - Point::GAME_LOCATION_OFFSET_Y][movedPosition] == 0) {
-				(*itr)->setX(movedPosition + Point::GAME_LOCATION_OFFSET_X);
-				break;
-			}
-		}
-	}
-	else { //If the current block is not a joker, we should move all of its squares 1 square to the left.
-		vector<Point *>::iterator itrEnd = blockLocations.end();
+	this->isStarted = (this->game.getCurrentBlock() != nullptr); //If the current block is null, then the game was saved after it was ended.
+	this->history.clear(); //The moves of the previous game cannot be undone in the loaded game.
+	this->playTime = chrono::steady_clock::duration::zero(); //The time is not saved in the file.
+	this->isScoreRecorded = !this->isStarted; //A game that was saved after it ended (it has no current block) was already added to the scores.
 
-		for (; itr != itrEnd; ++itr) {
-			(*itr)->setX((*itr)->getX() - 1);
-		}
+	this->frame.isBoardVisible = true;
+	this->updateFrame();
+	this->showNotice("The game has been loaded from the file.");
 
-		this->currentBlock->updateBlockProperties();
+	if (this->isStarted && !this->game.isGameOver()) {
+		this->setState(PLAYING);
 	}
-
-	//Painting the updated block to the console.
-	this->currentBlock->paint();
-}
-
-/*
-This function rotates the current block to the right if possible.
-*/
-void Tetris::rotateBlockRight() {
-	if (!this->canBlockRotateRight()) { //Checking if the current block can be rotated to the right.
-		return;
+	else {
+		this->endGame();
 	}
-
-	this->currentBlock->removeBlockFromConsole(); //Removing the block from the console.
-	this->currentBlock->rotateRight(); //Rotating the block to the right.
-	this->currentBlock->paint(); //Painting the updated block to the console.
 }
 
 /*
-This function moves the current block to the last available position at the bottom of the board and increases the score for each square moved.
+This function displays a notice that the game was paused and returns to the menu.
+This function is only called when the game was paused.
 */
-void Tetris::moveBlockToBottom() {
-	int counter = 0;
-
-	while (this->canBlockMoveDown()) {
-		this->moveBlockDown();
-		counter++;
-	}
-
-	this->increaseScore(counter * MOVE_TO_BOTTOM_SCORE_MULTIPLIER);
+void Tetris::pauseGame() {
+	this->setState(IN_MENU);
+	this->showNotice("The game was paused.");
 }
 
 /*
-This function randomly adds a new block to the top of the board and sets it as the current block.
+This function clears the game paused notice and continues the game (if there is a game that can be continued).
+This function is only called when the continue game keypress was made.
 */
-void Tetris::addNewBlock() {
-	int randNum = (rand() % 100) + 1; //Calculating a number between 1 and 100.
-
-	this->currentBlock = BlocksGenerator::getRandomBlock();
-
-	const vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-	vector<Point *>::const_iterator itr = blockLocations.begin();
-	vector<Point *>::const_iterator itrEnd = blockLocations.end();
-
-	//Checking if we have created the block on top of another block and if so we should indicate the game has ended (using the isFailed property).
-	for (; itr != itrEnd; ++itr) {
-		Point *p = *itr;
+void Tetris::continueGame() {
+	this->showNotice("");
 
-		if (this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y][p->getX() - Point::GAME_LOCATION_OFFSET_X] != 0) {
-			this->isFailed = true;
-			return;
-		}
+	if (this->isStarted && !this->game.isGameOver()) {
+		this->setState(PLAYING);
 	}
-
-	this->currentBlock->paint(); //Painting the new block to the console.
-	this->increaseNumOfBlocks(); //Increasing the number of blocks used.
 }
 
 /*
-This function receives a parameter score and sets the game's score to the given parameter.
+This function returns a random seed for the blocks of a new game.
 */
-void Tetris::setScore(int score) {
-	this->score = score;
+unsigned int Tetris::getNewGameSeed() const {
+	return ((unsigned int)rand() << 16) ^ (unsigned int)rand();
 }
 
 /*
-This function receives a parameter score and increases the game's score by the given parameter.
+This function receives a parameter speed and increases the game's speed by the given parameter as long as the speed after the change is not faster than 100 miliseconds.
 */
-void Tetris::increaseScore(int score) {
-	this->score += score;
+void Tetris::increaseSpeed(int speed) {
+	if (this->game.getSpeed() - speed >= MAXIMUM_SPEED) {
+		this->game.setSpeed(this->game.getSpeed() - speed);
+		this->showNotice("The speed has been increased.");
+	}
+	else {
+		this->showNotice("The speed has reached the maximum speed.");
+	}
 }
 
 /*
-This function receives a parameter score and decreases the game's score by the given parameter.
+This function returns the game to the moment the previous block was added (or, if isRedo is true, to the moment the next block was added after an undo).
+The game's speed is not changed.
 */
-void Tetris::decreaseScore(int score) {
-	this->score -= score;
+void Tetris::undoMove(bool isRedo) {
+	GameState state;
+	bool isChanged = isRedo ? this->history.redo(state) : this->history.undo(state);
 
-	if (this->score < 0) {
-		this->score = 0;
+	if (!isChanged) {
+		this->showNotice(isRedo ? "There is no move to redo." : "There is no move to undo.");
+		return;
 	}
-}
 
-/*
-This function receives a parameter blocksDropped and sets the game's amount of blocks dropped to the given parameter.
-*/
-void Tetris::setBlocksDropped(int blocksDropped) {
-	this->blocksDropped = blocksDropped;
-}
+	this->session.cancelActions(); //The moves that were not made yet were meant for the current state.
+	this->game.loadState(state);
 
-/*
-This function increases the number of blocks dropped by 1.
-*/
-void Tetris::increaseNumOfBlocks() {
-	this->blocksDropped++;
+	this->updateFrame();
+	this->showNotice(isRedo ? "The move has been redone." : "The move has been undone.");
 }
 
 /*
-This function takes the usedPoints array and displaying the board according to the filled usedPoints.
+This function receives a parameter speed and decreases the game's speed by the given parameter.
 */
-void Tetris::paintBoard() {
-	for (int i = 0; i < ROWS; i++) {
-		gotoxy(Point::GAME_LOCATION_OFFSET_X, i + Point::GAME_LOCATION_OFFSET_Y);
-
-		for (int j = 0; j < COLS; j++) {
-			if (this->usedPoints[i][j] != 0) {
-				cout << Block::NORMAL_SQUARE_CHAR;
-			}
-			else {
-				cout << " ";
-			}
-		}
-	}
+void Tetris::decreaseSpeed(int speed) {
+	this->game.setSpeed(this->game.getSpeed() + speed);
+	this->showNotice("The speed has been decreased.");
 }
 
 /*
-This function resets the usedPoints array and removes the squares from the console.
+This function fills the frame with the current board, upcoming blocks and game's details, and publishes it to the render thread.
+The notice and whether the board is visible are kept from the previous frame.
 */
-void Tetris::clearBoard() {
-	for (int i = 0; i < ROWS; i++) {
-		gotoxy(Point::GAME_LOCATION_OFFSET_X, i + Point::GAME_LOCATION_OFFSET_Y);
+void Tetris::updateFrame() {
+	this->game.buildFrame(this->frame.squares);
 
-		for (int j = 0; j < COLS; j++) {
-			cout << " ";
-			this->usedPoints[i][j] = 0;
-		}
+	for (int i = 0; i < PREVIEW_BLOCKS_AMOUNT; i++) {
+		this->frame.nextBlocks[i] = this->game.getNextBlocks().peek(i);
 	}
 
-	delete this->currentBlock;
-	this->currentBlock = nullptr;
+	this->frame.score = this->game.getScore();
+	this->frame.blocksDropped = this->game.getNumOfBlocks();
+	this->frame.hasBestScore = this->scores.getBestScore(this->frame.bestScore);
+	this->frame.gameAllocations = this->game.getGameAllocations();
+	this->frame.tickAllocations = this->game.getLastTickAllocations();
+
+	this->publishFrame();
+	this->exportState();
 }
 
 /*
-This function receives a block and sets the usedPoints array used locations according to the received block's locations in the console.
-This function is called when the block should pause (when it doesn't move any further).
+This function writes the game's state to the shared memory segment, for the monitors.
+It only copies the state, so the game's thread never waits for the monitors.
 */
-void Tetris::setUsedPoints() {
-	const vector<Point *> points = this->currentBlock->getBlockLocations();
-	vector<Point *>::const_iterator itr = points.begin();
-	vector<Point *>::const_iterator itrEnd = points.end();
-
-	for (; itr != itrEnd; ++itr) {
-		Point *p = *itr;
-
-		this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y][p->getX() - Point::GAME_LOCATION_OFFSET_X] = 1;
+void Tetris::exportState() {
+	if (!this->stateExport.isOpen()) {
+		return;
 	}
-}
 
-/*
-This function receives a parameter speed and sets the game's speed according to the given parameter.
-*/
-void Tetris::setSpeed(int speed) {
-	this->speed = speed;
-}
+	ExportedState exported;
 
-/*
-This function receives a parameter speed and increases the game's speed by the given parameter as long as the speed after the change is not faster than 100 miliseconds.
-*/
-void Tetris::increaseSpeed(int speed) {
-	if (this->speed - speed >= MAXIMUM_SPEED) {
-		this->speed -= speed;
-		this->showNotice("The speed has been increased.");
-	}
-	else {
-		this->showNotice("The speed has reached the maximum speed.");
+	exported.processId = StateExport::getProcessId();
+	exported.status = this->game.isGameOver() ? ExportedState::GAME_OVER : (this->state == PLAYING ? ExportedState::PLAYING : ExportedState::IN_MENU);
+	exported.score = this->game.getScore();
+	exported.blocksDropped = this->game.getNumOfBlocks();
+	exported.speed = this->game.getSpeed();
+	exported.steps = this->stepsRun;
+	exported.gamesPlayed = this->gamesPlayed;
+	exported.updatedAt = StateExport::getTime();
+
+	for (int i = 0; i < ROWS; i++) {
+		exported.rowMasks[i] = this->game.getBoard().getRowMask(i);
 	}
-}
 
-/*
-This function receives a parameter speed and decreases the game's speed by the given parameter.
-*/
-void Tetris::decreaseSpeed(int speed) {
-	this->speed += speed;
-	this->showNotice("The speed has been decreased.");
+	this->stateExport.publish(this->stateExport.getJoinedSlot(), exported); //Other games may export to the other slots of the segment.
 }
 
 /*
-This function returns the current game's score.
+This function publishes a copy of the frame to the render thread.
+The game's thread never waits for the render thread: if the previous frame was not displayed yet, it is replaced by this one.
 */
-int Tetris::getScore() const {
-	return this->score;
+void Tetris::publishFrame() {
+	this->frame.number++;
+	this->frames.getBackBuffer() = this->frame;
+	this->frames.publish();
 }
 
 /*
-This function returns the current game's amount of blocks dropped.
+This function displays a notice for the user (for example: when the game was paused or the game's speed has increased).
 */
-int Tetris::getNumOfBlocks() const {
-	return this->blocksDropped;
-}
+void Tetris::showNotice(const string& notice) {
+	size_t length = min(notice.length(), (size_t)Frame::NOTICE_SIZE - 1);
 
-/*
-This function receives a row index, checks if it's full and if it is - removes it from the usedPoints array.
-*/
-bool Tetris::checkAndRemoveRow(int row) {
-	for (int i = 0; i < COLS; i++) {
-		if (usedPoints[row][i] == 0) {
-			return false;
-		}
-	}
+	memcpy(this->frame.notice, notice.c_str(), length);
+	this->frame.notice[length] = '\0';
 
-	removeRow(row);
-	
-	return true;
+	this->publishFrame();
 }
 
 /*
-This function receives a row index and removes it from the usedPoints array.
+This function runs on the render thread and displays the newest published frame whenever there is one, until the rendering is stopped.
+Frames that were published while the previous frame was being displayed are skipped, and only what changed since the displayed frame is written to the console.
 */
-void Tetris::removeRow(int row) {
-	for (int i = row; i > 0; i--) {		
-		for (int j = 0; j < COLS; j++) {
-			this->usedPoints[i][j] = this->usedPoints[i - 1][j];
+void Tetris::renderLoop() {
+	this->drawMenu();
+
+	while (this->isRendering) {
+		if (this->frames.update()) {
+			this->renderFrame(this->frames.getFrontBuffer());
+		}
+		else {
+			Sleep(RENDER_WAIT_FOR_FRAME_DELAY);
 		}
 	}
-	
-	//Clearing the top row in the board since it cannot be full and we do not accomplish that in the previous loop.
-	for (int j = 0; j < COLS; j++) {
-		this->usedPoints[0][j] = 0;
+
+	if (this->frames.update()) { //Displaying the frame that was published last before the rendering was stopped.
+		this->renderFrame(this->frames.getFrontBuffer());
 	}
 }
 
-
 /*
-This function receives a keypress made by the user (or 0 if a keypress was not made), checks if the current block is a bomb
-and if it is, checks whether it should explode and if so - it explodes.
+This function displays the parts of the given frame that differ from the frame that is currently displayed.
 */
-void Tetris::checkAndExplode(char keyPressed) {
-	if (this->currentBlock == nullptr || !BlocksGenerator::isBomb(this->currentBlock)) //Checking that the current block exists and that it is a bomb.
-		return;
+void Tetris::renderFrame(const Frame& frame) {
+	TRACE_ZONE("render");
+	bool isFirstFrame = !this->isFrameRendered;
+	bool isBoardShown = frame.isBoardVisible && (isFirstFrame || !this->renderedFrame.isBoardVisible);
 
-	vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-	vector<Point *>::iterator itr = blockLocations.begin();
+	if (!isFirstFrame) {
+		TRACE_COUNTER_ADD(FRAMES_SKIPPED, frame.number - this->renderedFrame.number - 1);
+	}
 
-	Point *p = *itr; //Getting the bomb's location.
+	if (isBoardShown) {
+		this->drawBoundaries();
+	}
 
-	if (keyPressed == 0) { //If the user did not make any keypress we should check if the bomb touches a square beneath it.
-		if (p->getY() - Point::GAME_LOCATION_OFFSET_Y == ROWS - 1) { //If the bomb reached the end of the board, we should remove it from the board.
-			this->usedPoints[ROWS - 1][p->getX() - Point::GAME_LOCATION_OFFSET_X] = 0;
-			gotoxy(p->getX(), p->getY());
-			cout << " ";
+	if (frame.isBoardVisible) {
+		this->renderer.render(frame.squares); //Only the squares that were changed since the displayed frame are painted.
 
-			delete this->currentBlock;
-			this->currentBlock = nullptr;
-		}
-		//Checking if the bomb is touching a square beneath it and if so - explode.
-		else if (p->getY() - Point::GAME_LOCATION_OFFSET_Y >= 0 && this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y + 1][p->getX() - Point::GAME_LOCATION_OFFSET_X] != 0) { //Checking if there is a part of another block beneath the current block.
-			this->explode(*p);
+		if (isBoardShown || memcmp(frame.nextBlocks, this->renderedFrame.nextBlocks, sizeof(frame.nextBlocks)) != 0) {
+			this->drawNextBlocks(frame);
 		}
 	}
-	else if (keyPressed == MOVE_LEFT_KEY) { //If the user pressed on the move left key, we should check whether the bomb touches a square to its left and if so - explode.
-		if (p->getX() - Point::GAME_LOCATION_OFFSET_X > 0 && this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y][p->getX() - Point::GAME_LOCATION_OFFSET_X - 1] != 0) {
-			this->explode(*p);
-		}
+
+	if (isFirstFrame || frame.score != this->renderedFrame.score || frame.blocksDropped != this->renderedFrame.blocksDropped
+		|| frame.hasBestScore != this->renderedFrame.hasBestScore || frame.bestScore != this->renderedFrame.bestScore
+		|| memcmp(&frame.gameAllocations, &this->renderedFrame.gameAllocations, sizeof(AllocationCounts)) != 0) {
+		this->drawGameDetails(frame);
 	}
-	else if (keyPressed == MOVE_RIGHT_KEY) { //If the user pressed on the move right key, we should check whether the bomb touches a square to its right and if so - explode.
-		if (p->getX() - Point::GAME_LOCATION_OFFSET_X < COLS - 1 && this->usedPoints[p->getY() - Point::GAME_LOCATION_OFFSET_Y][p->getX() - Point::GAME_LOCATION_OFFSET_X + 1] != 0) {
-			this->explode(*p);
-		}
+
+	if (isFirstFrame || strcmp(frame.notice, this->renderedFrame.notice) != 0) {
+		this->drawNotice(frame);
 	}
+
+	this->renderedFrame = frame;
+	this->isFrameRendered = true;
 }
 
 /*
-This function receives a location in the console, and removes all squares in 3x3 range around it.
+This function draws the game's menu and the title of the game's details.
 */
-void Tetris::explode(Point p) {
-	int startX, startY;
-	int amountJumpX = 3;
-	int amountJumpY = 3;
+void Tetris::drawMenu() const {
+	gotoxy(0, 0); //Going to the start of the console.
 
-	startX = p.getX() - Point::GAME_LOCATION_OFFSET_X - 1;
-	startY = p.getY() - Point::GAME_LOCATION_OFFSET_Y - 1;
+	cout << "Please select an option:" << endl;
+	cout << "1) Start game" << endl;
+	cout << "2) Pause / continue game" << endl;
+	cout << "3) Increase the speed" << endl;
+	cout << "4) Decrease the speed" << endl;
+	cout << "5) Save game" << endl;
+	cout << "6) Load game" << endl;
+	cout << "z) Undo move / x) Redo move" << endl;
+	cout << "9) Exit" << endl;
 
-	if (startX < 0) { //If the startX location of the removal is exceeding the game's left border, we should only remove 2 squares to the right.
-		startX = 0;
-		amountJumpX = 2;
-	}
+	gotoxy(0, MENU_LINES_AMOUNT + 1); //The details are displayed under the notice, and end above the board.
 
-	if (startY < 0) { //If the startY location of the removal is exceeding the game's top border, we should only remove 2 squares to the bottom.
-		startY = 0;
-		amountJumpY = 2;
-	}
+	cout << "        Game's details " << endl;
+	cout << "       ----------------" << endl;
+}
 
-	for (int i = startY; i < startY + amountJumpY && i < ROWS; i++) {
-		gotoxy(startX + Point::GAME_LOCATION_OFFSET_X, i + Point::GAME_LOCATION_OFFSET_Y);
+/*
+This function displays the upcoming blocks of the given frame next to the board.
+Each block is displayed in an area of PREVIEW_BLOCK_WIDTH x 2 squares, and the areas are separated by an empty line.
+*/
+void Tetris::drawNextBlocks(const Frame& frame) const {
+	gotoxy(PREVIEW_LOCATION_X, Point::GAME_LOCATION_OFFSET_Y - 1);
+	cout << "Next:";
+
+	for (int i = 0; i < PREVIEW_BLOCKS_AMOUNT; i++) {
+		BlocksGenerator::eBlockType blockType = frame.nextBlocks[i];
+		string lines[2] = {string(PREVIEW_BLOCK_WIDTH, ' '), string(PREVIEW_BLOCK_WIDTH, ' ')};
+
+		if (blockType == BlocksGenerator::JOKER_BLOCK) {
+			lines[0][0] = Block::NORMAL_SQUARE_CHAR;
+		}
+		else if (blockType == BlocksGenerator::BOMB_BLOCK) {
+			lines[0][0] = Block::BOMB_SQUARE_CHAR;
+		}
+		else {
+			int minX = 0;
 
-		for (int j = startX; j < startX + amountJumpX && j < COLS; j++) {
-			if (this->usedPoints[i][j] != 0) { //Removing the squares the bomb exploded at and removing 50 points for each square removed.
-				this->decreaseScore(BOMB_EXPLODE_SCORE_PENALTY);
-				this->usedPoints[i][j] = 0;
+			//Finding the leftmost square of the shape so the shape starts at the left side of its area.
+			for (int j = 0; j < BlocksGenerator::SHAPE_SIZE; j++) {
+				if (BlocksGenerator::SHAPES[blockType][j][0] < minX) {
+					minX = BlocksGenerator::SHAPES[blockType][j][0];
+				}
 			}
 
-			cout << " ";
+			for (int j = 0; j < BlocksGenerator::SHAPE_SIZE; j++) {
+				lines[BlocksGenerator::SHAPES[blockType][j][1]][BlocksGenerator::SHAPES[blockType][j][0] - minX] = Block::NORMAL_SQUARE_CHAR;
+			}
 		}
-	}
 
-	//Removing the current block's instance.
-	delete this->currentBlock;
-	this->currentBlock = nullptr;
+		for (int j = 0; j < 2; j++) {
+			gotoxy(PREVIEW_LOCATION_X, Point::GAME_LOCATION_OFFSET_Y + i * 3 + j);
+			cout << lines[j];
+		}
+	}
 }
 
 /*
@@ -898,42 +665,34 @@ void Tetris::drawBoundaries() const {
 }
 
 /*
-This function displays the game's details.
+This function displays the game's details of the given frame (such as score and the amount of dropped blocks).
 */
-void Tetris::displayGameDetails() {
-	gotoxy(0, MENU_LINES_AMOUNT + 2);
+void Tetris::drawGameDetails(const Frame& frame) const {
+	gotoxy(0, MENU_LINES_AMOUNT + 3);
 
-	cout << "        Game's details " << endl;
-	cout << "       ----------------" << endl;
+	cout << "Score:" << frame.score << "   " << "Dropped blocks: " << frame.blocksDropped;
 
-	this->updateGameDetails();
-}
+	if (frame.hasBestScore) {
+		cout << "   Best: " << frame.bestScore;
+	}
 
-/*
-This function updates and displays the game's details to the console (such as score and the amount of dropped blocks). 
-*/
-void Tetris::updateGameDetails() {
-	gotoxy(0, MENU_LINES_AMOUNT + 4);
-	cout << "Score:" << this->getScore() << "   " << "Dropped blocks: " << this->getNumOfBlocks() << "         " << endl;
-}
+	cout << "         " << endl;
 
-/*
-This function removes all keypresses from the buffer.
-*/
-void Tetris::removeKeypressFromBuffer() const {
-	while (_kbhit()) {
-		_getch();
+	if (AllocationTracker::ENABLED) { //Reporting the allocations of the game (and of its last step) when they are tracked.
+		gotoxy(0, ALLOCATIONS_LOCATION_Y); //The allocations are displayed under the board.
+		cout << "Allocations: " << frame.gameAllocations.heapAllocations << " (" << frame.gameAllocations.heapBytes << " bytes), pooled: " << frame.gameAllocations.poolAllocations
+			<< ", last step: " << frame.tickAllocations.heapAllocations + frame.tickAllocations.poolAllocations << "         ";
 	}
 }
 
 /*
-This function displays a notice for the user (for example: when the game was paused or the game's speed has increased).
+This function displays the notice of the given frame under the menu.
 */
-void Tetris::showNotice(const string& notice) {
-	int length = notice.length();
+void Tetris::drawNotice(const Frame& frame) {
+	int length = (int)strlen(frame.notice);
 
 	gotoxy(0, MENU_LINES_AMOUNT); //Moving the cursor to the position of the notice (under the menu).
-	cout << notice;
+	cout << frame.notice;
 
 	if (noticeCharactersWritten - length > 0) { //Removing any characters left at the end of the notice (if left from the previous notice).
 		cout << string(noticeCharactersWritten - length, ' ');
@@ -946,51 +705,9 @@ void Tetris::showNotice(const string& notice) {
 This function saves the current game into a file.
 */
 void Tetris::saveToFile() const {
-	char blockType = REGULAR_BLOCK;
 	ofstream outFile(FILE_NAME, ios::binary | ios::trunc);
 
-	outFile.write((const char *)this->usedPoints, sizeof(int) * ROWS * COLS); //Writing the board to the file.
-	outFile.write((const char *)&this->score, sizeof(int)); //Writing the score to the file.
-	outFile.write((const char *)&this->blocksDropped, sizeof(int)); //Writing the amount of dropped blocks to the file.
-	outFile.write((const char*)&this->speed, sizeof(int)); //Writing the current game's speed to the file.
-
-	if (this->currentBlock == nullptr) {
-		blockType = NO_BLOCK;
-	}
-	else {
-		Joker *jokerBlock = dynamic_cast<Joker *>(this->currentBlock);
-		if (jokerBlock != nullptr) {
-			blockType = JOKER_BLOCK;
-		}
-		else {
-			Bomb *bombBlock = dynamic_cast<Bomb *>(this->currentBlock);
-			if (bombBlock != nullptr) {
-				blockType = BOMB_BLOCK;
-			}
-		}
-	}
-
-	outFile.write((const char *)&blockType, sizeof(char)); //Writing the current block type to the file.
-
-	if (blockType != NO_BLOCK) {
-		int blockRotatedAmount = this->currentBlock->getRotatedAmount();
-
-		outFile.write((const char *)&blockRotatedAmount, sizeof(int)); //Writing the amount of times the block was rotated.
-
-		const vector<Point *> blockLocations = this->currentBlock->getBlockLocations();
-
-		//Writing the current block's size to the file.
-		int blockLocationsSize = blockLocations.size();
-		outFile.write((const char *)&blockLocationsSize, sizeof(int));
-
-		//Writing the points in the current block's locations to the file.
-		vector<Point *>::const_iterator itr = blockLocations.begin();
-		vector<Point *>::const_iterator itrEnd = blockLocations.end();
-		for (; itr != itrEnd; ++itr) {
-			outFile.write((const char *)*itr, sizeof(Point));
-		}
-	}
-
+	this->game.saveToFile(outFile);
 	outFile.close();
 }
 
@@ -998,51 +715,12 @@ void Tetris::saveToFile() const {
 This function loads the game from a file.
 */
 void Tetris::loadFromFile() {
-	char blockType;
-	int blockSize;
-	Point p;
 	ifstream inFile(FILE_NAME, ios::binary);
 
 	if (!inFile.is_open()) {
 		return;
 	}
 
-	inFile.read((char *)this->usedPoints, sizeof(int) * ROWS * COLS); //Reading the board from the file.
-	inFile.read((char *)&this->score, sizeof(int)); //Reading the score from the file.
-	inFile.read((char *)&this->blocksDropped, sizeof(int)); //Reading the amount of blocks dropped from the file.
-	inFile.read((char *)&this->speed, sizeof(int)); //Reading the game's speed from the file.
-	inFile.read((char *)&blockType, sizeof(char)); //Reading the current block's type.
-
-	if (blockType == NO_BLOCK) {
-		this->currentBlock = nullptr;
-	}
-	else {
-		int blockRotatedAmount;
-		
-		inFile.read((char *)&blockRotatedAmount, sizeof(int)); //Reading the amount of times the current block was rotated.
-		inFile.read((char *)&blockSize, sizeof(int)); //Reading the current block's size.
-
-		vector<Point *> blockLocations;
-		blockLocations.reserve(blockSize);
-
-		//Reading the current block's locations from the file.
-		for (int i = 0; i < blockSize; i++) {
-			inFile.read((char *)&p, sizeof(Point));
-			blockLocations.push_back(new Point(p));
-		}
-
-		//Initializing the current block.
-		if (blockType == REGULAR_BLOCK) {
-			this->currentBlock = new GeneralBlock(blockLocations);
-			this->currentBlock->setRotatedAmount(blockRotatedAmount);
-		}
-		else if (blockType == JOKER_BLOCK) {
-			this->currentBlock = new Joker(p);
-		}
-		else {
-			this->currentBlock = new Bomb(p);
-		}
-	}
-
+	this->game.loadFromFile(inFile, this->getNewGameSeed()); //The upcoming blocks are not saved in the file, so new ones are generated.
 	inFile.close();
 }
\ No newline at end of file
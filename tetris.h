@@ -5,115 +5,133 @@
 #include <fstream>
 #include <string>
 #include <ctime>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <atomic>
 #include <Windows.h>
 #include <conio.h>
 using namespace std;
 
 #include "Gotoxy.h"
-#include "block.h"
-#include "blocks_generator.h"
+#include "game.h"
+#include "board_renderer.h"
+#include "trace.h"
+#include "undo_history.h"
+#include "randomizer_config.h"
+#include "score_log.h"
+#include "frame.h"
+#include "triple_buffer.h"
+#include "input_reader.h"
+#include "game_session.h"
+#include "state_export.h"
 
 class Tetris {
 public:
+	//Definition of the states of the game: the menu is displayed (the game was not started, was paused or has ended), a game is played, or the game is exited.
+	enum eState {IN_MENU, PLAYING, EXITING};
+
 	//Definition of each keypress and what it does.
-	enum eKeys {ROTATE_RIGHT_KEY = 'r', MOVE_LEFT_KEY = 'q', MOVE_DOWN_KEY = 'w', MOVE_RIGHT_KEY = 'e', JOKER_PAUSE_KEY = 's', GAME_START_KEY = '1', GAME_PAUSE_KEY = '2', GAME_INCREASE_SPEED_KEY = '3', GAME_DECREASE_SPEED_KEY = '4', GAME_SAVE_KEY = '5', GAME_LOAD_KEY = '6', GAME_EXIT_KEY = '9'};
+	enum eKeys {ROTATE_RIGHT_KEY = 'r', MOVE_LEFT_KEY = 'q', MOVE_DOWN_KEY = 'w', MOVE_RIGHT_KEY = 'e', JOKER_PAUSE_KEY = 's', UNDO_KEY = 'z', REDO_KEY = 'x', GAME_START_KEY = '1', GAME_PAUSE_KEY = '2', GAME_INCREASE_SPEED_KEY = '3', GAME_DECREASE_SPEED_KEY = '4', GAME_SAVE_KEY = '5', GAME_LOAD_KEY = '6', GAME_EXIT_KEY = '9'};
 
-	constexpr static int ROWS = 15;
-	constexpr static int COLS = 10;
+	constexpr static int ROWS = Board::ROWS;
+	constexpr static int COLS = Board::COLS;
 	constexpr static int WINDOW_WIDTH = 450;
 	constexpr static int WINDOW_HEIGHT = 550;
 
-	constexpr static int MENU_LINES_AMOUNT = 8;
+	constexpr static int MENU_LINES_AMOUNT = 9;
 
 	constexpr static int GAME_SPEED_CHANGE_AMOUNT = 50;
-	constexpr static int MENU_WAIT_FOR_ACTION_DELAY = 200;
-
-	constexpr static int MOVE_TO_BOTTOM_SCORE_MULTIPLIER = 2;
-	constexpr static int JOKER_LINE_REMOVED_SCORE = 50;
-	constexpr static int BOMB_EXPLODE_SCORE_PENALTY = 50;
-	constexpr static int LINES_REMOVED_SCORE_1 = 100;
-	constexpr static int LINES_REMOVED_SCORE_2 = 300;
-	constexpr static int LINES_REMOVED_SCORE_3 = 500;
-	constexpr static int LINES_REMOVED_SCORE_4 = 800;
+	constexpr static int TIMER_RESOLUTION = 1; //The resolution of the sleeps of the game (in miliseconds).
+	constexpr static int RENDER_WAIT_FOR_FRAME_DELAY = 2; //The time the render thread waits when no new frame was published (in miliseconds).
 
 	constexpr static int MAXIMUM_SPEED = 100;
 
+	//Upcoming blocks preview constants.
+	constexpr static int PREVIEW_BLOCKS_AMOUNT = Frame::NEXT_BLOCKS_AMOUNT;
+	constexpr static int PREVIEW_BLOCK_WIDTH = 4;
+	constexpr static int PREVIEW_LOCATION_X = Point::GAME_LOCATION_OFFSET_X + COLS + 3;
+	static_assert(PREVIEW_BLOCKS_AMOUNT <= BlocksQueue::MAX_LOOKAHEAD, "The queue does not hold enough upcoming blocks for the preview.");
+
+	constexpr static int ALLOCATIONS_LOCATION_Y = Point::GAME_LOCATION_OFFSET_Y + ROWS + 2; //Only used when the game is built with TETRIS_TRACK_ALLOCATIONS.
+
 	//Files constants.
 	constexpr static char *FILE_NAME = "saved.bin";
-	constexpr static char NO_BLOCK = -1;
-	constexpr static char REGULAR_BLOCK = 0;
-	constexpr static char JOKER_BLOCK = 1;
-	constexpr static char BOMB_BLOCK = 2;
+	constexpr static char *TRACE_FILE_NAME = "trace.json"; //Only used when the game is built with TETRIS_TRACE.
+	constexpr static char *RANDOMIZER_FILE_NAME = "blocks.cfg"; //The settings of the blocks randomizer (optional).
+	constexpr static char *SCORES_FILE_NAME = "scores.log";
+	constexpr static char *SCORES_INDEX_FILE_NAME = "scores.idx";
 
 	Tetris();
 	~Tetris();
 
 private:
+	eState state = IN_MENU;
 	bool isStarted = false; //This property saves whether the game has started or not.
-	bool isFailed = false; //This property saves whether the blocks reached the end of the board.
-	int speed = 350; //This property saves the game's speed in miliseconds.
-	int usedPoints[ROWS][COLS] = {}; //This property saves the locations of the used points inside the board.
-	Block *currentBlock; //This property saves the current block that is falling down.
-	int score = 0;
-	int blocksDropped = 0;
-
+	Game game; //This property saves the game's rules and state (the board, the current block and the score).
+	GameSession session; //This property saves the game's moves that were not made yet and the time of its next step.
+	InputReader input; //This property saves the keypresses that were made and were not handled yet.
+	UndoHistory history; //This property saves the state of the game at the moment each of the last blocks was added.
+	ScoreLog scores; //This property saves the scores of all of the finished games.
+	chrono::steady_clock::duration playTime = chrono::steady_clock::duration::zero(); //This property saves the time the current game was played (without pauses).
+	chrono::steady_clock::time_point playStartTime; //This property saves the time the game was started or continued.
+	bool isScoreRecorded = false; //This property saves whether the current game's score was already added to the scores.
+	StateExport stateExport; //This property saves the shared memory segment the game's state is exported to, for the monitors.
+	long long stepsRun = 0; //This property saves the amount of steps run since the game was opened.
+	long long gamesPlayed = 0; //This property saves the amount of games started since the game was opened.
+
+	//The game's thread fills the frame and publishes copies of it, and the render thread displays the newest published copy.
+	Frame frame = Frame(); //This property saves what should be displayed now (it is only used by the game's thread).
+	TripleBuffer<Frame> frames; //This property passes the published frames from the game's thread to the render thread.
+	thread renderThread;
+	atomic<bool> isRendering; //This property saves whether the render thread should keep waiting for new frames.
+
+	//These properties are only used by the render thread.
+	BoardRenderer renderer; //This property saves what is displayed in the console for the board, so only changed squares are painted.
+	Frame renderedFrame; //This property saves the frame that is currently displayed in the console.
+	bool isFrameRendered = false; //This property saves whether any frame was displayed yet.
 	int noticeCharactersWritten = 0; //This property saves the amount of characters written in the notice area for cleaning purposes.
 
 	Tetris(const Tetris& other) = delete; //Removing the copy constructor since it's not needed.
 
 	void changeConsoleSize(int width, int height);
-	void displayMenu();
+	void loadRandomizerConfig();
+	void run();
+	void setState(eState state);
+	void startRendering();
+	void stopRendering();
 
-	bool menuActionHandler(char keyPressed, bool arrivedFromOngoingGame);
-	void waitForMenuAction();
+	void menuActionHandler(char keyPressed);
 	void exitGame();
 	void endGame();
+	void recordScore();
 	void showNotice(const string& notice);
-
-	void displayGameDetails();
-	void updateGameDetails();
-
-	void gameEngine();
+	void updateFrame();
+	void publishFrame();
+	void exportState();
+
+	void resumeGame();
+	Game::eAction getActionFromKey(char keyPressed) const;
+	void handleKeys();
+	void traceKey(const KeyEvent& event) const;
 	void startGame();
+	void loadGame();
 	void continueGame();
 	void pauseGame();
 
-	void paintBoard();
-	void clearBoard();
-	void setUsedPoints();
-	void setSpeed(int speed);
+	void undoMove(bool isRedo);
 	void increaseSpeed(int speed);
 	void decreaseSpeed(int speed);
 
-	int getScore() const;
-	int getNumOfBlocks() const;
-
-	void addNewBlock();
-	void setScore(int score);
-	void increaseScore(int score);
-	void decreaseScore(int score);
-	void setBlocksDropped(int blocksDropped);
-	void increaseNumOfBlocks();
-
-	bool canBlockMoveDown();
-	bool canBlockMoveRight();
-	bool canBlockMoveLeft();
-	bool canBlockRotateRight();
-
-	void moveBlockDown();
-	void moveBlockRight();
-	void moveBlockLeft();
-	void rotateBlockRight();
-	void moveBlockToBottom();
-	
-	bool checkAndRemoveRow(int row);
-	void checkAndExplode(char keyPressed = 0);
-	void explode(Point p);
-	void removeRow(int row); 
+	unsigned int getNewGameSeed() const;
 
+	void renderLoop();
+	void renderFrame(const Frame& frame);
+	void drawMenu() const;
 	void drawBoundaries() const;
-
-	void removeKeypressFromBuffer() const;
+	void drawNextBlocks(const Frame& frame) const;
+	void drawGameDetails(const Frame& frame) const;
+	void drawNotice(const Frame& frame);
 
 	void saveToFile() const;
 	void loadFromFile();
@@ -0,0 +1,192 @@
+#include "tetris_env.h"
+#include "game.h"
+#include <new>
+
+static_assert(TETRIS_ENV_ROWS == Board::ROWS && TETRIS_ENV_COLS == Board::COLS, "The observation must have the size of the board.");
+static_assert(TETRIS_ENV_NEXT_BLOCKS <= BlocksQueue::MAX_LOOKAHEAD, "The queue does not hold enough upcoming blocks for the observation.");
+static_assert(TETRIS_ENV_MOVE_LEFT == Game::MOVE_LEFT && TETRIS_ENV_MOVE_DOWN == Game::MOVE_DOWN && TETRIS_ENV_MOVE_RIGHT == Game::MOVE_RIGHT &&
+	TETRIS_ENV_ROTATE_RIGHT == Game::ROTATE_RIGHT && TETRIS_ENV_JOKER_PAUSE == Game::JOKER_PAUSE && TETRIS_ENV_ACTIONS_AMOUNT == Game::JOKER_PAUSE + 1,
+	"The actions must have the values of Game::eAction.");
+
+/*
+A batch of environments: a game for each environment and the stream of seeds its next games are started from.
+The games are allocated once when the batch is created, and the blocks of the games come from the memory pools, so stepping does not use the heap.
+*/
+struct TetrisEnvBatch {
+	int amount;
+	Game *games;
+	RandomStream *seeds;
+};
+
+/*
+This function writes the observation of a game: the board with the falling block, the kind of the falling block and the next blocks.
+*/
+static void writeObservation(const Game& game, unsigned char *observation) {
+	const Board& board = game.getBoard();
+	Block *block = game.getCurrentBlock();
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		unsigned int rowMask = board.getRowMask(i);
+		unsigned char *row = observation + i * Board::COLS;
+
+		for (int j = 0; j < Board::COLS; j++) {
+			row[j] = (rowMask >> j) & 1; //TETRIS_ENV_CELL_FREE or TETRIS_ENV_CELL_USED.
+		}
+	}
+
+	if (block == nullptr) {
+		observation[TETRIS_ENV_BLOCK_KIND_OFFSET] = TETRIS_ENV_BLOCK_NONE;
+	}
+	else {
+		const BlockSquares& blockLocations = block->getBlockLocations();
+		BlockSquares::const_iterator itr = blockLocations.begin();
+		BlockSquares::const_iterator itrEnd = blockLocations.end();
+
+		for (; itr != itrEnd; ++itr) {
+			int row = (*itr)->getY() - Point::GAME_LOCATION_OFFSET_Y;
+			int col = (*itr)->getX() - Point::GAME_LOCATION_OFFSET_X;
+
+			if (row >= 0 && row < Board::ROWS && col >= 0 && col < Board::COLS) {
+				observation[row * Board::COLS + col] = TETRIS_ENV_CELL_BLOCK;
+			}
+		}
+
+		if (BlocksGenerator::isJoker(block)) {
+			observation[TETRIS_ENV_BLOCK_KIND_OFFSET] = TETRIS_ENV_BLOCK_JOKER;
+		}
+		else if (BlocksGenerator::isBomb(block)) {
+			observation[TETRIS_ENV_BLOCK_KIND_OFFSET] = TETRIS_ENV_BLOCK_BOMB;
+		}
+		else {
+			observation[TETRIS_ENV_BLOCK_KIND_OFFSET] = TETRIS_ENV_BLOCK_SHAPE;
+		}
+	}
+
+	for (int i = 0; i < TETRIS_ENV_NEXT_BLOCKS; i++) {
+		observation[TETRIS_ENV_NEXT_BLOCKS_OFFSET + i] = (unsigned char)game.getNextBlocks().peek(i);
+	}
+}
+
+/*
+This function returns the version of the interface the library was built with.
+*/
+int tetris_env_abi_version(void) {
+	return TETRIS_ENV_ABI_VERSION;
+}
+
+/*
+This function creates a batch of environments, each starting a game from its own seed.
+*/
+TetrisEnvBatch * tetris_env_create(int amount, const unsigned int *seeds) {
+	if (amount <= 0 || seeds == nullptr) {
+		return nullptr;
+	}
+
+	TetrisEnvBatch *batch = new (nothrow) TetrisEnvBatch;
+	if (batch == nullptr) {
+		return nullptr;
+	}
+
+	batch->amount = amount;
+	batch->games = new (nothrow) Game[amount];
+	batch->seeds = new (nothrow) RandomStream[amount];
+
+	if (batch->games == nullptr || batch->seeds == nullptr) {
+		tetris_env_destroy(batch);
+		return nullptr;
+	}
+
+	for (int i = 0; i < amount; i++) {
+		tetris_env_reset(batch, i, seeds[i]);
+	}
+
+	return batch;
+}
+
+/*
+This function frees a batch of environments.
+*/
+void tetris_env_destroy(TetrisEnvBatch *batch) {
+	if (batch != nullptr) {
+		delete[] batch->games;
+		delete[] batch->seeds;
+		delete batch;
+	}
+}
+
+/*
+This function returns the amount of environments in a batch.
+*/
+int tetris_env_get_amount(const TetrisEnvBatch *batch) {
+	return batch->amount;
+}
+
+/*
+This function starts a new game in an environment. The seeds of the environment's next games are drawn from the given seed as well.
+*/
+void tetris_env_reset(TetrisEnvBatch *batch, int index, unsigned int seed) {
+	if (index < 0 || index >= batch->amount) {
+		return;
+	}
+
+	batch->seeds[index].reset(seed);
+	batch->games[index].start(batch->seeds[index].next());
+}
+
+/*
+This function writes the observations of all of the environments.
+*/
+void tetris_env_observe(const TetrisEnvBatch *batch, unsigned char *observations) {
+	for (int i = 0; i < batch->amount; i++) {
+		writeObservation(batch->games[i], observations + (size_t)i * TETRIS_ENV_OBSERVATION_SIZE);
+	}
+}
+
+/*
+This function runs one step of every environment and writes the results into the caller's arrays.
+A game that was over in the previous step is started again from the environment's next seed before the step.
+*/
+void tetris_env_step_batch(TetrisEnvBatch *batch, const int *actions, unsigned char *observations, float *rewards, unsigned char *dones) {
+	for (int i = 0; i < batch->amount; i++) {
+		Game& game = batch->games[i];
+		int action = actions[i];
+
+		if (game.isGameOver()) {
+			game.start(batch->seeds[i].next());
+		}
+
+		if (action < 0 || action >= TETRIS_ENV_ACTIONS_AMOUNT) {
+			action = TETRIS_ENV_NO_ACTION;
+		}
+
+		int scoreBefore = game.getScore();
+
+		game.tick((Game::eAction)action);
+
+		if (rewards != nullptr) {
+			rewards[i] = (float)(game.getScore() - scoreBefore);
+		}
+
+		if (dones != nullptr) {
+			dones[i] = game.isGameOver() ? 1 : 0;
+		}
+
+		if (observations != nullptr) {
+			writeObservation(game, observations + (size_t)i * TETRIS_ENV_OBSERVATION_SIZE);
+		}
+	}
+}
+
+/*
+This function returns the score of an environment's current game.
+*/
+int tetris_env_get_score(const TetrisEnvBatch *batch, int index) {
+	return (index >= 0 && index < batch->amount) ? batch->games[index].getScore() : 0;
+}
+
+/*
+This function returns the amount of blocks dropped in an environment's current game.
+*/
+int tetris_env_get_blocks_dropped(const TetrisEnvBatch *batch, int index) {
+	return (index >= 0 && index < batch->amount) ? batch->games[index].getNumOfBlocks() : 0;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef __TETRIS_ENV_H
+#define __TETRIS_ENV_H
+
+/*
+A C interface to the game's rules for training agents, built as a shared library (libtetris.so / tetris.dll).
+A batch of environments is created from seeds and all of them are stepped at once: the actions are read from an array
+and the observations, the rewards and the done flags are written straight into contiguous arrays owned by the caller.
+
+Each step of an environment is one step of the game (the same as one tick of the game's loop) with the given action.
+The reward of a step is the change of the game's score in that step, so it follows the game's scoring rules.
+When a game is over, its done flag is set and the environment starts a new game on its next step (with the next seed of its own seed stream),
+so the caller never has to reset environments between the batches.
+
+The functions are not thread safe for the same batch: a batch must be used by one thread at a time. Different batches can be stepped on different threads,
+and a batch may be handed to another thread (or destroyed on it) as long as the caller orders the hand-off, for example by joining the thread that used it
+or with a lock. The blocks of the games are allocated from pools of the thread that steps them, and a block freed on another thread goes back to its own pool.
+*/
+
+#ifdef _WIN32
+#define TETRIS_ENV_API __declspec(dllexport)
+#else
+#define TETRIS_ENV_API __attribute__((visibility("default")))
+#endif
+
+#define TETRIS_ENV_ABI_VERSION 1
+
+#define TETRIS_ENV_ROWS 15
+#define TETRIS_ENV_COLS 10
+#define TETRIS_ENV_NEXT_BLOCKS 3
+
+/*
+The layout of an observation (one byte per value):
+* TETRIS_ENV_ROWS * TETRIS_ENV_COLS cells of the board, row by row from the top: TETRIS_ENV_CELL_FREE, TETRIS_ENV_CELL_USED or TETRIS_ENV_CELL_BLOCK.
+* The kind of the falling block (TETRIS_ENV_BLOCK_*).
+* The types of the next TETRIS_ENV_NEXT_BLOCKS blocks (0 square, 1 line, 2 snake, 3 gamma, 4 plus, 5 joker, 6 bomb).
+*/
+#define TETRIS_ENV_CELL_FREE 0
+#define TETRIS_ENV_CELL_USED 1
+#define TETRIS_ENV_CELL_BLOCK 2
+
+#define TETRIS_ENV_BLOCK_NONE 0
+#define TETRIS_ENV_BLOCK_SHAPE 1
+#define TETRIS_ENV_BLOCK_JOKER 2
+#define TETRIS_ENV_BLOCK_BOMB 3
+
+#define TETRIS_ENV_BLOCK_KIND_OFFSET (TETRIS_ENV_ROWS * TETRIS_ENV_COLS)
+#define TETRIS_ENV_NEXT_BLOCKS_OFFSET (TETRIS_ENV_BLOCK_KIND_OFFSET + 1)
+#define TETRIS_ENV_OBSERVATION_SIZE (TETRIS_ENV_NEXT_BLOCKS_OFFSET + TETRIS_ENV_NEXT_BLOCKS)
+
+/*
+The actions (the same as the game's keys).
+*/
+#define TETRIS_ENV_NO_ACTION 0
+#define TETRIS_ENV_MOVE_LEFT 1
+#define TETRIS_ENV_MOVE_DOWN 2
+#define TETRIS_ENV_MOVE_RIGHT 3
+#define TETRIS_ENV_ROTATE_RIGHT 4
+#define TETRIS_ENV_JOKER_PAUSE 5
+#define TETRIS_ENV_ACTIONS_AMOUNT 6
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct TetrisEnvBatch TetrisEnvBatch;
+
+/*
+Returns TETRIS_ENV_ABI_VERSION of the library, so the caller can check it was built against the same header.
+*/
+TETRIS_ENV_API int tetris_env_abi_version(void);
+
+/*
+Creates a batch of the given amount of environments, the i-th starting from seeds[i]. Returns NULL if the amount is not positive or there is no memory.
+*/
+TETRIS_ENV_API TetrisEnvBatch * tetris_env_create(int amount, const unsigned int *seeds);
+
+TETRIS_ENV_API void tetris_env_destroy(TetrisEnvBatch *batch);
+
+TETRIS_ENV_API int tetris_env_get_amount(const TetrisEnvBatch *batch);
+
+/*
+Starts a new game in one of the environments, from the given seed.
+*/
+TETRIS_ENV_API void tetris_env_reset(TetrisEnvBatch *batch, int index, unsigned int seed);
+
+/*
+Writes the observations of all of the environments (amount * TETRIS_ENV_OBSERVATION_SIZE bytes).
+*/
+TETRIS_ENV_API void tetris_env_observe(const TetrisEnvBatch *batch, unsigned char *observations);
+
+/*
+Runs one step of every environment with actions[i] (an invalid action is treated as no action) and writes, for each environment:
+its observation after the step (amount * TETRIS_ENV_OBSERVATION_SIZE bytes), the step's reward and whether the game ended in the step.
+Any of the output arrays may be NULL if it is not needed.
+*/
+TETRIS_ENV_API void tetris_env_step_batch(TetrisEnvBatch *batch, const int *actions, unsigned char *observations, float *rewards, unsigned char *dones);
+
+/*
+Returns the current score and the amount of dropped blocks of an environment's game.
+*/
+TETRIS_ENV_API int tetris_env_get_score(const TetrisEnvBatch *batch, int index);
+TETRIS_ENV_API int tetris_env_get_blocks_dropped(const TetrisEnvBatch *batch, int index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,379 @@
+/*
+Microbenchmarks for the hot paths of the game's engine.
+Every benchmark uses fixed seeds, runs a warm-up round and then several timed trials, and the results are printed as JSON:
+{"benchmarks": [{"name": ..., "iterations": ..., "trials": ..., "min_ns": ..., "median_ns": ..., "mean_ns": ..., "max_ns": ...}, ...]}
+The times are in nanoseconds per iteration.
+When the benchmark is built with TETRIS_TRACK_ALLOCATIONS, the heap and pool allocations per iteration are printed as well.
+
+Usage: benchmark [trials] [name filter]
+*/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+#include "game.h"
+#include "board_renderer.h"
+#include "block_randomizer.h"
+#include "placement_finder.h"
+#include "surface_placements.h"
+
+constexpr int DEFAULT_TRIALS = 7;
+constexpr unsigned int BENCHMARK_SEED = 12345;
+
+struct BenchmarkResult {
+	string name;
+	long long iterations;
+	vector<double> nanosecondsPerIteration; //One entry per trial.
+	AllocationCounts allocations; //The allocations of all of the trials.
+};
+
+static volatile long long benchmarkSink = 0; //The benchmarks write their results here so the compiler does not remove the measured code.
+
+/*
+A renderer that writes the frames into a memory buffer, using ANSI escape sequences for the cursor moves.
+*/
+class MemoryRenderer : public BoardRenderer {
+public:
+	ostringstream buffer;
+
+	MemoryRenderer() : BoardRenderer(buffer) {
+	}
+
+protected:
+	void moveCursor(int x, int y) override {
+		this->buffer << "\033[" << y + 1 << ";" << x + 1 << "H";
+	}
+};
+
+/*
+A subscriber that counts the game's events by their type (the cheapest consumer of the event stream).
+*/
+class CountingSubscriber : public GameEventSubscriber {
+public:
+	long long counts[GameEvent::TYPES_AMOUNT] = {};
+
+	void onEvents(const GameEvent *events, int amount) override {
+		for (int i = 0; i < amount; i++) {
+			this->counts[events[i].type]++;
+		}
+	}
+};
+
+/*
+This function runs the given body iterations times per trial after a warm-up round and returns the time of each trial.
+*/
+template <typename Body>
+BenchmarkResult runBenchmark(const string& name, long long iterations, int trials, Body body) {
+	BenchmarkResult result = {name, iterations, {}, {0, 0, 0, 0}};
+
+	for (long long i = 0; i < iterations / 10 + 1; i++) { //Warming up the caches and the branch predictors.
+		body(i);
+	}
+
+	AllocationCounts allocationsBefore = AllocationTracker::getCounts();
+
+	for (int trial = 0; trial < trials; trial++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+		for (long long i = 0; i < iterations; i++) {
+			body(i);
+		}
+
+		chrono::steady_clock::time_point end = chrono::steady_clock::now();
+		double elapsed = (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+
+		result.nanosecondsPerIteration.push_back(elapsed / iterations);
+	}
+
+	result.allocations = AllocationTracker::getCounts() - allocationsBefore;
+
+	return result;
+}
+
+/*
+This function starts a game with the given seed and runs it until the current block is a block of the given type that has just been added.
+*/
+void prepareGame(Game& game, unsigned int seed, BlocksGenerator::eBlockType blockType) {
+	game.start(seed);
+
+	while (true) {
+		while (game.getCurrentBlock() != nullptr && !game.isGameOver()) {
+			game.tick(Game::MOVE_DOWN);
+		}
+
+		if (game.isGameOver()) {
+			game.start(++seed);
+		}
+
+		BlocksGenerator::eBlockType nextType = game.getNextBlocks().peek(0);
+		game.tick(Game::NO_ACTION); //Adding the next block.
+
+		if (nextType == blockType && !game.isGameOver()) {
+			return;
+		}
+	}
+}
+
+/*
+This function returns a board whose lowest rows are full and whose other rows are partly used.
+*/
+Board createBoardWithFullRows(int fullRows) {
+	Board board;
+	RandomStream random(BENCHMARK_SEED);
+
+	for (int i = Board::ROWS / 2; i < Board::ROWS; i++) {
+		for (int j = 0; j < Board::COLS; j++) {
+			if (i >= Board::ROWS - fullRows || random.nextInRange(2) == 0) {
+				board.setUsed(i, j);
+			}
+		}
+
+		if (i < Board::ROWS - fullRows && board.isRowFull(i)) {
+			board.clearUsed(i, 0);
+		}
+	}
+
+	return board;
+}
+
+/*
+This function returns a board whose columns are filled up to the given heights (a surface with no free square below a used square).
+*/
+Board createBoardWithHeights(const int heights[Board::COLS]) {
+	Board board;
+
+	for (int j = 0; j < Board::COLS; j++) {
+		for (int i = Board::ROWS - heights[j]; i < Board::ROWS; i++) {
+			board.setUsed(i, j);
+		}
+	}
+
+	return board;
+}
+
+/*
+This function plays a whole game with actions taken from the given seed and returns the amount of steps it took.
+The game's events are written to the given stream, if there is one.
+*/
+long long simulateGame(unsigned int seed, GameEventStream *events = nullptr) {
+	Game game;
+	RandomStream random(seed);
+	long long ticks = 0;
+
+	game.setEventStream(events);
+	game.start(seed);
+
+	while (!game.isGameOver()) {
+		game.tick((Game::eAction)random.nextInRange(Game::JOKER_PAUSE + 1));
+		ticks++;
+	}
+
+	return ticks;
+}
+
+/*
+This function prints the results as JSON (the minimum, median, mean and maximum time per iteration of each benchmark).
+*/
+void printResults(const vector<BenchmarkResult>& results) {
+	cout << "{\"benchmarks\": [" << endl;
+
+	for (size_t i = 0; i < results.size(); i++) {
+		vector<double> times = results[i].nanosecondsPerIteration;
+		double mean = 0;
+
+		sort(times.begin(), times.end());
+
+		for (size_t j = 0; j < times.size(); j++) {
+			mean += times[j];
+		}
+
+		mean /= times.size();
+
+		cout << "  {\"name\": \"" << results[i].name << "\", \"iterations\": " << results[i].iterations << ", \"trials\": " << times.size()
+			<< ", \"min_ns\": " << times.front() << ", \"median_ns\": " << times[times.size() / 2] << ", \"mean_ns\": " << mean
+			<< ", \"max_ns\": " << times.back();
+
+		if (AllocationTracker::ENABLED) {
+			double totalIterations = (double)results[i].iterations * times.size();
+			const AllocationCounts& allocations = results[i].allocations;
+
+			cout << ", \"heap_allocs_per_iter\": " << allocations.heapAllocations / totalIterations << ", \"heap_bytes_per_iter\": " << allocations.heapBytes / totalIterations
+				<< ", \"pool_allocs_per_iter\": " << allocations.poolAllocations / totalIterations;
+		}
+
+		cout << "}" << (i + 1 < results.size() ? "," : "") << endl;
+	}
+
+	cout << "]}" << endl;
+}
+
+int main(int argc, char *argv[]) {
+	int trials = (argc > 1) ? atoi(argv[1]) : DEFAULT_TRIALS;
+	string filter = (argc > 2) ? argv[2] : "";
+	vector<BenchmarkResult> results;
+
+	if (trials <= 0) {
+		trials = DEFAULT_TRIALS;
+	}
+
+	//Adds a benchmark to the results unless it is filtered out.
+	auto add = [&](const string& name, long long iterations, auto body) {
+		if (name.find(filter) != string::npos) {
+			results.push_back(runBenchmark(name, iterations, trials, body));
+		}
+	};
+
+	//Collision checks of a line block that has just been added to a half full board.
+	Game game;
+	prepareGame(game, BENCHMARK_SEED, BlocksGenerator::LINE_BLOCK);
+	game.setBoard(createBoardWithFullRows(0));
+
+	add("collision/canBlockMoveLeft", 10000000, [&](long long) { benchmarkSink += game.canBlockMoveLeft(); });
+	add("collision/canBlockMoveRight", 10000000, [&](long long) { benchmarkSink += game.canBlockMoveRight(); });
+	add("collision/canBlockMoveDown", 10000000, [&](long long) { benchmarkSink += game.canBlockMoveDown(); });
+	add("collision/canBlockRotateRight", 1000000, [&](long long) { benchmarkSink += game.canBlockRotateRight(); });
+	add("collision/getBlockDropDistance", 10000000, [&](long long) { benchmarkSink += game.getBlockDropDistance(); });
+
+	//Rotating a line block.
+	Block *line = BlocksGenerator::createBlock(BlocksGenerator::LINE_BLOCK);
+	add("block/getRotatedPoint", 10000000, [&](long long) {
+		Point rotated = line->getRotatedPoint(*line->getBlockLocations()[0]);
+		benchmarkSink += rotated.getX();
+	});
+	add("block/rotateRight", 1000000, [&](long long) {
+		line->rotateRight();
+		benchmarkSink += line->getBlockLocations()[0]->getX();
+	});
+	delete line;
+
+	//Removing full rows - the board is copied in each iteration, so the cost of the copy is measured separately.
+	Board boards[5];
+	for (int lines = 0; lines <= 4; lines++) {
+		boards[lines] = createBoardWithFullRows(lines);
+	}
+
+	add("board/copy", 10000000, [&](long long) {
+		Board board = boards[4];
+		benchmarkSink += board.isUsed(Board::ROWS - 1, 0);
+	});
+
+	for (int lines = 0; lines <= 4; lines++) {
+		add("board/removeFullRows/" + to_string(lines) + "_lines", 10000000, [&, lines](long long) {
+			Board board = boards[lines];
+			benchmarkSink += board.removeFullRows(Board::ROWS - 4, Board::ROWS - 1);
+		});
+	}
+
+	//A bomb exploding in the middle of a full board.
+	add("game/explode", 1000000, [&](long long) {
+		game.setBoard(boards[4]);
+		game.explode(Point(Point::MIDDLE_X_POSITION, Point::GAME_LOCATION_OFFSET_Y + Board::ROWS - 2));
+		benchmarkSink += game.getScore();
+	});
+
+	//Saving, copying and restoring the state of a game.
+	GameState states[2];
+	game.saveState(states[0]);
+
+	add("state/saveState", 10000000, [&](long long) {
+		game.saveState(states[0]);
+		benchmarkSink += states[0].score;
+	});
+	add("state/copy", 10000000, [&](long long i) {
+		states[(i + 1) & 1] = states[i & 1];
+		benchmarkSink += states[0].blockType;
+	});
+	add("state/loadState", 1000000, [&](long long) {
+		game.loadState(states[0]);
+		benchmarkSink += game.getGhostDistance();
+	});
+
+	//Finding every placement of a gamma block, by running the game's steps and from the surface of the board (and with an overhang, where the surface falls back to the steps).
+	const int LOW_HEIGHTS[Board::COLS] = {2, 3, 1, 0, 2, 4, 3, 1, 2, 0};
+	Game searchGame;
+	GameState surfaceStart, overhangStart;
+	Board overhangBoard = createBoardWithHeights(LOW_HEIGHTS);
+	PlacementFinder placementFinder;
+	SurfacePlacementFinder surfaceFinder;
+	vector<Placement> placements;
+
+	overhangBoard.clearUsed(Board::ROWS - 1, 5);
+	searchGame.start(BENCHMARK_SEED);
+	searchGame.setBoard(createBoardWithHeights(LOW_HEIGHTS));
+	searchGame.addBlock(BlocksGenerator::GAMMA_BLOCK);
+	searchGame.saveState(surfaceStart);
+	searchGame.setBoard(overhangBoard);
+	searchGame.saveState(overhangStart);
+
+	add("placements/findPlacements", 1000, [&](long long) {
+		placementFinder.findPlacements(searchGame, surfaceStart, placements);
+		benchmarkSink += placements.size();
+	});
+	add("placements/surface", 10000, [&](long long) {
+		surfaceFinder.findPlacements(searchGame, surfaceStart, placements);
+		benchmarkSink += placements.size();
+	});
+	add("placements/surface/overhang", 1000, [&](long long) {
+		surfaceFinder.findPlacements(searchGame, overhangStart, placements);
+		benchmarkSink += placements.size();
+	});
+
+	//Picking the types of blocks in each mode of the randomizer, and creating the blocks.
+	RandomStream random(BENCHMARK_SEED);
+	RandomizerConfig bagConfig, historyConfig;
+	bagConfig.mode = RandomizerConfig::BAG_MODE;
+	historyConfig.mode = RandomizerConfig::HISTORY_MODE;
+
+	BlockRandomizer weightedRandomizer;
+	BlockRandomizer bagRandomizer(bagConfig);
+	BlockRandomizer historyRandomizer(historyConfig);
+
+	add("randomizer/weighted", 10000000, [&](long long) { benchmarkSink += weightedRandomizer.next(random); });
+	add("randomizer/bag", 10000000, [&](long long) { benchmarkSink += bagRandomizer.next(random); });
+	add("randomizer/history", 10000000, [&](long long) { benchmarkSink += historyRandomizer.next(random); });
+	add("generator/createBlock", 1000000, [&](long long) {
+		Block *block = BlocksGenerator::createBlock(weightedRandomizer.next(random));
+		benchmarkSink += block->getChar();
+		delete block;
+	});
+
+	//Playing whole games with random actions (the result is the time of a whole game).
+	add("game/simulateGame", 1000, [&](long long i) { benchmarkSink += simulateGame(BENCHMARK_SEED + (unsigned int)i); });
+
+	//The same games, with their events delivered to a subscriber (the difference from game/simulateGame is the cost of the event stream).
+	GameEventStream eventStream;
+	CountingSubscriber eventCounter;
+
+	eventStream.subscribe(&eventCounter);
+	add("events/simulateGame", 1000, [&](long long i) { benchmarkSink += simulateGame(BENCHMARK_SEED + (unsigned int)i, &eventStream); });
+
+	//Building and rendering frames into memory, alternating between two positions of the same game.
+	Game renderedGame;
+	MemoryRenderer renderer;
+	char frames[2][Board::ROWS][Board::COLS];
+
+	prepareGame(renderedGame, BENCHMARK_SEED, BlocksGenerator::PLUS_BLOCK);
+	renderedGame.buildFrame(frames[0]);
+	renderedGame.tick(Game::MOVE_LEFT);
+	renderedGame.buildFrame(frames[1]);
+
+	add("render/buildFrame", 1000000, [&](long long) {
+		renderedGame.buildFrame(frames[0]);
+		benchmarkSink += frames[0][0][0];
+	});
+	add("render/renderChangedFrame", 1000000, [&](long long i) {
+		renderer.render(frames[i & 1]);
+
+		if ((i & 1023) == 0) { //Emptying the memory buffer from time to time so it doesn't grow without a limit.
+			renderer.buffer.str("");
+		}
+	});
+
+	printResults(results);
+
+	return 0;
+}
\ No newline at end of file
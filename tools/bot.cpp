@@ -0,0 +1,175 @@
+/*
+Plays games with the best placement of each block (see PlacementEvaluator), optionally through a persistent placement cache (see PlacementCache).
+
+Usage:
+	bot play [games] [blocks per game] [cache file] [read]     Plays the games and prints the average score and the time the placements took.
+	                                                        With a cache file, each placement is looked up in the cache first, and the placements that
+	                                                        were searched are added to it (with "read", the cache is only read, like any amount of bots can).
+	bot stats <cache file>                                  Prints the size of the cache and the version of its evaluation.
+
+The games of a run are always started from the same seeds, so runs with and without a cache play the same games and end with the same scores.
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+using namespace std;
+
+#include "placement_evaluator.h"
+#include "placement_cache.h"
+#include "random_stream.h"
+
+constexpr int DEFAULT_GAMES = 100;
+constexpr int DEFAULT_BLOCKS = 100;
+constexpr unsigned int GAMES_SEED = 4242;
+
+/*
+This function plays the games and prints their results and the statistics of the cache.
+*/
+int playGames(int gamesAmount, int blocksAmount, const string& cacheFileName, bool isReadOnly) {
+	PlacementEvaluator evaluator;
+	PlacementCache cache;
+	Game game;
+	Game searchGame; //The placements are searched with their own game, so the game that is played is not changed by the search.
+	RandomStream seeds(GAMES_SEED);
+	long long totalScore = 0;
+	long long placements = 0;
+	long long searches = 0;
+	double searchSeconds = 0;
+	double lookupSeconds = 0;
+
+	if (!cacheFileName.empty()) {
+		bool isOpen = isReadOnly ? cache.open(cacheFileName, evaluator.getVersion()) : cache.create(cacheFileName, evaluator.getVersion());
+
+		if (!isOpen) {
+			cerr << "Cannot open the cache " << cacheFileName << endl;
+			return 1;
+		}
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (int i = 0; i < gamesAmount; i++) {
+		game.start(seeds.next());
+
+		for (int j = 0; j < blocksAmount && !game.isGameOver(); j++) {
+			GameState state;
+			CachedPlacement cached;
+			vector<Game::eAction> actions;
+			chrono::steady_clock::time_point lookupStart = chrono::steady_clock::now();
+
+			game.saveState(state);
+
+			if (state.blockType == Game::NO_BLOCK) { //The first block of a game is added by its first step.
+				game.tick(Game::NO_ACTION);
+				j--;
+				continue;
+			}
+
+			unsigned long long key = PlacementCache::getKey(state);
+			bool isFound = cache.isOpen() && cache.find(key, cached);
+
+			lookupSeconds += chrono::duration<double>(chrono::steady_clock::now() - lookupStart).count();
+
+			if (isFound) {
+				for (int k = 0; k < cached.actionsAmount; k++) {
+					actions.push_back((Game::eAction)cached.actions[k]);
+				}
+			}
+			else {
+				Placement best;
+				double evaluation;
+				chrono::steady_clock::time_point searchStart = chrono::steady_clock::now();
+
+				if (!evaluator.findBest(searchGame, state, best, evaluation)) {
+					break;
+				}
+
+				searchSeconds += chrono::duration<double>(chrono::steady_clock::now() - searchStart).count();
+				searches++;
+				actions = best.actions;
+
+				if (actions.size() <= CachedPlacement::MAX_ACTIONS) {
+					cached.evaluation = (float)evaluation;
+					cached.actionsAmount = (int)actions.size();
+
+					for (int k = 0; k < cached.actionsAmount; k++) {
+						cached.actions[k] = (unsigned char)actions[k];
+					}
+
+					cache.insert(key, cached); //Nothing is added if the cache is not open for writing.
+				}
+			}
+
+			for (size_t k = 0; k < actions.size(); k++) {
+				game.tick(actions[k]);
+			}
+
+			placements++;
+		}
+
+		totalScore += game.getScore();
+	}
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << gamesAmount << " games, " << placements << " blocks placed in " << seconds << "s (" << (long long)(placements / seconds) << " placements/sec)" << endl;
+	cout << "total score: " << totalScore << ", average score: " << (double)totalScore / gamesAmount << endl;
+	cout << "searches: " << searches << " (" << (searches > 0 ? searchSeconds / searches * 1e6 : 0) << "us each, "
+		<< evaluator.getFinder().getStepsAmount() << " steps)" << endl;
+
+	if (cache.isOpen()) {
+		cout << fixed << setprecision(2);
+		cout << "cache: " << cache.getLookups() << " lookups, " << cache.getHits() << " hits (" << cache.getHitRate() * 100 << "%), "
+			<< cache.getAverageProbes() << " probes per lookup, " << lookupSeconds / cache.getLookups() * 1e9 << "ns per lookup" << endl;
+		cout << "added " << cache.getInserts() << " placements (" << cache.getFailedInserts() << " could not be added), "
+			<< cache.getEntriesAmount() << " of " << cache.getCapacity() << " entries used" << endl;
+	}
+
+	return 0;
+}
+
+/*
+This function prints the size of the cache and whether it holds the entries of the current evaluation.
+*/
+int printStats(const string& cacheFileName) {
+	PlacementEvaluator evaluator;
+	PlacementCache cache;
+
+	if (!cache.open(cacheFileName, evaluator.getVersion())) {
+		cerr << "Cannot open the cache " << cacheFileName << endl;
+		return 1;
+	}
+
+	cout << cacheFileName << ": " << cache.getEntriesAmount() << " of " << cache.getCapacity() << " entries used ("
+		<< fixed << setprecision(1) << cache.getEntriesAmount() * 100.0 / cache.getCapacity() << "%), generation " << cache.getGeneration() << endl;
+	cout << (cache.isCurrent() ? "made with the current evaluation" : "made with another evaluation (nothing is found until a bot adds the current one's placements)") << endl;
+
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	string mode = (argc > 1) ? argv[1] : "";
+
+	if (mode == "play") {
+		int gamesAmount = (argc > 2) ? atoi(argv[2]) : DEFAULT_GAMES;
+		int blocksAmount = (argc > 3) ? atoi(argv[3]) : DEFAULT_BLOCKS;
+		string cacheFileName = (argc > 4) ? argv[4] : "";
+		bool isReadOnly = (argc > 5) && string(argv[5]) == "read";
+
+		if (gamesAmount > 0 && blocksAmount > 0) {
+			return playGames(gamesAmount, blocksAmount, cacheFileName, isReadOnly);
+		}
+	}
+
+	if (mode == "stats" && argc > 2) {
+		return printStats(argv[2]);
+	}
+
+	cerr << "Usage:" << endl;
+	cerr << "\tbot play [games] [blocks per game] [cache file] [read]" << endl;
+	cerr << "\tbot stats <cache file>" << endl;
+
+	return 1;
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+/*
+Measures the speed of the environments of libtetris (tetris_env.h) from C, the way a training loop uses them:
+a batch of environments is stepped with random actions, and the observations, rewards and done flags are read from the caller's arrays.
+It also checks that the observations hold only valid values and that the rewards add up to the scores of the games.
+
+Usage: env_speed [environments] [steps per environment]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "tetris_env.h"
+
+#define DEFAULT_ENVIRONMENTS 256
+#define DEFAULT_STEPS 20000
+
+/*
+This function returns a random number from a xorshift generator (the actions are drawn by the caller, as an agent would).
+*/
+static unsigned int nextRandom(unsigned int *state) {
+	unsigned int x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/*
+This function returns the current time in seconds.
+*/
+static double getSeconds(void) {
+	struct timespec now;
+
+	timespec_get(&now, TIME_UTC);
+
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+	int amount = (argc > 1) ? atoi(argv[1]) : DEFAULT_ENVIRONMENTS;
+	long long steps = (argc > 2) ? atoll(argv[2]) : DEFAULT_STEPS;
+	unsigned int random = 2463534242u;
+	long long gamesEnded = 0;
+	double endedGamesScore = 0;
+	int isValid = 1;
+
+	if (tetris_env_abi_version() != TETRIS_ENV_ABI_VERSION) {
+		fprintf(stderr, "The library was built with version %d of tetris_env.h, not %d.\n", tetris_env_abi_version(), TETRIS_ENV_ABI_VERSION);
+		return 1;
+	}
+
+	if (amount <= 0 || steps <= 0) {
+		fprintf(stderr, "Usage: env_speed [environments] [steps per environment]\n");
+		return 1;
+	}
+
+	//The caller owns all of the arrays, and they are allocated once.
+	unsigned int *seeds = malloc(amount * sizeof(unsigned int));
+	int *actions = malloc(amount * sizeof(int));
+	unsigned char *observations = malloc((size_t)amount * TETRIS_ENV_OBSERVATION_SIZE);
+	float *rewards = malloc(amount * sizeof(float));
+	unsigned char *dones = malloc(amount);
+	double *returns = calloc(amount, sizeof(double)); //The sum of the rewards of each environment's current game.
+
+	if (!seeds || !actions || !observations || !rewards || !dones || !returns) {
+		fprintf(stderr, "Out of memory.\n");
+		return 1;
+	}
+
+	for (int i = 0; i < amount; i++) {
+		seeds[i] = 1000 + i;
+	}
+
+	TetrisEnvBatch *batch = tetris_env_create(amount, seeds);
+	if (batch == NULL) {
+		fprintf(stderr, "Cannot create the environments.\n");
+		return 1;
+	}
+
+	tetris_env_observe(batch, observations);
+
+	double start = getSeconds();
+
+	for (long long step = 0; step < steps; step++) {
+		for (int i = 0; i < amount; i++) {
+			actions[i] = nextRandom(&random) % TETRIS_ENV_ACTIONS_AMOUNT;
+		}
+
+		tetris_env_step_batch(batch, actions, observations, rewards, dones);
+
+		for (int i = 0; i < amount; i++) {
+			returns[i] += rewards[i];
+
+			if (dones[i]) {
+				if (returns[i] != tetris_env_get_score(batch, i)) {
+					isValid = 0;
+				}
+
+				gamesEnded++;
+				endedGamesScore += returns[i];
+				returns[i] = 0;
+			}
+		}
+	}
+
+	double seconds = getSeconds() - start;
+
+	//Checking the values of the last observations.
+	for (int i = 0; i < amount; i++) {
+		const unsigned char *observation = observations + (size_t)i * TETRIS_ENV_OBSERVATION_SIZE;
+
+		for (int j = 0; j < TETRIS_ENV_BLOCK_KIND_OFFSET; j++) {
+			isValid &= (observation[j] <= TETRIS_ENV_CELL_BLOCK);
+		}
+
+		isValid &= (observation[TETRIS_ENV_BLOCK_KIND_OFFSET] <= TETRIS_ENV_BLOCK_BOMB);
+
+		for (int j = 0; j < TETRIS_ENV_NEXT_BLOCKS; j++) {
+			isValid &= (observation[TETRIS_ENV_NEXT_BLOCKS_OFFSET + j] < 7);
+		}
+	}
+
+	printf("%d environments, %lld steps each in %.2fs: %.0f steps/sec\n", amount, steps, seconds, amount * steps / seconds);
+	printf("%lld games ended, mean score %.1f\n", gamesEnded, gamesEnded ? endedGamesScore / gamesEnded : 0.0);
+
+	tetris_env_destroy(batch);
+	free(seeds);
+	free(actions);
+	free(observations);
+	free(rewards);
+	free(dones);
+	free(returns);
+
+	if (!isValid) {
+		printf("FAILED: invalid observations or rewards.\n");
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
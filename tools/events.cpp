@@ -0,0 +1,153 @@
+/*
+Plays games with random actions and follows them only through their event streams:
+the events of one game are printed, and the events of many games are counted and checked against the games themselves
+(the score and the amount of blocks dropped rebuilt from the events must match the game's).
+The program exits with 1 when a rebuilt game does not match.
+
+Usage: events [seed] [amount of games] [print]
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+using namespace std;
+
+#include "game.h"
+#include "random_stream.h"
+
+constexpr unsigned int DEFAULT_SEED = 12345;
+constexpr int DEFAULT_GAMES = 10000;
+
+const char *EVENT_NAMES[GameEvent::TYPES_AMOUNT] = {"spawned", "moved", "rotated", "locked", "rows_cleared", "bomb_exploded", "joker_paused", "game_over"};
+
+/*
+A subscriber that prints every event it receives.
+*/
+class PrintingSubscriber : public GameEventSubscriber {
+public:
+	void onEvents(const GameEvent *events, int amount) override {
+		for (int i = 0; i < amount; i++) {
+			const GameEvent& event = events[i];
+
+			cout << setw(14) << EVENT_NAMES[event.type] << "  row " << setw(2) << (int)event.row << "  col " << setw(2) << (int)event.col;
+
+			if (event.type == GameEvent::BLOCK_MOVED) {
+				cout << "  by (" << (int)event.rowsMoved << ", " << (int)event.colsMoved << ")";
+			}
+			else if (event.type != GameEvent::BLOCK_LOCKED && event.type != GameEvent::JOKER_PAUSED && event.type != GameEvent::GAME_OVER) {
+				cout << "  amount " << event.amount;
+			}
+
+			cout << "  score " << event.score << endl;
+		}
+	}
+};
+
+/*
+A subscriber that counts the events by their type and rebuilds the game's score and the amount of blocks dropped from them.
+*/
+class StatisticsSubscriber : public GameEventSubscriber {
+public:
+	long long counts[GameEvent::TYPES_AMOUNT] = {};
+	long long rowsCleared = 0;
+	long long squaresExploded = 0;
+	int score = 0;
+	int blocksDropped = 0;
+
+	void onEvents(const GameEvent *events, int amount) override {
+		for (int i = 0; i < amount; i++) {
+			const GameEvent& event = events[i];
+
+			this->counts[event.type]++;
+			this->score = event.score;
+
+			if (event.type == GameEvent::BLOCK_SPAWNED) {
+				this->blocksDropped++;
+			}
+			else if (event.type == GameEvent::ROWS_CLEARED) {
+				this->rowsCleared += event.amount;
+			}
+			else if (event.type == GameEvent::BOMB_EXPLODED) {
+				this->squaresExploded += event.amount;
+			}
+		}
+	}
+
+	/*
+	This function starts following a new game.
+	*/
+	void reset() {
+		this->score = 0;
+		this->blocksDropped = 0;
+	}
+};
+
+/*
+This function plays a whole game with actions taken from the given seed.
+*/
+void playGame(Game& game, unsigned int seed) {
+	RandomStream random(seed);
+
+	game.start(seed);
+
+	while (!game.isGameOver()) {
+		game.tick((Game::eAction)random.nextInRange(Game::JOKER_PAUSE + 1));
+	}
+}
+
+int main(int argc, char *argv[]) {
+	unsigned int seed = (argc > 1) ? (unsigned int)atoll(argv[1]) : DEFAULT_SEED;
+	int gamesAmount = (argc > 2) ? atoi(argv[2]) : DEFAULT_GAMES;
+	bool isPrinting = (argc > 3 && string(argv[3]) == "print");
+
+	if (gamesAmount <= 0) {
+		cerr << "Usage: events [seed] [amount of games] [print]" << endl;
+		return 1;
+	}
+
+	Game game;
+	GameEventStream events;
+	PrintingSubscriber printer;
+	StatisticsSubscriber statistics;
+	int mismatches = 0;
+
+	game.setEventStream(&events);
+	events.subscribe(&statistics);
+
+	//Printing the events of the first game.
+	if (isPrinting) {
+		events.subscribe(&printer);
+		playGame(game, seed);
+		events.unsubscribe(&printer);
+		cout << endl;
+	}
+
+	statistics = StatisticsSubscriber();
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (int i = 0; i < gamesAmount; i++) {
+		statistics.reset();
+		playGame(game, seed + (unsigned int)i);
+
+		if (statistics.score != game.getScore() || statistics.blocksDropped != game.getNumOfBlocks()) {
+			cerr << "Game " << seed + (unsigned int)i << ": the events give score " << statistics.score << " and " << statistics.blocksDropped
+				<< " blocks, the game has score " << game.getScore() << " and " << game.getNumOfBlocks() << " blocks" << endl;
+			mismatches++;
+		}
+	}
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	long long totalEvents = 0;
+
+	for (int i = 0; i < GameEvent::TYPES_AMOUNT; i++) {
+		cout << setw(14) << EVENT_NAMES[i] << ": " << statistics.counts[i] << endl;
+		totalEvents += statistics.counts[i];
+	}
+
+	cout << "rows cleared: " << statistics.rowsCleared << ", squares exploded: " << statistics.squaresExploded << endl;
+	cout << gamesAmount << " games, " << totalEvents << " events in " << seconds << "s (" << (long long)(totalEvents / seconds) << " events/sec), "
+		<< gamesAmount - mismatches << "/" << gamesAmount << " games rebuilt from their events" << endl;
+
+	return mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
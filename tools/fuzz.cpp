@@ -0,0 +1,1154 @@
+/*
+Differential fuzzing of the game's engines: random games are played by the reference engine and by every candidate engine side by side,
+and the board, the score and the falling block are compared after every step.
+The reference is a port of the original rules (the array of used points and the square by square moves of the Block class), which the optimised
+board does not share any code with. The line clear is the exception: it follows the game's one pass rules (every full row the block filled
+is removed), since the original checked the rows square by square and could miss a full row that a removed row moved down.
+The candidates are the game itself and the snapshots the analysis tools use; any other way of running the rules
+is added by implementing FuzzEngine and adding it to createCandidates.
+
+Each case is a seed for the blocks, a starting board with random squares in its lowest rows and a random sequence of actions.
+The blocks are drawn with more jokers and bombs than in the game, since most of the special rules are theirs.
+The cases run on all of the cores. When an engine diverges from the reference, the first failing case is shrunk (fewer actions, fewer squares)
+and printed as a replay that can be run again.
+
+Usage:
+	fuzz [cases] [threads] [first seed]                 Runs the given amount of random cases.
+	fuzz replay <seed> <board> <actions> [engine]       Runs a single case and prints the steps until the first divergence.
+
+The board is given as in perft (its lowest rows from top to bottom, '-' for an empty board) and the actions as letters
+('.' no action, 'L' left, 'D' to the bottom, 'R' right, 'T' rotate, 'P' pause the joker).
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <climits>
+#include <cstring>
+using namespace std;
+
+#include "position_parser.h"
+
+constexpr long long DEFAULT_CASES = 100000;
+constexpr unsigned int DEFAULT_FIRST_SEED = 1;
+constexpr int CASES_PER_BATCH = 64; //The amount of cases a thread takes at once.
+
+constexpr int ACTIONS_AMOUNT = Game::JOKER_PAUSE + 1;
+constexpr int MIN_ACTIONS = 50;
+constexpr int MAX_ACTIONS = 2000;
+constexpr int MAX_GARBAGE_ROWS = Board::ROWS - 5; //The rows above them are left free for the new blocks.
+constexpr int FUZZ_SPECIAL_BLOCK_WEIGHT = 30; //The weight of the joker and the bomb (the other blocks keep their default weights).
+
+/*
+A way of running the game's rules that is compared to the reference.
+*/
+class FuzzEngine {
+public:
+	virtual ~FuzzEngine() {}
+
+	virtual const char * getName() const = 0;
+	virtual void start(unsigned int seed, const Board& board) = 0;
+	virtual void tick(Game::eAction action) = 0;
+	virtual void getState(GameState& state) const = 0;
+	virtual int getGhostDistance() const = 0;
+};
+
+/*
+The reference engine: a port of the game's rules as they were written before the board was kept as bitmasks and the block was dropped in a single step.
+The board is an array of used points, every collision is checked square by square, the block is dropped one row at a time and the rotation is
+the original formula of the Block class. Only the blocks are taken from the same queue as the game, so both engines get the same blocks.
+The line clear is not the original one: it removes every full row the block filled at once, as the game does since rows are cleared in one pass.
+*/
+class LegacyEngine : public FuzzEngine {
+private:
+	constexpr static int ROWS = Board::ROWS;
+	constexpr static int COLS = Board::COLS;
+	constexpr static int MIDDLE_COL = Point::MIDDLE_X_POSITION - Point::GAME_LOCATION_OFFSET_X;
+	constexpr static int MAX_SQUARES = BlocksGenerator::SHAPE_SIZE;
+
+	//The block that is currently falling down, with the properties the original Block class kept for the rotation.
+	struct LegacyBlock {
+		int squares[MAX_SQUARES][2]; //The column and row of each square in the board.
+		int squaresAmount;
+		char type; //Game::REGULAR_BLOCK, JOKER_BLOCK or BOMB_BLOCK.
+		bool rotateable;
+		int rotatedAmount;
+		int maxColIndex;
+		int maxRowIndex;
+		int colAmount;
+		int rowAmount;
+	};
+
+	int usedPoints[ROWS][COLS];
+	LegacyBlock block;
+	bool hasBlock = false;
+	bool isFailed = false;
+	int score = 0;
+	int blocksDropped = 0;
+	BlocksQueue nextBlocks;
+
+	/*
+	This function updates the maxRowIndex, maxColIndex, colAmount and rowAmount properties of the block.
+	*/
+	static void updateBlockProperties(LegacyBlock& block) {
+		int minColIndex = block.maxColIndex = block.squares[0][0];
+		int minRowIndex = block.maxRowIndex = block.squares[0][1];
+
+		for (int i = 1; i < block.squaresAmount; i++) {
+			int x = block.squares[i][0];
+			int y = block.squares[i][1];
+
+			if (x > block.maxColIndex) {
+				block.maxColIndex = x;
+			}
+
+			if (x < minColIndex) {
+				minColIndex = x;
+			}
+
+			if (y > block.maxRowIndex) {
+				block.maxRowIndex = y;
+			}
+
+			if (y < minRowIndex) {
+				minRowIndex = y;
+			}
+		}
+
+		block.colAmount = block.maxColIndex - minColIndex;
+		block.rowAmount = block.maxRowIndex - minRowIndex;
+	}
+
+	/*
+	This function calculates the squares of the block after it is rotated to the right, according to the original formula.
+	*/
+	static void getRotatedPosition(const LegacyBlock& block, int rotated[MAX_SQUARES][2]) {
+		for (int i = 0; i < block.squaresAmount; i++) {
+			int x = block.squares[i][0];
+			int y = block.squares[i][1];
+			int relativeX = abs(block.maxColIndex - x - block.colAmount);
+			int relativeY = abs(block.maxRowIndex - y - block.rowAmount);
+			int newX;
+
+			if (block.rotatedAmount % 2 == 0) {
+				newX = abs(relativeY - block.colAmount) + block.maxColIndex - block.colAmount;
+			}
+			else {
+				newX = abs(relativeY - block.rowAmount) + block.maxColIndex - block.rowAmount;
+			}
+
+			rotated[i][0] = newX;
+			rotated[i][1] = relativeX + block.maxRowIndex - block.rowAmount;
+		}
+	}
+
+	/*
+	This function sets the used points of the board according to the block's squares.
+	*/
+	void setUsedPoints() {
+		for (int i = 0; i < this->block.squaresAmount; i++) {
+			this->usedPoints[this->block.squares[i][1]][this->block.squares[i][0]] = 1;
+		}
+	}
+
+	/*
+	This function returns whether the block can move down by 1 square (a block that cannot move down is set in the board).
+	*/
+	bool canBlockMoveDown() {
+		if (!this->hasBlock) {
+			return false;
+		}
+
+		if (this->block.type == Game::JOKER_BLOCK) {
+			for (int row = this->block.squares[0][1] + 1; row < ROWS; row++) {
+				if (this->usedPoints[row][this->block.squares[0][0]] == 0) {
+					return true;
+				}
+			}
+
+			this->setUsedPoints();
+			return false;
+		}
+
+		for (int i = 0; i < this->block.squaresAmount; i++) {
+			int x = this->block.squares[i][0];
+			int y = this->block.squares[i][1];
+
+			if (y == ROWS - 1 || this->usedPoints[y + 1][x] != 0) {
+				this->setUsedPoints();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	This function returns whether the block can move to the given side (-1 for left, 1 for right).
+	*/
+	bool canBlockMoveSideways(int direction) const {
+		if (!this->hasBlock) {
+			return false;
+		}
+
+		if (this->block.type == Game::JOKER_BLOCK) { //The joker's move is checked by the move itself.
+			return true;
+		}
+
+		for (int i = 0; i < this->block.squaresAmount; i++) {
+			int x = this->block.squares[i][0] + direction;
+
+			if (x < 0 || x >= COLS || this->usedPoints[this->block.squares[i][1]][x] != 0) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	This function returns whether the block can be rotated to the right (the top of the board is not checked, like in the original game).
+	*/
+	bool canBlockRotateRight() const {
+		if (!this->hasBlock || !this->block.rotateable) {
+			return false;
+		}
+
+		int rotated[MAX_SQUARES][2];
+		getRotatedPosition(this->block, rotated);
+
+		for (int i = 0; i < this->block.squaresAmount; i++) {
+			int x = rotated[i][0];
+			int y = rotated[i][1];
+
+			if (y > ROWS - 1 || x < 0 || x > COLS - 1 || this->usedPoints[y][x] != 0) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	This function moves the block down by 1 square (the joker jumps to the first free square beneath it).
+	*/
+	void moveBlockDown() {
+		if (!this->hasBlock) {
+			return;
+		}
+
+		if (this->block.type == Game::JOKER_BLOCK) {
+			for (int row = this->block.squares[0][1] + 1; row < ROWS; row++) {
+				if (this->usedPoints[row][this->block.squares[0][0]] == 0) {
+					this->block.squares[0][1] = row;
+					break;
+				}
+			}
+		}
+		else {
+			for (int i = 0; i < this->block.squaresAmount; i++) {
+				this->block.squares[i][1]++;
+			}
+
+			updateBlockProperties(this->block);
+		}
+	}
+
+	/*
+	This function moves the block 1 square to the given side (-1 for left, 1 for right). The joker jumps to the first free square on that side.
+	*/
+	void moveBlockSideways(int direction) {
+		if (!this->canBlockMoveSideways(direction)) {
+			return;
+		}
+
+		if (this->block.type == Game::JOKER_BLOCK) {
+			for (int col = this->block.squares[0][0] + direction; col >= 0 && col < COLS; col += direction) {
+				if (this->usedPoints[this->block.squares[0][1]][col] == 0) {
+					this->block.squares[0][0] = col;
+					break;
+				}
+			}
+		}
+		else {
+			for (int i = 0; i < this->block.squaresAmount; i++) {
+				this->block.squares[i][0] += direction;
+			}
+
+			updateBlockProperties(this->block);
+		}
+	}
+
+	/*
+	This function rotates the block to the right if possible.
+	*/
+	void rotateBlockRight() {
+		if (!this->canBlockRotateRight()) {
+			return;
+		}
+
+		getRotatedPosition(this->block, this->block.squares);
+		updateBlockProperties(this->block);
+		this->block.rotatedAmount++;
+	}
+
+	/*
+	This function moves the block to the bottom one row at a time and increases the score for each move.
+	*/
+	void moveBlockToBottom() {
+		int counter = 0;
+
+		while (this->canBlockMoveDown()) {
+			this->moveBlockDown();
+			counter++;
+		}
+
+		this->score += counter * Game::MOVE_TO_BOTTOM_SCORE_MULTIPLIER;
+	}
+
+	/*
+	This function takes the next block from the queue and adds it to the top of the board (the game is over if it overlaps a used square).
+	*/
+	void addNewBlock() {
+		//The squares of each shape as the original game created them, relative to the middle of the top row.
+		static const int SHAPES[BlocksGenerator::SHAPES_AMOUNT][MAX_SQUARES][2] = {
+			{{0, 0}, {1, 0}, {0, 1}, {1, 1}},
+			{{0, 0}, {1, 0}, {2, 0}, {3, 0}},
+			{{0, 0}, {1, 0}, {1, 1}, {2, 1}},
+			{{0, 0}, {0, 1}, {1, 1}, {2, 1}},
+			{{0, 0}, {-1, 1}, {0, 1}, {1, 1}}
+		};
+
+		BlocksGenerator::eBlockType blockType = this->nextBlocks.pop();
+
+		this->block.rotatedAmount = 0;
+
+		if (blockType == BlocksGenerator::JOKER_BLOCK || blockType == BlocksGenerator::BOMB_BLOCK) {
+			this->block.type = (blockType == BlocksGenerator::JOKER_BLOCK) ? (char)Game::JOKER_BLOCK : (char)Game::BOMB_BLOCK;
+			this->block.rotateable = false;
+			this->block.squaresAmount = 1;
+			this->block.squares[0][0] = MIDDLE_COL;
+			this->block.squares[0][1] = 0;
+		}
+		else {
+			this->block.type = Game::REGULAR_BLOCK;
+			this->block.rotateable = true;
+			this->block.squaresAmount = MAX_SQUARES;
+
+			for (int i = 0; i < MAX_SQUARES; i++) {
+				this->block.squares[i][0] = MIDDLE_COL + SHAPES[blockType][i][0];
+				this->block.squares[i][1] = SHAPES[blockType][i][1];
+			}
+		}
+
+		updateBlockProperties(this->block);
+		this->hasBlock = true;
+
+		for (int i = 0; i < this->block.squaresAmount; i++) {
+			if (this->usedPoints[this->block.squares[i][1]][this->block.squares[i][0]] != 0) {
+				this->isFailed = true;
+				return;
+			}
+		}
+
+		this->blocksDropped++;
+	}
+
+	/*
+	This function removes the full rows in the given range and moves the rows above them down. It returns the amount of rows that were removed.
+	The original checkAndRemoveRow removed one row at a time and checked the next square's row after the rows had moved, so it could leave a full row;
+	this follows the one pass rules of the game instead.
+	*/
+	int removeFullRows(int topRow, int bottomRow) {
+		bool isFull[ROWS] = {};
+		int removed = 0;
+
+		for (int i = topRow; i <= bottomRow; i++) {
+			int j = 0;
+
+			while (j < COLS && this->usedPoints[i][j] != 0) {
+				j++;
+			}
+
+			if (j == COLS) {
+				isFull[i] = true;
+				removed++;
+			}
+		}
+
+		if (removed == 0) {
+			return 0;
+		}
+
+		int targetRow = bottomRow;
+
+		for (int i = bottomRow; i >= 0; i--) {
+			if (isFull[i]) {
+				continue;
+			}
+
+			if (targetRow != i) {
+				for (int j = 0; j < COLS; j++) {
+					this->usedPoints[targetRow][j] = this->usedPoints[i][j];
+				}
+			}
+
+			targetRow--;
+		}
+
+		for (int i = targetRow; i >= 0; i--) {
+			for (int j = 0; j < COLS; j++) {
+				this->usedPoints[i][j] = 0;
+			}
+		}
+
+		return removed;
+	}
+
+	/*
+	This function removes the used squares in the 3x3 range around the bomb, with a penalty for each of them, and removes the bomb.
+	*/
+	void explode() {
+		int startX = this->block.squares[0][0] - 1;
+		int startY = this->block.squares[0][1] - 1;
+		int amountJumpX = 3;
+		int amountJumpY = 3;
+
+		if (startX < 0) {
+			startX = 0;
+			amountJumpX = 2;
+		}
+
+		if (startY < 0) {
+			startY = 0;
+			amountJumpY = 2;
+		}
+
+		for (int i = startY; i < startY + amountJumpY && i < ROWS; i++) {
+			for (int j = startX; j < startX + amountJumpX && j < COLS; j++) {
+				if (this->usedPoints[i][j] != 0) {
+					this->score = max(this->score - Game::BOMB_EXPLODE_SCORE_PENALTY, 0);
+					this->usedPoints[i][j] = 0;
+				}
+			}
+		}
+
+		this->hasBlock = false;
+	}
+
+	/*
+	This function explodes the bomb if it touches a used square beneath it (or to the side it is moved to).
+	*/
+	void checkAndExplode(Game::eAction action) {
+		if (!this->hasBlock || this->block.type != Game::BOMB_BLOCK) {
+			return;
+		}
+
+		int x = this->block.squares[0][0];
+		int y = this->block.squares[0][1];
+
+		if (action == Game::NO_ACTION) {
+			if (y == ROWS - 1) { //The bomb reached the bottom of the board, so it is removed without exploding.
+				this->usedPoints[ROWS - 1][x] = 0;
+				this->hasBlock = false;
+			}
+			else if (y >= 0 && this->usedPoints[y + 1][x] != 0) {
+				this->explode();
+			}
+		}
+		else if (action == Game::MOVE_LEFT) {
+			if (x > 0 && this->usedPoints[y][x - 1] != 0) {
+				this->explode();
+			}
+		}
+		else if (action == Game::MOVE_RIGHT) {
+			if (x < COLS - 1 && this->usedPoints[y][x + 1] != 0) {
+				this->explode();
+			}
+		}
+	}
+
+	/*
+	This function locks the block in the board, removes the rows it has filled and increases the score accordingly.
+	*/
+	void lockBlock() {
+		int topRow = ROWS - 1;
+		int bottomRow = 0;
+
+		for (int i = 0; i < this->block.squaresAmount; i++) {
+			topRow = min(topRow, this->block.squares[i][1]);
+			bottomRow = max(bottomRow, this->block.squares[i][1]);
+		}
+
+		switch (this->removeFullRows(topRow, bottomRow)) {
+		case 1:
+			this->score += (this->block.type == Game::JOKER_BLOCK) ? (int)Game::JOKER_LINE_REMOVED_SCORE : (int)Game::LINES_REMOVED_SCORE_1;
+			break;
+		case 2:
+			this->score += Game::LINES_REMOVED_SCORE_2;
+			break;
+		case 3:
+			this->score += Game::LINES_REMOVED_SCORE_3;
+			break;
+		case 4:
+			this->score += Game::LINES_REMOVED_SCORE_4;
+			break;
+		}
+
+		this->hasBlock = false;
+	}
+
+public:
+	const char * getName() const override {
+		return "legacy";
+	}
+
+	void start(unsigned int seed, const Board& board) override {
+		for (int i = 0; i < ROWS; i++) {
+			for (int j = 0; j < COLS; j++) {
+				this->usedPoints[i][j] = board.isUsed(i, j) ? 1 : 0;
+			}
+		}
+
+		this->hasBlock = false;
+		this->isFailed = false;
+		this->score = 0;
+		this->blocksDropped = 0;
+		this->nextBlocks.reset(seed);
+	}
+
+	void tick(Game::eAction action) override {
+		if (this->isFailed) {
+			return;
+		}
+
+		if (!this->hasBlock) {
+			this->addNewBlock();
+			return;
+		}
+
+		if (action == Game::MOVE_LEFT) {
+			this->checkAndExplode(action);
+			this->moveBlockSideways(-1);
+		}
+		else if (action == Game::MOVE_DOWN) {
+			this->moveBlockToBottom();
+		}
+		else if (action == Game::MOVE_RIGHT) {
+			this->checkAndExplode(action);
+			this->moveBlockSideways(1);
+		}
+		else if (action == Game::ROTATE_RIGHT) {
+			this->rotateBlockRight();
+		}
+
+		this->checkAndExplode(Game::NO_ACTION);
+
+		if (action == Game::JOKER_PAUSE && this->hasBlock && this->block.type == Game::JOKER_BLOCK) {
+			int jokerRow = this->block.squares[0][1];
+
+			this->setUsedPoints();
+
+			if (this->removeFullRows(jokerRow, jokerRow) > 0) {
+				this->score += Game::JOKER_LINE_REMOVED_SCORE;
+			}
+
+			this->hasBlock = false;
+		}
+		else if (this->hasBlock && this->canBlockMoveDown()) {
+			this->moveBlockDown();
+		}
+		else if (this->hasBlock) {
+			this->lockBlock();
+		}
+	}
+
+	void getState(GameState& state) const override {
+		for (int i = 0; i < ROWS; i++) {
+			state.rowMasks[i] = 0;
+
+			for (int j = 0; j < COLS; j++) {
+				if (this->usedPoints[i][j] != 0) {
+					state.rowMasks[i] |= (unsigned short)(1u << j);
+				}
+			}
+		}
+
+		state.blockType = this->hasBlock ? this->block.type : (char)Game::NO_BLOCK;
+		state.blockRotatedAmount = this->hasBlock ? (unsigned char)this->block.rotatedAmount : 0;
+
+		for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+			bool isSquare = this->hasBlock && i < this->block.squaresAmount;
+
+			state.blockSquares[i][0] = isSquare ? (signed char)this->block.squares[i][0] : 0;
+			state.blockSquares[i][1] = isSquare ? (signed char)this->block.squares[i][1] : 0;
+		}
+
+		state.score = this->score;
+		state.blocksDropped = this->blocksDropped;
+		state.seed = this->nextBlocks.getSeed();
+		state.blocksGenerated = this->nextBlocks.getCounter();
+		state.nextBlocksAmount = (unsigned short)this->nextBlocks.getSize();
+		state.isFailed = this->isFailed ? 1 : 0;
+		state.randomizerId = (unsigned short)(this->nextBlocks.getRandomizerFingerprint() & GameState::RANDOMIZER_ID_MASK);
+
+		for (int i = 0; i < GameState::RECENT_BLOCKS_BYTES; i++) {
+			state.recentBlocks[i] = (unsigned char)(this->nextBlocks.getRecentBlocks() >> (i * 8));
+		}
+	}
+
+	//The original game had no landing preview, so the preview is where the block would end after being moved to the bottom one row at a time.
+	int getGhostDistance() const override {
+		if (!this->hasBlock || this->isFailed) {
+			return 0;
+		}
+
+		int x = this->block.squares[0][0];
+		int y = this->block.squares[0][1];
+
+		if (this->block.type == Game::JOKER_BLOCK) {
+			int landingRow = y;
+
+			for (int row = y + 1; row < ROWS; row++) {
+				if (this->usedPoints[row][x] == 0) {
+					landingRow = row;
+				}
+			}
+
+			return landingRow - y;
+		}
+
+		int distance = 0;
+		bool isLanded = false;
+
+		while (!isLanded) {
+			for (int i = 0; i < this->block.squaresAmount && !isLanded; i++) {
+				int row = this->block.squares[i][1] + distance;
+
+				isLanded = (row == ROWS - 1 || this->usedPoints[row + 1][this->block.squares[i][0]] != 0);
+			}
+
+			if (!isLanded) {
+				distance++;
+			}
+		}
+
+		return distance;
+	}
+};
+
+/*
+The game's engine: a single game that runs every step, the same way the Tetris class runs it.
+*/
+class GameEngine : public FuzzEngine {
+private:
+	Game game;
+
+public:
+	const char * getName() const override {
+		return "game";
+	}
+
+	void start(unsigned int seed, const Board& board) override {
+		this->game.start(seed);
+		this->game.setBoard(board);
+	}
+
+	void tick(Game::eAction action) override {
+		this->game.tick(action);
+	}
+
+	void getState(GameState& state) const override {
+		this->game.saveState(state);
+	}
+
+	int getGhostDistance() const override {
+		return this->game.getGhostDistance();
+	}
+};
+
+/*
+The engine the undo history, perft and the placement searches use: only a GameState is kept between the steps,
+and each step is run by loading it into one of two games (a different one each time), so anything the state does not hold is lost.
+*/
+class SnapshotEngine : public FuzzEngine {
+private:
+	Game games[2];
+	GameState state;
+	int ghostDistance = 0;
+	int nextGame = 0;
+
+public:
+	const char * getName() const override {
+		return "snapshot";
+	}
+
+	void start(unsigned int seed, const Board& board) override {
+		this->games[0].start(seed);
+		this->games[0].setBoard(board);
+		this->games[0].saveState(this->state);
+		this->ghostDistance = this->games[0].getGhostDistance();
+		this->nextGame = 1;
+	}
+
+	void tick(Game::eAction action) override {
+		Game& game = this->games[this->nextGame];
+
+		game.loadState(this->state);
+		game.tick(action);
+		game.saveState(this->state);
+		this->ghostDistance = game.getGhostDistance();
+		this->nextGame = 1 - this->nextGame;
+	}
+
+	void getState(GameState& state) const override {
+		state = this->state;
+	}
+
+	int getGhostDistance() const override {
+		return this->ghostDistance;
+	}
+};
+
+/*
+This function creates one of each candidate engine.
+*/
+vector<unique_ptr<FuzzEngine>> createCandidates() {
+	vector<unique_ptr<FuzzEngine>> candidates;
+
+	candidates.push_back(unique_ptr<FuzzEngine>(new GameEngine()));
+	candidates.push_back(unique_ptr<FuzzEngine>(new SnapshotEngine()));
+
+	return candidates;
+}
+
+struct FuzzCase {
+	unsigned int seed;
+	Board board;
+	vector<Game::eAction> actions;
+};
+
+struct Divergence {
+	int step; //The index of the action after which the engines differ (-1 if they differ right after the start).
+	string description;
+};
+
+/*
+This function generates the case of the given seed: a board with random squares in its lowest rows (no row is full)
+and a sequence of actions, drawn with weights of their own so some cases mostly drop the blocks and others mostly move them.
+*/
+void generateCase(unsigned int seed, FuzzCase& fuzzCase) {
+	RandomStream random(seed);
+	int actionWeights[ACTIONS_AMOUNT];
+	int weightsSum = 0;
+
+	fuzzCase.seed = seed;
+	fuzzCase.board.clear();
+	fuzzCase.actions.clear();
+
+	int garbageRows = random.nextInRange(MAX_GARBAGE_ROWS + 1);
+	int density = 1 + random.nextInRange(9); //In tenths.
+
+	for (int i = Board::ROWS - garbageRows; i < Board::ROWS; i++) {
+		for (int j = 0; j < Board::COLS; j++) {
+			if (random.nextInRange(10) < density) {
+				fuzzCase.board.setUsed(i, j);
+			}
+		}
+
+		if (fuzzCase.board.isRowFull(i)) {
+			fuzzCase.board.clearUsed(i, random.nextInRange(Board::COLS));
+		}
+	}
+
+	for (int i = 0; i < ACTIONS_AMOUNT; i++) {
+		actionWeights[i] = random.nextInRange(10);
+		weightsSum += actionWeights[i];
+	}
+
+	if (weightsSum == 0) {
+		actionWeights[Game::NO_ACTION] = weightsSum = 1;
+	}
+
+	int actionsAmount = MIN_ACTIONS + random.nextInRange(MAX_ACTIONS - MIN_ACTIONS + 1);
+
+	for (int i = 0; i < actionsAmount; i++) {
+		int value = random.nextInRange(weightsSum);
+		int action = 0;
+
+		while (value >= actionWeights[action]) {
+			value -= actionWeights[action];
+			action++;
+		}
+
+		fuzzCase.actions.push_back((Game::eAction)action);
+	}
+}
+
+/*
+This function returns a description of the first difference between two states, or an empty string if they are the same.
+*/
+string compareStates(const GameState& expected, const GameState& actual, int expectedGhost, int actualGhost) {
+	for (int i = 0; i < Board::ROWS; i++) {
+		if (expected.rowMasks[i] != actual.rowMasks[i]) {
+			return "board row " + to_string(i) + " is " + to_string(actual.rowMasks[i]) + " instead of " + to_string(expected.rowMasks[i]);
+		}
+	}
+
+	if (expected.blockType != actual.blockType) {
+		return "block type is " + to_string(actual.blockType) + " instead of " + to_string(expected.blockType);
+	}
+
+	for (int i = 0; i < GameState::MAX_BLOCK_SQUARES; i++) {
+		if (expected.blockSquares[i][0] != actual.blockSquares[i][0] || expected.blockSquares[i][1] != actual.blockSquares[i][1]) {
+			return "block square " + to_string(i) + " is at (" + to_string(actual.blockSquares[i][0]) + ", " + to_string(actual.blockSquares[i][1]) +
+				") instead of (" + to_string(expected.blockSquares[i][0]) + ", " + to_string(expected.blockSquares[i][1]) + ")";
+		}
+	}
+
+	if (expected.blockRotatedAmount != actual.blockRotatedAmount) {
+		return "block was rotated " + to_string(actual.blockRotatedAmount) + " times instead of " + to_string(expected.blockRotatedAmount);
+	}
+
+	if (expected.blockType != Game::NO_BLOCK && expectedGhost != actualGhost) { //The landing preview has no meaning when there is no block.
+		return "landing preview is " + to_string(actualGhost) + " rows down instead of " + to_string(expectedGhost);
+	}
+
+	if (expected.score != actual.score) {
+		return "score is " + to_string(actual.score) + " instead of " + to_string(expected.score);
+	}
+
+	if (expected.blocksDropped != actual.blocksDropped) {
+		return "blocks dropped is " + to_string(actual.blocksDropped) + " instead of " + to_string(expected.blocksDropped);
+	}
+
+	if (expected.seed != actual.seed || expected.blocksGenerated != actual.blocksGenerated || expected.nextBlocksAmount != actual.nextBlocksAmount) {
+		return "upcoming blocks are " + to_string(actual.blocksGenerated) + "/" + to_string(actual.nextBlocksAmount) + " instead of " +
+			to_string(expected.blocksGenerated) + "/" + to_string(expected.nextBlocksAmount);
+	}
+
+	if (expected.randomizerId != actual.randomizerId || memcmp(expected.recentBlocks, actual.recentBlocks, sizeof(expected.recentBlocks)) != 0) {
+		return "the randomizer's settings or history differ";
+	}
+
+	if (expected.isFailed != actual.isFailed) {
+		return string("game over is ") + (actual.isFailed ? "true" : "false") + " instead of " + (expected.isFailed ? "true" : "false");
+	}
+
+	return "";
+}
+
+/*
+This function compares the engines' current states and returns a description of the first difference (empty if there is none).
+*/
+string compareEngines(const FuzzEngine& reference, const FuzzEngine& candidate) {
+	GameState expected, actual;
+
+	reference.getState(expected);
+	candidate.getState(actual);
+
+	return compareStates(expected, actual, reference.getGhostDistance(), candidate.getGhostDistance());
+}
+
+/*
+This function runs a case on the reference engine and a candidate engine, and returns whether they diverged (and where).
+The case stops after the last action or when the game is over.
+*/
+bool runCase(const FuzzCase& fuzzCase, FuzzEngine& reference, FuzzEngine& candidate, Divergence& divergence, long long& steps) {
+	reference.start(fuzzCase.seed, fuzzCase.board);
+	candidate.start(fuzzCase.seed, fuzzCase.board);
+
+	divergence.step = -1;
+	divergence.description = compareEngines(reference, candidate);
+	if (!divergence.description.empty()) {
+		return true;
+	}
+
+	for (size_t i = 0; i < fuzzCase.actions.size(); i++) {
+		GameState state;
+
+		reference.tick(fuzzCase.actions[i]);
+		candidate.tick(fuzzCase.actions[i]);
+		steps++;
+
+		divergence.step = (int)i;
+		divergence.description = compareEngines(reference, candidate);
+		if (!divergence.description.empty()) {
+			return true;
+		}
+
+		reference.getState(state);
+		if (state.isFailed) {
+			break;
+		}
+	}
+
+	return false;
+}
+
+/*
+This function shrinks a failing case as long as it keeps failing: the actions after the divergence are removed,
+then chunks of actions (from large chunks to single actions), then the actions are replaced with no action, and then the squares of the board are removed.
+*/
+void shrinkCase(FuzzCase& fuzzCase, FuzzEngine& reference, FuzzEngine& candidate, Divergence& divergence) {
+	long long steps = 0;
+	FuzzCase attempt;
+	Divergence attemptDivergence;
+
+	auto isFailing = [&](const FuzzCase& tried) {
+		return runCase(tried, reference, candidate, attemptDivergence, steps);
+	};
+
+	fuzzCase.actions.resize(divergence.step + 1);
+
+	bool isShrunk = true;
+
+	while (isShrunk) {
+		isShrunk = false;
+
+		for (size_t chunk = max((size_t)1, fuzzCase.actions.size() / 2); chunk >= 1; chunk /= 2) {
+			for (size_t start = 0; start < fuzzCase.actions.size();) {
+				attempt = fuzzCase;
+				attempt.actions.erase(attempt.actions.begin() + start, attempt.actions.begin() + min(start + chunk, attempt.actions.size()));
+
+				if (isFailing(attempt)) {
+					attempt.actions.resize(attemptDivergence.step + 1);
+					fuzzCase = attempt;
+					isShrunk = true;
+				}
+				else {
+					start += chunk;
+				}
+			}
+		}
+
+		for (size_t i = 0; i < fuzzCase.actions.size(); i++) {
+			if (fuzzCase.actions[i] != Game::NO_ACTION) {
+				attempt = fuzzCase;
+				attempt.actions[i] = Game::NO_ACTION;
+
+				if (isFailing(attempt)) {
+					fuzzCase = attempt;
+					isShrunk = true;
+				}
+			}
+		}
+
+		for (int i = 0; i < Board::ROWS; i++) {
+			for (int j = 0; j < Board::COLS; j++) {
+				if (fuzzCase.board.isUsed(i, j)) {
+					attempt = fuzzCase;
+					attempt.board.clearUsed(i, j);
+
+					if (isFailing(attempt)) {
+						fuzzCase = attempt;
+						isShrunk = true;
+					}
+				}
+			}
+		}
+	}
+
+	runCase(fuzzCase, reference, candidate, divergence, steps);
+}
+
+/*
+This function prints a state as a board, with the block's squares marked with '@'.
+*/
+void printState(const GameState& state, const string& indent) {
+	for (int i = 0; i < Board::ROWS; i++) {
+		string row;
+
+		for (int j = 0; j < Board::COLS; j++) {
+			row += (state.rowMasks[i] & (1u << j)) ? '#' : '.';
+		}
+
+		if (state.blockType != Game::NO_BLOCK) {
+			int squaresAmount = (state.blockType == Game::REGULAR_BLOCK) ? GameState::MAX_BLOCK_SQUARES : 1;
+
+			for (int k = 0; k < squaresAmount; k++) {
+				if (state.blockSquares[k][1] == i && state.blockSquares[k][0] >= 0 && state.blockSquares[k][0] < Board::COLS) {
+					row[state.blockSquares[k][0]] = '@';
+				}
+			}
+		}
+
+		cout << indent << row << endl;
+	}
+
+	cout << indent << "score " << state.score << ", blocks " << state.blocksDropped << endl;
+}
+
+/*
+This function runs a single case on the reference engine and the given candidates, and prints the states where they diverged.
+*/
+int replayCase(const FuzzCase& fuzzCase, const string& engineName) {
+	vector<unique_ptr<FuzzEngine>> candidates = createCandidates();
+	LegacyEngine reference;
+	bool isFound = false;
+	int result = 0;
+
+	for (size_t i = 0; i < candidates.size(); i++) {
+		if (!engineName.empty() && engineName != candidates[i]->getName()) {
+			continue;
+		}
+
+		Divergence divergence;
+		long long steps = 0;
+		isFound = true;
+
+		if (!runCase(fuzzCase, reference, *candidates[i], divergence, steps)) {
+			cout << candidates[i]->getName() << ": no divergence in " << steps << " steps" << endl;
+			continue;
+		}
+
+		GameState expected, actual;
+		reference.getState(expected);
+		candidates[i]->getState(actual);
+
+		cout << candidates[i]->getName() << ": diverged after step " << divergence.step + 1 << ": " << divergence.description << endl;
+		cout << "  reference:" << endl;
+		printState(expected, "    ");
+		cout << "  " << candidates[i]->getName() << ":" << endl;
+		printState(actual, "    ");
+		result = 1;
+	}
+
+	if (!isFound) {
+		cerr << "Unknown engine " << engineName << endl;
+		return 1;
+	}
+
+	return result;
+}
+
+int main(int argc, char *argv[]) {
+	//More jokers and bombs than in the game, since most of the special rules are theirs.
+	RandomizerConfig config;
+	config.weights[BlocksGenerator::JOKER_BLOCK] = FUZZ_SPECIAL_BLOCK_WEIGHT;
+	config.weights[BlocksGenerator::BOMB_BLOCK] = FUZZ_SPECIAL_BLOCK_WEIGHT;
+	RandomizerConfig::setCurrent(config);
+
+	if (argc > 1 && string(argv[1]) == "replay") {
+		FuzzCase fuzzCase;
+
+		if (argc < 5 || !parseBoard(argv[3], fuzzCase.board) || !parseActions(argv[4], fuzzCase.actions)) {
+			cerr << "Usage: fuzz replay <seed> <board> <actions> [engine]" << endl;
+			return 1;
+		}
+
+		fuzzCase.seed = (unsigned int)strtoul(argv[2], nullptr, 10);
+
+		return replayCase(fuzzCase, argc > 5 ? argv[5] : "");
+	}
+
+	long long casesAmount = (argc > 1) ? atoll(argv[1]) : DEFAULT_CASES;
+	int threadsAmount = (argc > 2) ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+	unsigned int firstSeed = (argc > 3) ? (unsigned int)strtoul(argv[3], nullptr, 10) : DEFAULT_FIRST_SEED;
+
+	if (casesAmount <= 0) {
+		cerr << "Usage: fuzz [cases] [threads] [first seed] | fuzz replay <seed> <board> <actions> [engine]" << endl;
+		return 1;
+	}
+
+	if (threadsAmount <= 0) {
+		threadsAmount = 1;
+	}
+
+	//Running the cases in batches on all of the threads. The first failing case (by its index) is kept, so the result does not depend on the threads.
+	atomic<long long> nextCase(0);
+	atomic<long long> totalSteps(0);
+	long long firstFailure = LLONG_MAX;
+	size_t failedCandidate = 0;
+	mutex failureMutex;
+	chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+
+	auto work = [&]() {
+		vector<unique_ptr<FuzzEngine>> candidates = createCandidates();
+		LegacyEngine reference;
+		FuzzCase fuzzCase;
+		Divergence divergence;
+		long long steps = 0;
+
+		while (true) {
+			long long batchStart = nextCase.fetch_add(CASES_PER_BATCH);
+
+			if (batchStart >= casesAmount) {
+				break;
+			}
+
+			for (long long index = batchStart; index < min(batchStart + CASES_PER_BATCH, casesAmount); index++) {
+				{
+					lock_guard<mutex> lock(failureMutex);
+					if (index > firstFailure) {
+						break;
+					}
+				}
+
+				generateCase(firstSeed + (unsigned int)index, fuzzCase);
+
+				for (size_t i = 0; i < candidates.size(); i++) {
+					if (runCase(fuzzCase, reference, *candidates[i], divergence, steps)) {
+						lock_guard<mutex> lock(failureMutex);
+
+						if (index < firstFailure) {
+							firstFailure = index;
+							failedCandidate = i;
+						}
+
+						break;
+					}
+				}
+			}
+		}
+
+		totalSteps += steps;
+	};
+
+	vector<thread> threads;
+	for (int i = 1; i < threadsAmount; i++) {
+		threads.push_back(thread(work));
+	}
+
+	work();
+
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+	long long casesRun = (firstFailure == LLONG_MAX) ? casesAmount : firstFailure + 1;
+
+	cout << casesRun << " cases, " << totalSteps << " steps on " << threadsAmount << " threads in " << seconds << "s, "
+		<< (long long)(totalSteps / seconds) << " steps/sec" << endl;
+
+	if (firstFailure == LLONG_MAX) {
+		cout << "No divergence." << endl;
+		return 0;
+	}
+
+	//Shrinking the first failing case and printing it as a replay.
+	vector<unique_ptr<FuzzEngine>> candidates = createCandidates();
+	LegacyEngine reference;
+	FuzzEngine& candidate = *candidates[failedCandidate];
+	FuzzCase fuzzCase;
+	Divergence divergence;
+	long long steps = 0;
+
+	generateCase(firstSeed + (unsigned int)firstFailure, fuzzCase);
+	runCase(fuzzCase, reference, candidate, divergence, steps);
+
+	cout << candidate.getName() << " diverged in case " << firstFailure << " after step " << divergence.step + 1 << ": " << divergence.description << endl;
+
+	shrinkCase(fuzzCase, reference, candidate, divergence);
+
+	cout << "Shrunk to " << fuzzCase.actions.size() << " actions: " << divergence.description << endl;
+	cout << "Replay: fuzz replay " << fuzzCase.seed << " \"" << formatBoard(fuzzCase.board) << "\" \"" << formatActions(fuzzCase.actions) << "\" "
+		<< candidate.getName() << endl;
+
+	return 1;
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+/*
+Watches the running games through the state they export to shared memory (see StateExport), without stopping them or talking to them.
+
+Usage:
+	monitor [segment name] [interval in miliseconds]     Prints the state of every game once per interval (1000 by default) until it is stopped.
+	monitor board <slot> [segment name]                  Prints the board of one game.
+	monitor publish [games] [seconds] [segment name]     Plays games with random actions and exports them, to try the monitor without the game.
+
+The segment name is "tetris_state" by default (the name the game uses).
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+using namespace std;
+
+#include "state_export.h"
+#include "game.h"
+#include "random_stream.h"
+
+constexpr int DEFAULT_INTERVAL = 1000;
+constexpr int DEFAULT_PUBLISHED_GAMES = 8;
+constexpr int DEFAULT_PUBLISH_SECONDS = 60;
+constexpr unsigned int PUBLISH_SEED = 777;
+
+const char *STATUS_NAMES[] = {"menu", "playing", "over"};
+
+/*
+This function returns the amount of used squares of the board (the board's occupancy).
+*/
+int countUsedSquares(const ExportedState& state) {
+	int used = 0;
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		used += Board::countSetBits(state.rowMasks[i]);
+	}
+
+	return used;
+}
+
+/*
+This function prints the state of every game of the segment once per interval. The steps per second are counted from the previous interval.
+*/
+int watchGames(const string& name, int interval) {
+	StateExport segment;
+
+	if (!segment.open(name)) {
+		cerr << "Cannot open the segment " << name << " (is the game running?)" << endl;
+		return 1;
+	}
+
+	int slotsAmount = segment.getSlotsAmount();
+	vector<ExportedState> previous(slotsAmount);
+	vector<bool> hasPrevious(slotsAmount, false);
+	chrono::steady_clock::time_point previousTime;
+
+	while (true) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		vector<ExportedState> states(slotsAmount);
+		vector<bool> isRead(slotsAmount);
+
+		for (int i = 0; i < slotsAmount; i++) {
+			isRead[i] = segment.read(i, states[i]);
+		}
+
+		double readNanoseconds = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+		double elapsedSeconds = chrono::duration<double>(start - previousTime).count();
+
+		cout << setw(5) << "slot" << setw(8) << "process" << setw(9) << "status" << setw(9) << "score" << setw(8) << "blocks" << setw(7) << "speed"
+			<< setw(11) << "occupancy" << setw(11) << "steps/sec" << setw(7) << "games" << endl;
+
+		for (int i = 0; i < slotsAmount; i++) {
+			if (!isRead[i]) {
+				continue;
+			}
+
+			const ExportedState& state = states[i];
+			double stepsPerSecond = 0;
+
+			if (hasPrevious[i] && previous[i].processId == state.processId) {
+				stepsPerSecond = (state.steps - previous[i].steps) / elapsedSeconds;
+			}
+
+			cout << setw(5) << i << setw(8) << state.processId << setw(9) << STATUS_NAMES[state.status % 3] << setw(9) << state.score << setw(8) << state.blocksDropped
+				<< setw(7) << state.speed << setw(10) << countUsedSquares(state) * 100 / (Board::ROWS * Board::COLS) << "%" << setw(11) << (long long)stepsPerSecond
+				<< setw(7) << state.gamesPlayed << endl;
+
+			previous[i] = state;
+			hasPrevious[i] = true;
+		}
+
+		previousTime = start;
+		cout << "(read " << slotsAmount << " slots in " << (long long)readNanoseconds << "ns)" << endl << endl;
+		this_thread::sleep_until(start + chrono::milliseconds(interval));
+	}
+}
+
+/*
+This function prints the board of one game of the segment.
+*/
+int printBoard(const string& name, int slot) {
+	StateExport segment;
+	ExportedState state;
+
+	if (!segment.open(name)) {
+		cerr << "Cannot open the segment " << name << " (is the game running?)" << endl;
+		return 1;
+	}
+
+	if (slot < 0 || slot >= segment.getSlotsAmount() || !segment.read(slot, state)) {
+		cerr << "There is no game in slot " << slot << endl;
+		return 1;
+	}
+
+	for (int i = 0; i < Board::ROWS; i++) {
+		cout << "|";
+
+		for (int j = 0; j < Board::COLS; j++) {
+			cout << ((state.rowMasks[i] & (1u << j)) ? '#' : ' ');
+		}
+
+		cout << "|" << endl;
+	}
+
+	cout << "score " << state.score << ", " << state.blocksDropped << " blocks, " << STATUS_NAMES[state.status % 3] << endl;
+
+	return 0;
+}
+
+/*
+This function plays games with random actions as fast as it can and exports each of them after every step, and prints the time an export takes.
+*/
+int publishGames(const string& name, int gamesAmount, int seconds) {
+	StateExport segment;
+
+	if (!segment.create(name, gamesAmount)) {
+		cerr << "Cannot create the segment " << name << endl;
+		return 1;
+	}
+
+	vector<Game> games(gamesAmount);
+	vector<long long> steps(gamesAmount, 0);
+	vector<long long> gamesPlayed(gamesAmount, 1);
+	RandomStream random(PUBLISH_SEED);
+	long long publishes = 0;
+	double publishNanoseconds = 0;
+	chrono::steady_clock::time_point end = chrono::steady_clock::now() + chrono::seconds(seconds);
+
+	for (int i = 0; i < gamesAmount; i++) {
+		games[i].start(random.next());
+	}
+
+	cout << "Exporting " << gamesAmount << " games to " << name << " for " << seconds << "s" << endl;
+
+	while (chrono::steady_clock::now() < end) {
+		for (int i = 0; i < gamesAmount; i++) {
+			Game& game = games[i];
+			ExportedState state;
+
+			if (game.isGameOver()) {
+				game.start(random.next());
+				gamesPlayed[i]++;
+			}
+
+			game.tick((Game::eAction)random.nextInRange(Game::JOKER_PAUSE + 1));
+			steps[i]++;
+
+			state.processId = StateExport::getProcessId();
+			state.status = ExportedState::PLAYING;
+			state.score = game.getScore();
+			state.blocksDropped = game.getNumOfBlocks();
+			state.speed = game.getSpeed();
+			state.steps = steps[i];
+			state.gamesPlayed = gamesPlayed[i];
+			state.updatedAt = StateExport::getTime();
+
+			for (int j = 0; j < Board::ROWS; j++) {
+				state.rowMasks[j] = game.getBoard().getRowMask(j);
+			}
+
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+			segment.publish(i, state);
+			publishNanoseconds += chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+			publishes++;
+		}
+	}
+
+	cout << publishes << " exports, " << publishNanoseconds / publishes << "ns per export (with the clock's overhead)" << endl;
+
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	string mode = (argc > 1) ? argv[1] : "";
+
+	if (mode == "board") {
+		if (argc < 3) {
+			cerr << "Usage: monitor board <slot> [segment name]" << endl;
+			return 1;
+		}
+
+		return printBoard(argc > 3 ? argv[3] : StateExport::DEFAULT_NAME, atoi(argv[2]));
+	}
+
+	if (mode == "publish") {
+		int gamesAmount = (argc > 2) ? atoi(argv[2]) : DEFAULT_PUBLISHED_GAMES;
+		int seconds = (argc > 3) ? atoi(argv[3]) : DEFAULT_PUBLISH_SECONDS;
+
+		if (gamesAmount <= 0 || gamesAmount > StateExport::MAX_SLOTS || seconds <= 0) {
+			cerr << "Usage: monitor publish [games (up to " << StateExport::MAX_SLOTS << ")] [seconds] [segment name]" << endl;
+			return 1;
+		}
+
+		return publishGames(argc > 4 ? argv[4] : StateExport::DEFAULT_NAME, gamesAmount, seconds);
+	}
+
+	int interval = (argc > 2) ? atoi(argv[2]) : DEFAULT_INTERVAL;
+
+	if (interval <= 0) {
+		cerr << "Usage: monitor [segment name] [interval in miliseconds]" << endl;
+		return 1;
+	}
+
+	return watchGames(argc > 1 ? argv[1] : StateExport::DEFAULT_NAME, interval);
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+/*
+Estimates the expected score of each placement of a block on a board, using the game's random mix of blocks (including the jokers and the bombs).
+For each placement, many games are played from the board the placement leads to (rollouts): each rollout draws its blocks from its own seed
+and plays random actions until the given amount of blocks was dropped or the game is over. The value of a rollout is the score it ended with.
+The same seeds are used for all of the placements, so the differences between them come from the placements and not from luck.
+
+The rollouts are run in rounds on all of the cores. After each round, a placement is dropped when its 95% confidence interval is entirely below
+the interval of the best placement, and the estimation stops when a single placement is left or the maximum amount of rollouts was reached.
+
+Usage: montecarlo <block> [board] [blocks per rollout] [maximum rollouts per placement] [threads]
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+#include "placement_finder.h"
+#include "position_parser.h"
+
+constexpr int DEFAULT_ROLLOUT_BLOCKS = 10;
+constexpr int DEFAULT_MAX_ROLLOUTS = 20000;
+constexpr int ROLLOUTS_PER_ROUND = 500;
+constexpr int MIN_ROUNDS_BEFORE_DROPPING = 2;
+constexpr double CONFIDENCE_Z = 1.96; //95% confidence.
+constexpr unsigned int ROLLOUTS_SEED = 1000003;
+
+struct Candidate {
+	Placement placement;
+	double sum;
+	double sumOfSquares;
+	long long rollouts;
+	bool isActive;
+
+	double getMean() const {
+		return this->sum / this->rollouts;
+	}
+
+	/*
+	This function returns half of the width of the 95% confidence interval of the mean.
+	*/
+	double getMargin() const {
+		if (this->rollouts < 2) {
+			return INFINITY;
+		}
+
+		double mean = this->getMean();
+		double variance = (this->sumOfSquares - this->rollouts * mean * mean) / (this->rollouts - 1);
+
+		return CONFIDENCE_Z * sqrt(max(variance, 0.0) / this->rollouts);
+	}
+};
+
+/*
+This function plays a game from the state a placement leads to and returns the score it ended with.
+The blocks of the game are drawn from the given seed and the actions are drawn from another stream of the same seed.
+*/
+int playRollout(Game& game, const GameState& placementState, unsigned int seed, int blocksAmount) {
+	GameState state = placementState;
+	RandomStream actions(seed ^ 0x9E3779B9u);
+
+	//Replacing the upcoming blocks with a full queue drawn from the rollout's seed.
+	state.seed = seed;
+	state.blocksGenerated = BlocksQueue::CAPACITY;
+	state.nextBlocksAmount = BlocksQueue::CAPACITY;
+
+	game.loadState(state);
+
+	int lastBlock = game.getNumOfBlocks() + blocksAmount;
+
+	while (!game.isGameOver() && (game.getNumOfBlocks() < lastBlock || game.getCurrentBlock() != nullptr)) {
+		game.tick((Game::eAction)actions.nextInRange(PlacementFinder::ACTIONS_AMOUNT));
+	}
+
+	return game.getScore();
+}
+
+/*
+This function runs a round of rollouts for every active candidate, splitting the work between the given amount of threads.
+*/
+void runRound(vector<Candidate>& candidates, int round, int blocksAmount, int threadsAmount) {
+	vector<int> active;
+	vector<int> scores;
+
+	for (size_t i = 0; i < candidates.size(); i++) {
+		if (candidates[i].isActive) {
+			active.push_back((int)i);
+		}
+	}
+
+	scores.resize(active.size() * ROLLOUTS_PER_ROUND);
+
+	//Each thread runs every threadsAmount-th rollout of the round.
+	auto work = [&](int threadIndex) {
+		Game game;
+
+		for (size_t job = threadIndex; job < scores.size(); job += threadsAmount) {
+			const Candidate& candidate = candidates[active[job / ROLLOUTS_PER_ROUND]];
+			unsigned int seed = ROLLOUTS_SEED + (unsigned int)(round * ROLLOUTS_PER_ROUND + job % ROLLOUTS_PER_ROUND);
+
+			scores[job] = playRollout(game, candidate.placement.state, seed, blocksAmount);
+		}
+	};
+
+	vector<thread> threads;
+	for (int i = 1; i < threadsAmount; i++) {
+		threads.push_back(thread(work, i));
+	}
+
+	work(0);
+
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+
+	for (size_t job = 0; job < scores.size(); job++) {
+		Candidate& candidate = candidates[active[job / ROLLOUTS_PER_ROUND]];
+
+		candidate.sum += scores[job];
+		candidate.sumOfSquares += (double)scores[job] * scores[job];
+		candidate.rollouts++;
+	}
+}
+
+/*
+This function drops the candidates whose confidence interval is entirely below the interval of the best candidate, and returns how many are left.
+*/
+int dropSeparatedCandidates(vector<Candidate>& candidates) {
+	double bestLowerBound = -INFINITY;
+	int activeAmount = 0;
+
+	for (size_t i = 0; i < candidates.size(); i++) {
+		if (candidates[i].isActive) {
+			bestLowerBound = max(bestLowerBound, candidates[i].getMean() - candidates[i].getMargin());
+		}
+	}
+
+	for (size_t i = 0; i < candidates.size(); i++) {
+		if (candidates[i].isActive && candidates[i].getMean() + candidates[i].getMargin() < bestLowerBound) {
+			candidates[i].isActive = false;
+		}
+
+		activeAmount += candidates[i].isActive;
+	}
+
+	return activeAmount;
+}
+
+int main(int argc, char *argv[]) {
+	vector<BlocksGenerator::eBlockType> blocks;
+	Board board;
+
+	if (argc < 2 || !parseBlocks(argv[1], blocks) || blocks.size() != 1 || !parseBoard(argc > 2 ? argv[2] : "-", board)) {
+		cerr << "Usage: montecarlo <block> [board] [blocks per rollout] [maximum rollouts per placement] [threads]" << endl;
+		return 1;
+	}
+
+	int blocksAmount = (argc > 3) ? atoi(argv[3]) : DEFAULT_ROLLOUT_BLOCKS;
+	int maxRollouts = (argc > 4) ? atoi(argv[4]) : DEFAULT_MAX_ROLLOUTS;
+	int threadsAmount = (argc > 5) ? atoi(argv[5]) : (int)thread::hardware_concurrency();
+
+	if (blocksAmount < 0 || maxRollouts <= 0) {
+		cerr << "The amount of blocks and rollouts must be positive." << endl;
+		return 1;
+	}
+
+	if (threadsAmount <= 0) {
+		threadsAmount = 1;
+	}
+
+	//Finding the placements of the block.
+	Game game;
+	PlacementFinder finder;
+	GameState start;
+	vector<Placement> placements;
+
+	game.start(0);
+	game.setBoard(board);
+	game.addBlock(blocks[0]);
+	game.saveState(start);
+	finder.findPlacements(game, start, placements);
+
+	if (placements.empty()) {
+		cout << "The block cannot be added to the board." << endl;
+		return 0;
+	}
+
+	vector<Candidate> candidates;
+	for (size_t i = 0; i < placements.size(); i++) {
+		Candidate candidate = {placements[i], 0, 0, 0, true};
+		candidates.push_back(candidate);
+	}
+
+	//Running rounds of rollouts until the best placement is separated from the others.
+	chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+	long long totalRollouts = 0;
+	int activeAmount = (int)candidates.size();
+	int round = 0;
+
+	for (; activeAmount > 1 && (round + 1) * ROLLOUTS_PER_ROUND <= maxRollouts; round++) {
+		runRound(candidates, round, blocksAmount, threadsAmount);
+		totalRollouts += (long long)activeAmount * ROLLOUTS_PER_ROUND;
+
+		if (round + 1 >= MIN_ROUNDS_BEFORE_DROPPING) {
+			activeAmount = dropSeparatedCandidates(candidates);
+		}
+	}
+
+	if (round == 0) { //A single placement (or a very low maximum), so there is nothing to compare - the values are still estimated once.
+		runRound(candidates, round++, blocksAmount, threadsAmount);
+		totalRollouts += (long long)activeAmount * ROLLOUTS_PER_ROUND;
+	}
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+	//Printing the placements from the best to the worst.
+	sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+		if (a.isActive != b.isActive) {
+			return a.isActive;
+		}
+
+		return a.getMean() > b.getMean();
+	});
+
+	cout << fixed << setprecision(1);
+
+	for (size_t i = 0; i < candidates.size(); i++) {
+		const Candidate& candidate = candidates[i];
+
+		cout << (candidate.isActive ? "* " : "  ") << setw(8) << candidate.getMean() << " +- " << setw(6) << candidate.getMargin()
+			<< "  (" << candidate.rollouts << " rollouts, placement score " << candidate.placement.state.score << ")  " << formatActions(candidate.placement.actions) << endl;
+	}
+
+	cout << candidates.size() << " placements, " << activeAmount << " left after " << round << " rounds, " << totalRollouts << " rollouts on "
+		<< threadsAmount << " threads, " << (long long)(totalRollouts / seconds) << " rollouts/sec" << endl;
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+/*
+Counts the positions that can be reached by dropping a given sequence of blocks under the game's rules (like perft in chess engines).
+The falling block is moved by running the game's steps with every possible action (so the gravity, the joker's passing through squares,
+the joker's pause and the bomb's explosion all come from the game itself), and every distinct board the block can be locked into is counted.
+The boards reached at each depth are the starting boards of the next block.
+
+Usage:
+	perft [--surface] [reference file]              Checks the positions of the reference file (tools/perft_reference.txt by default).
+	perft [--surface] <blocks> <depth> [board]      Prints the amount of positions at each depth.
+
+With --surface the placements are found with SurfacePlacementFinder (which falls back to the steps of the game for the boards it cannot handle),
+so the same reference positions check it as well.
+
+The blocks are given as letters: O - square, I - line, S - snake, G - gamma, P - plus, J - joker, B - bomb (the sequence is repeated if it is shorter than the depth).
+The board is given as its lowest rows from top to bottom separated by '/', with '#' for a used square and '.' for a free one ('-' for an empty board).
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <chrono>
+#include <cstring>
+using namespace std;
+
+#include "placement_finder.h"
+#include "surface_placements.h"
+#include "position_parser.h"
+
+constexpr char DEFAULT_REFERENCE_FILE[] = "tools/perft_reference.txt";
+
+typedef unordered_set<BoardKey, BytesHash<BoardKey>> BoardsSet;
+
+struct PerftResult {
+	vector<long long> positions; //The amount of distinct boards at each depth (starting from depth 1).
+	long long nodes; //The amount of game steps that were run.
+	double seconds;
+	long long surfaceSearches; //The searches that were answered from the surface of the board (with --surface).
+	long long fallbackSearches;
+};
+
+bool useSurface = false;
+
+/*
+This function adds a block of the given type to the given board and adds every board the block can be locked into to the set of reached boards.
+The finder is a PlacementFinder or a SurfacePlacementFinder.
+*/
+template <typename Finder>
+void expandBoard(Game& game, Finder& finder, const BoardKey& board, BlocksGenerator::eBlockType blockType, BoardsSet& reachedBoards) {
+	Board startBoard;
+	GameState start;
+	vector<Placement> placements;
+
+	startBoard.setRowMasks(board.rowMasks);
+	game.start(0);
+	game.setBoard(startBoard);
+	game.addBlock(blockType); //If the block was added on top of a used square, the game is over and nothing can be reached from this board.
+	game.saveState(start);
+
+	finder.findPlacements(game, start, placements);
+
+	for (size_t i = 0; i < placements.size(); i++) {
+		reachedBoards.insert(BoardKey::fromState(placements[i].state));
+	}
+}
+
+/*
+This function counts the boards that can be reached at each depth by dropping the given blocks onto the given board.
+*/
+template <typename Finder>
+PerftResult perft(Finder& finder, const Board& board, const vector<BlocksGenerator::eBlockType>& blocks, int depth) {
+	PerftResult result = {{}, 0, 0, 0, 0};
+	Game game;
+	BoardsSet boards;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	boards.insert(BoardKey::fromBoard(board));
+
+	for (int i = 0; i < depth; i++) {
+		BoardsSet nextBoards;
+		BoardsSet::const_iterator itr = boards.begin();
+		BoardsSet::const_iterator itrEnd = boards.end();
+
+		for (; itr != itrEnd; ++itr) {
+			expandBoard(game, finder, *itr, blocks[i % blocks.size()], nextBoards);
+		}
+
+		result.positions.push_back((long long)nextBoards.size());
+		boards.swap(nextBoards);
+	}
+
+	result.nodes = finder.getStepsAmount();
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	return result;
+}
+
+/*
+This function counts the boards that can be reached at each depth with the finder that was chosen.
+*/
+PerftResult perft(const Board& board, const vector<BlocksGenerator::eBlockType>& blocks, int depth) {
+	if (!useSurface) {
+		PlacementFinder finder;
+		return perft(finder, board, blocks, depth);
+	}
+
+	SurfacePlacementFinder finder;
+	PerftResult result = perft(finder, board, blocks, depth);
+
+	result.surfaceSearches = finder.getSurfaceSearches();
+	result.fallbackSearches = finder.getFallbackSearches();
+
+	return result;
+}
+
+/*
+This function prints the amount of positions at each depth and the speed of the search.
+*/
+void printResult(const PerftResult& result) {
+	for (size_t i = 0; i < result.positions.size(); i++) {
+		cout << "depth " << i + 1 << ": " << result.positions[i] << endl;
+	}
+
+	cout << "nodes: " << result.nodes << ", time: " << result.seconds << "s, nodes/sec: " << (long long)(result.nodes / result.seconds) << endl;
+
+	if (useSurface) {
+		cout << "searches from the surface: " << result.surfaceSearches << ", left to the steps of the game: " << result.fallbackSearches << endl;
+	}
+}
+
+/*
+This function checks every position of the reference file and returns whether all of the counts matched.
+Each line of the file is: <name> <blocks> <depth> <expected positions> <board>, and lines that start with '#' are comments.
+*/
+bool checkReferenceFile(const string& fileName) {
+	ifstream inFile(fileName);
+	string line;
+	int failed = 0;
+	int checked = 0;
+	long long totalNodes = 0;
+	double totalSeconds = 0;
+
+	if (!inFile.is_open()) {
+		cerr << "Cannot open " << fileName << endl;
+		return false;
+	}
+
+	while (getline(inFile, line)) {
+		stringstream fields(line);
+		string name, blocksText, boardText;
+		int depth;
+		long long expected;
+		vector<BlocksGenerator::eBlockType> blocks;
+		Board board;
+
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+
+		if (!(fields >> name >> blocksText >> depth >> expected >> boardText) || !parseBlocks(blocksText, blocks) || !parseBoard(boardText, board) || depth <= 0) {
+			cerr << "Invalid line: " << line << endl;
+			failed++;
+			continue;
+		}
+
+		PerftResult result = perft(board, blocks, depth);
+		long long positions = result.positions.back();
+		bool isMatching = (positions == expected);
+
+		cout << (isMatching ? "ok      " : "FAILED  ") << name << " (" << blocksText << ", depth " << depth << "): " << positions;
+		if (!isMatching) {
+			cout << " (expected " << expected << ")";
+		}
+		cout << ", " << (long long)(result.nodes / result.seconds) << " nodes/sec" << endl;
+
+		checked++;
+		failed += !isMatching;
+		totalNodes += result.nodes;
+		totalSeconds += result.seconds;
+	}
+
+	cout << checked - failed << "/" << checked << " positions matched, " << totalNodes << " nodes, " << (long long)(totalNodes / totalSeconds) << " nodes/sec" << endl;
+
+	return failed == 0;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 1 && string(argv[1]) == "--surface") {
+		useSurface = true;
+		argc--;
+		argv++;
+	}
+
+	if (argc <= 2) {
+		return checkReferenceFile(argc == 2 ? argv[1] : DEFAULT_REFERENCE_FILE) ? 0 : 1;
+	}
+
+	vector<BlocksGenerator::eBlockType> blocks;
+	Board board;
+	int depth = atoi(argv[2]);
+
+	if (!parseBlocks(argv[1], blocks) || depth <= 0 || !parseBoard(argc > 3 ? argv[3] : "-", board)) {
+		cerr << "Usage: perft [--surface] [reference file] | perft [--surface] <blocks> <depth> [board]" << endl;
+		return 1;
+	}
+
+	printResult(perft(board, blocks, depth));
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#ifndef __POSITION_PARSER_H
+#define __POSITION_PARSER_H
+
+/*
+Parsing of the positions given to the analysis tools on the command line and in reference files.
+The blocks are given as letters: O - square, I - line, S - snake, G - gamma, P - plus, J - joker, B - bomb.
+The board is given as its lowest rows from top to bottom separated by '/', with '#' for a used square and '.' for a free one ('-' for an empty board).
+*/
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <cctype>
+using namespace std;
+
+#include "game.h"
+
+constexpr char BLOCK_LETTERS[] = "OISGPJB"; //In the order of BlocksGenerator::eBlockType.
+constexpr char ACTION_LETTERS[] = ".LDRTP"; //In the order of Game::eAction (no action, left, to the bottom, right, turn, pause).
+
+/*
+This function parses a sequence of block letters and returns whether it succeeded.
+*/
+inline bool parseBlocks(const string& text, vector<BlocksGenerator::eBlockType>& blocks) {
+	blocks.clear();
+
+	for (size_t i = 0; i < text.length(); i++) {
+		const char *letter = strchr(BLOCK_LETTERS, toupper(text[i]));
+
+		if (letter == nullptr || *letter == '\0') {
+			return false;
+		}
+
+		blocks.push_back((BlocksGenerator::eBlockType)(letter - BLOCK_LETTERS));
+	}
+
+	return !blocks.empty();
+}
+
+/*
+This function parses a board (its lowest rows from top to bottom separated by '/') and returns whether it succeeded.
+*/
+inline bool parseBoard(const string& text, Board& board) {
+	vector<string> rows;
+	stringstream stream(text);
+	string row;
+
+	board.clear();
+
+	if (text == "-") {
+		return true;
+	}
+
+	while (getline(stream, row, '/')) {
+		rows.push_back(row);
+	}
+
+	if (rows.size() > Board::ROWS) {
+		return false;
+	}
+
+	for (size_t i = 0; i < rows.size(); i++) {
+		int boardRow = Board::ROWS - (int)rows.size() + (int)i;
+
+		if (rows[i].length() != Board::COLS) {
+			return false;
+		}
+
+		for (int j = 0; j < Board::COLS; j++) {
+			if (rows[i][j] == '#') {
+				board.setUsed(boardRow, j);
+			}
+			else if (rows[i][j] != '.') {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+This function returns a board in the format parseBoard reads: the rows from the highest used row to the bottom ('-' for an empty board).
+*/
+inline string formatBoard(const Board& board) {
+	string text;
+	int topRow = 0;
+
+	while (topRow < Board::ROWS && board.getRowMask(topRow) == 0) {
+		topRow++;
+	}
+
+	if (topRow == Board::ROWS) {
+		return "-";
+	}
+
+	for (int i = topRow; i < Board::ROWS; i++) {
+		if (i > topRow) {
+			text += '/';
+		}
+
+		for (int j = 0; j < Board::COLS; j++) {
+			text += board.isUsed(i, j) ? '#' : '.';
+		}
+	}
+
+	return text;
+}
+
+/*
+This function parses a sequence of action letters and returns whether it succeeded.
+*/
+inline bool parseActions(const string& text, vector<Game::eAction>& actions) {
+	actions.clear();
+
+	for (size_t i = 0; i < text.length(); i++) {
+		const char *letter = strchr(ACTION_LETTERS, toupper(text[i]));
+
+		if (letter == nullptr || *letter == '\0') {
+			return false;
+		}
+
+		actions.push_back((Game::eAction)(letter - ACTION_LETTERS));
+	}
+
+	return true;
+}
+
+/*
+This function returns a list of actions as letters.
+*/
+inline string formatActions(const vector<Game::eAction>& actions) {
+	string text;
+
+	for (size_t i = 0; i < actions.size(); i++) {
+		text += ACTION_LETTERS[actions[i]];
+	}
+
+	return text;
+}
+
+#endif
\ No newline at end of file
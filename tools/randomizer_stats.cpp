@@ -0,0 +1,123 @@
+/*
+Checks the blocks randomizer: draws many blocks with the given settings, compares the frequency of each block with the frequency
+the settings should give (a chi-square test) and measures the speed of the randomizer.
+The program exits with 1 when the frequencies are too far from the expected ones (p-value under 0.001).
+In the history mode the expected frequencies are not known (the repeats are rerolled), so only the frequencies and the speed are printed.
+
+Usage: randomizer_stats [settings file] [amount of blocks]
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+using namespace std;
+
+#include "block_randomizer.h"
+
+constexpr long long DEFAULT_DRAWS = 1000000000;
+constexpr unsigned int STATS_SEED = 20240611;
+constexpr double MIN_P_VALUE = 0.001;
+
+/*
+This function returns the chance that a chi-square variable with the given degrees of freedom is at least the given value,
+using the Wilson-Hilferty approximation (the cube root of the variable is close to normal).
+*/
+double getChiSquarePValue(double chiSquare, int degreesOfFreedom) {
+	double k = degreesOfFreedom;
+	double z = (cbrt(chiSquare / k) - (1 - 2 / (9 * k))) / sqrt(2 / (9 * k));
+
+	return 0.5 * erfc(z / sqrt(2.0));
+}
+
+int main(int argc, char *argv[]) {
+	RandomizerConfig config;
+	string error;
+
+	if (argc > 1 && string(argv[1]) != "-" && !config.loadFromFile(argv[1], error)) {
+		cerr << error << endl;
+		return 1;
+	}
+
+	long long draws = (argc > 2) ? atoll(argv[2]) : DEFAULT_DRAWS;
+
+	if (draws <= 0) {
+		cerr << "Usage: randomizer_stats [settings file] [amount of blocks]" << endl;
+		return 1;
+	}
+
+	//Drawing the blocks.
+	BlockRandomizer randomizer(config);
+	RandomStream random(STATS_SEED);
+	long long counts[BlockRandomizer::TYPES_AMOUNT] = {};
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (long long i = 0; i < draws; i++) {
+		counts[randomizer.next(random)]++;
+	}
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	//The expected chance of each block: the weights in the weighted mode and the rounded weights (copies in a bag) in the bag mode.
+	double expected[BlockRandomizer::TYPES_AMOUNT];
+	double sum = 0;
+
+	for (int i = 0; i < BlockRandomizer::TYPES_AMOUNT; i++) {
+		expected[i] = (config.mode == RandomizerConfig::BAG_MODE) ? floor(config.weights[i] + 0.5) : config.weights[i];
+		sum += expected[i];
+	}
+
+	bool isTested = (config.mode != RandomizerConfig::HISTORY_MODE);
+	bool isImpossibleDrawn = false;
+	double chiSquare = 0;
+	int degreesOfFreedom = -1;
+
+	cout << fixed;
+
+	for (int i = 0; i < BlockRandomizer::TYPES_AMOUNT; i++) {
+		double observedChance = (double)counts[i] / draws;
+		double expectedChance = expected[i] / sum;
+
+		cout << setw(8) << RandomizerConfig::BLOCK_NAMES[i] << ": " << setw(12) << counts[i] << "  " << setprecision(6) << observedChance;
+
+		if (isTested) {
+			cout << "  (expected " << expectedChance << ")";
+
+			if (expected[i] > 0) {
+				double expectedCount = expectedChance * draws;
+
+				chiSquare += (counts[i] - expectedCount) * (counts[i] - expectedCount) / expectedCount;
+				degreesOfFreedom++;
+			}
+			else if (counts[i] > 0) {
+				isImpossibleDrawn = true;
+			}
+		}
+
+		cout << endl;
+	}
+
+	cout << setprecision(1) << draws << " blocks in " << seconds << "s, " << (long long)(draws / seconds) << " blocks/sec" << endl;
+
+	if (!isTested) {
+		return 0;
+	}
+
+	if (isImpossibleDrawn) {
+		cout << "FAILED: a block with a weight of 0 was drawn." << endl;
+		return 1;
+	}
+
+	if (degreesOfFreedom == 0) { //A single possible block.
+		return 0;
+	}
+
+	double pValue = getChiSquarePValue(chiSquare, degreesOfFreedom);
+	bool isPassing = (pValue >= MIN_P_VALUE);
+
+	cout << setprecision(3) << "chi-square " << chiSquare << " with " << degreesOfFreedom << " degrees of freedom, p-value " << setprecision(4) << pValue
+		<< (isPassing ? "" : " - FAILED") << endl;
+
+	return isPassing ? 0 : 1;
+}
\ No newline at end of file
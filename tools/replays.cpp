@@ -0,0 +1,240 @@
+/*
+Writes recorded games to a replay archive and reads them back (see ReplayArchive).
+
+Usage:
+	replays generate <archive> [games] [seed]     Records games of random play (through a GameSession, in turbo mode) and adds them to the archive,
+	                                              and compares the size of the archive with a plain dump of the games.
+	replays verify <archive>                      Decodes the archive and plays every game again, and checks that each game ends the way it was recorded.
+	replays show <archive> <game>                 Prints a game of the archive.
+*/
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <chrono>
+using namespace std;
+
+#include "replay_archive.h"
+#include "game_session.h"
+#include "random_stream.h"
+
+constexpr int DEFAULT_GAMES = 10000;
+constexpr unsigned int DEFAULT_SEED = 2024;
+constexpr int SHOWN_ENTRIES = 40;
+
+const char *ACTION_NAMES[] = {"none", "left", "down", "right", "rotate", "joker"};
+
+/*
+This function returns the size of a file in bytes.
+*/
+long long getFileSize(const string& fileName) {
+	ifstream file(fileName, ios::binary | ios::ate);
+
+	return file.is_open() ? (long long)file.tellg() : 0;
+}
+
+/*
+This function plays a game with random actions (a few moves between the steps, and rare drops, like a player would) and records it.
+*/
+void recordGame(unsigned int seed, RandomStream& random, Replay& replay) {
+	static const Game::eAction ACTIONS[] = {Game::MOVE_LEFT, Game::MOVE_RIGHT, Game::ROTATE_RIGHT, Game::MOVE_LEFT, Game::MOVE_RIGHT, Game::ROTATE_RIGHT, Game::JOKER_PAUSE, Game::MOVE_DOWN};
+	Game game;
+	GameSession session(game);
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+
+	game.start(seed);
+	session.setTurbo(true, now);
+	session.setRecording(&replay);
+
+	while (!session.isFinished()) {
+		if (random.nextInRange(3) == 0) {
+			session.pushAction(ACTIONS[random.nextInRange(8)]);
+		}
+
+		session.resume(now);
+	}
+}
+
+/*
+This function records games and adds them to the archive.
+*/
+int generateGames(const string& fileName, int gamesAmount, unsigned int seed) {
+	ReplayArchiveWriter writer;
+	RandomStream seeds(seed);
+	RandomStream random(seed ^ 0x5EED);
+	Replay replay;
+	long long sizeBefore = getFileSize(fileName);
+	long long steps = 0;
+	long long entries = 0;
+	long long moves = 0; //The actions that are not steps.
+	double recordSeconds = 0;
+	double writeSeconds = 0;
+
+	if (!writer.open(fileName)) {
+		cerr << "Cannot open the archive " << fileName << endl;
+		return 1;
+	}
+
+	for (int i = 0; i < gamesAmount; i++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+		recordGame(seeds.next(), random, replay);
+
+		chrono::steady_clock::time_point recorded = chrono::steady_clock::now();
+
+		if (!writer.append(replay)) {
+			cerr << "Cannot write to the archive " << fileName << endl;
+			return 1;
+		}
+
+		recordSeconds += chrono::duration<double>(recorded - start).count();
+		writeSeconds += chrono::duration<double>(chrono::steady_clock::now() - recorded).count();
+		steps += replay.steps;
+		entries += replay.entries.size();
+
+		for (const ReplayEntry& entry : replay.entries) {
+			moves += (entry.action != Game::MOVE_DOWN && entry.action != Game::JOKER_PAUSE) ? 1 : 0;
+		}
+	}
+
+	if (!writer.close()) {
+		cerr << "Cannot write to the archive " << fileName << endl;
+		return 1;
+	}
+
+	long long archiveSize = getFileSize(fileName) - sizeBefore;
+	//A plain dump takes a byte for the key of each step (or no key), and a byte for each move between the steps.
+	long long dumpSize = steps + moves;
+
+	cout << gamesAmount << " games recorded in " << recordSeconds << "s and written in " << writeSeconds << "s (" << writer.getGamesAmount() << " games in the archive)" << endl;
+	cout << "steps: " << steps << " (" << steps / gamesAmount << " per game), actions: " << entries << " (" << entries / gamesAmount << " per game)" << endl;
+	cout << fixed << setprecision(2);
+	cout << "a byte per step and move: " << dumpSize << " bytes" << endl;
+	cout << "varints only:             " << writer.getStreamsSize() << " bytes (" << (double)dumpSize / writer.getStreamsSize() << "x smaller)" << endl;
+	cout << "archive:                  " << archiveSize << " bytes (" << (double)dumpSize / archiveSize << "x smaller, "
+		<< archiveSize * 8.0 / entries << " bits per action, " << (double)archiveSize / gamesAmount << " bytes per game)" << endl;
+
+	return 0;
+}
+
+/*
+This function decodes every game of the archive (once only decoding them, to measure the decoder, and once playing them again)
+and returns 1 if a game does not end the way it was recorded.
+*/
+int verifyGames(const string& fileName) {
+	ReplayArchiveReader reader;
+	Replay replay;
+	Game game;
+	long long fileSize = getFileSize(fileName);
+	long long gamesAmount = 0;
+	long long entries = 0;
+	long long steps = 0;
+	long long mismatches = 0;
+
+	if (!reader.open(fileName)) {
+		cerr << "Cannot open the archive " << fileName << endl;
+		return 1;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	while (reader.readNext(replay)) {
+		gamesAmount++;
+		entries += replay.entries.size();
+	}
+
+	double decodeSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	if (gamesAmount != reader.getGamesAmount()) {
+		cerr << "Only " << gamesAmount << " of the " << reader.getGamesAmount() << " games of the index were decoded" << endl;
+		return 1;
+	}
+
+	reader.rewind();
+	start = chrono::steady_clock::now();
+
+	while (reader.readNext(replay)) {
+		replay.play(game);
+		steps += replay.steps;
+
+		if (!replay.isMatching(game)) {
+			if (mismatches++ < 10) {
+				cout << "game with seed " << replay.seed << " ended with score " << game.getScore() << " and " << game.getNumOfBlocks()
+					<< " blocks, but was recorded with score " << replay.score << " and " << replay.blocksDropped << " blocks" << endl;
+			}
+		}
+	}
+
+	double playSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << fixed << setprecision(1);
+	cout << gamesAmount << " games, " << entries << " actions, " << fileSize << " bytes" << endl;
+	cout << "decoded in " << decodeSeconds * 1000 << "ms: " << fileSize / decodeSeconds / 1e6 << " MB/s, " << entries / decodeSeconds / 1e6 << "M actions/s" << endl;
+	cout << "played again in " << playSeconds * 1000 << "ms: " << fileSize / playSeconds / 1e6 << " MB/s, " << gamesAmount / playSeconds << " games/s, "
+		<< steps / playSeconds / 1e6 << "M steps/s" << endl;
+	cout << (gamesAmount - mismatches) << "/" << gamesAmount << " games ended the way they were recorded" << endl;
+
+	return (mismatches == 0) ? 0 : 1;
+}
+
+/*
+This function prints a game of the archive: its details and its first entries.
+*/
+int showGame(const string& fileName, long long gameIndex) {
+	ReplayArchiveReader reader;
+	Replay replay;
+
+	if (!reader.open(fileName)) {
+		cerr << "Cannot open the archive " << fileName << endl;
+		return 1;
+	}
+
+	if (!reader.readGame(gameIndex, replay)) {
+		cerr << "There is no game " << gameIndex << " in the archive (it has " << reader.getGamesAmount() << " games)" << endl;
+		return 1;
+	}
+
+	const ReplayArchiveEntry& entry = reader.getIndex()[(size_t)gameIndex];
+
+	cout << "game " << gameIndex << " (block at " << entry.blockOffset << ", game " << entry.gameInBlock << " of the block)" << endl;
+	cout << "seed " << replay.seed << ", speed " << replay.speed << ", score " << replay.score << ", " << replay.blocksDropped << " blocks, "
+		<< replay.steps << " steps, " << replay.entries.size() << " actions" << endl;
+
+	for (size_t i = 0; i < replay.entries.size() && i < SHOWN_ENTRIES; i++) {
+		cout << "+" << replay.entries[i].gap << " " << ACTION_NAMES[replay.entries[i].action] << endl;
+	}
+
+	if (replay.entries.size() > SHOWN_ENTRIES) {
+		cout << "..." << endl;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	string mode = (argc > 1) ? argv[1] : "";
+
+	if (mode == "generate" && argc > 2) {
+		int gamesAmount = (argc > 3) ? atoi(argv[3]) : DEFAULT_GAMES;
+		unsigned int seed = (argc > 4) ? (unsigned int)atoll(argv[4]) : DEFAULT_SEED;
+
+		if (gamesAmount > 0) {
+			return generateGames(argv[2], gamesAmount, seed);
+		}
+	}
+
+	if (mode == "verify" && argc > 2) {
+		return verifyGames(argv[2]);
+	}
+
+	if (mode == "show" && argc > 3) {
+		return showGame(argv[2], atoll(argv[3]));
+	}
+
+	cerr << "Usage:" << endl;
+	cerr << "\treplays generate <archive> [games] [seed]" << endl;
+	cerr << "\treplays verify <archive>" << endl;
+	cerr << "\treplays show <archive> <game>" << endl;
+
+	return 1;
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+/*
+Prints the leaderboard of the game's score log, and measures the log with many generated games.
+
+Usage:
+	scores [log file] [first place] [amount]         Prints the given places of the leaderboard (the best 10 by default).
+	scores generate <log file> <amount of games>     Adds random games to the log, then measures opening the log and the leaderboard queries.
+
+The index file is the log file's name with ".idx" instead of ".log" (as in the game).
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+using namespace std;
+
+#include "score_log.h"
+#include "random_stream.h"
+
+constexpr char DEFAULT_LOG_FILE[] = "scores.log";
+constexpr int DEFAULT_PLACES = 10;
+constexpr int GENERATE_BATCH = 100000; //The amount of games added to the log at once.
+constexpr int QUERIES_AMOUNT = 10000;
+
+/*
+This function returns the name of the index file of a log file.
+*/
+string getIndexFileName(const string& logFileName) {
+	size_t extension = logFileName.rfind(".log");
+
+	if (extension != string::npos && extension == logFileName.length() - 4) {
+		return logFileName.substr(0, extension) + ".idx";
+	}
+
+	return logFileName + ".idx";
+}
+
+/*
+This function returns the amount of microseconds since the given time.
+*/
+double getMicroseconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+/*
+This function prints records of the leaderboard, starting from the given place.
+*/
+void printRecords(const vector<ScoreRecord>& records, long long firstPlace) {
+	for (size_t i = 0; i < records.size(); i++) {
+		const ScoreRecord& record = records[i];
+		time_t finishedAt = (time_t)record.finishedAt;
+		char date[32] = "";
+
+		strftime(date, sizeof(date), "%Y-%m-%d %H:%M", localtime(&finishedAt));
+
+		cout << setw(8) << firstPlace + (long long)i + 1 << ". " << setw(8) << record.score << "  " << setw(5) << record.blocksDropped << " blocks  "
+			<< setw(6) << record.durationSeconds << "s  speed " << setw(4) << record.speed << "  seed " << setw(10) << record.seed << "  " << date << endl;
+	}
+}
+
+/*
+This function adds random games to the log, and measures opening the log (with its index and without it) and the queries.
+*/
+int generateGames(const string& logFileName, long long amount) {
+	string indexFileName = getIndexFileName(logFileName);
+	ScoreLog scoreLog;
+	RandomStream random((unsigned int)time(NULL));
+	vector<ScoreRecord> records;
+
+	if (!scoreLog.open(logFileName, indexFileName)) {
+		cerr << "Cannot open " << logFileName << endl;
+		return 1;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (long long added = 0; added < amount; added += GENERATE_BATCH) {
+		records.clear();
+
+		for (long long i = added; i < min(amount, added + GENERATE_BATCH); i++) {
+			ScoreRecord record;
+
+			record.blocksDropped = random.nextInRange(500);
+			record.score = record.blocksDropped * 20 + random.nextInRange(2000) - 500;
+			record.durationSeconds = record.blocksDropped * 2;
+			record.seed = random.next();
+			record.speed = 100 + 50 * random.nextInRange(6);
+			record.finishedAt = (long long)time(NULL);
+			records.push_back(record);
+		}
+
+		scoreLog.append(records.data(), (int)records.size());
+	}
+
+	cout << "Added " << amount << " games in " << getMicroseconds(start) / 1e6 << "s" << endl;
+	scoreLog.close();
+
+	//Opening the log with its index, and without it (a scan of the whole log).
+	start = chrono::steady_clock::now();
+	scoreLog.open(logFileName, indexFileName);
+	cout << "Opened " << scoreLog.getRecordsAmount() << " games with the index in " << getMicroseconds(start) << "us" << endl;
+
+	scoreLog.close();
+	remove(indexFileName.c_str());
+
+	start = chrono::steady_clock::now();
+	scoreLog.open(logFileName, indexFileName);
+	cout << "Opened " << scoreLog.getRecordsAmount() << " games without the index (scanning the log) in " << getMicroseconds(start) << "us" << endl;
+
+	//Measuring the queries.
+	vector<ScoreRecord> top;
+	long long ranksSum = 0;
+
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < QUERIES_AMOUNT; i++) {
+		scoreLog.getTop(top);
+	}
+	cout << "Best " << top.size() << " scores: " << getMicroseconds(start) / QUERIES_AMOUNT << "us per query" << endl;
+
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < QUERIES_AMOUNT; i++) {
+		ranksSum += scoreLog.getRank(random.nextInRange(12000) - 500);
+	}
+	cout << "Rank of a score: " << getMicroseconds(start) / QUERIES_AMOUNT << "us per query" << endl;
+
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < QUERIES_AMOUNT; i++) {
+		scoreLog.getLeaderboard(random.nextInRange((int)min(scoreLog.getRecordsAmount(), 2000000000LL)), DEFAULT_PLACES, top);
+	}
+	cout << "Page of " << DEFAULT_PLACES << " places: " << getMicroseconds(start) / QUERIES_AMOUNT << "us per query" << endl;
+
+	return ranksSum > 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 1 && string(argv[1]) == "generate") {
+		if (argc < 4 || atoll(argv[3]) <= 0) {
+			cerr << "Usage: scores generate <log file> <amount of games>" << endl;
+			return 1;
+		}
+
+		return generateGames(argv[2], atoll(argv[3]));
+	}
+
+	string logFileName = (argc > 1) ? argv[1] : DEFAULT_LOG_FILE;
+	long long first = (argc > 2) ? atoll(argv[2]) - 1 : 0;
+	int amount = (argc > 3) ? atoi(argv[3]) : DEFAULT_PLACES;
+	ScoreLog scoreLog;
+	vector<ScoreRecord> records;
+
+	if (!scoreLog.open(logFileName, getIndexFileName(logFileName))) {
+		cerr << "Cannot open " << logFileName << endl;
+		return 1;
+	}
+
+	if (first < 0 || amount <= 0) {
+		cerr << "Usage: scores [log file] [first place] [amount]" << endl;
+		return 1;
+	}
+
+	cout << scoreLog.getRecordsAmount() << " games" << endl;
+
+	if (scoreLog.getLeaderboard(first, amount, records)) {
+		printRecords(records, first);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+/*
+Hosts many games at once on a few worker threads (the way the game's sessions can be multiplexed), and measures how close to their time the steps were run.
+A feeder thread pushes random moves to random games at the given rate, as the players would, and wakes their sessions.
+The games start at different times during their first step (like players that did not start together), and games that are over leave the pool.
+With "turbo" instead of the speed, the games run in turbo mode (as fast as the workers can run them) and start again whenever they are over, for soak tests.
+
+Usage: sessions [games] [workers] [seconds] [speed | turbo] [actions per second]
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+using namespace std;
+
+#include "session_pool.h"
+#include "random_stream.h"
+
+constexpr int DEFAULT_GAMES = 10000;
+constexpr int DEFAULT_WORKERS = 4;
+constexpr int DEFAULT_SECONDS = 5;
+constexpr int DEFAULT_SPEED = 50; //In miliseconds per step, faster than the game's fastest speed so there are more steps to run.
+constexpr int FEEDER_BATCHES_PER_SECOND = 100;
+
+/*
+A game hosted in the pool, with its session.
+The session's queue is aligned to a cache line, which new does not guarantee before C++17, so a hosted game is created with create and freed with destroy.
+*/
+struct HostedGame {
+	Game game;
+	GameSession session;
+
+	HostedGame() : session(game) {
+	}
+
+	/*
+	This function allocates memory with the alignment of a hosted game and creates a hosted game in it.
+	*/
+	static HostedGame * create() {
+		void *memory = nullptr;
+
+#ifdef _WIN32
+		memory = _aligned_malloc(sizeof(HostedGame), alignof(HostedGame));
+#else
+		if (posix_memalign(&memory, alignof(HostedGame), sizeof(HostedGame)) != 0) {
+			memory = nullptr;
+		}
+#endif
+
+		if (memory == nullptr) {
+			throw bad_alloc();
+		}
+
+		return new (memory) HostedGame();
+	}
+
+	/*
+	This function destroys a hosted game that was created with create and frees its memory.
+	*/
+	static void destroy(HostedGame *hostedGame) {
+		hostedGame->~HostedGame();
+
+#ifdef _WIN32
+		_aligned_free(hostedGame);
+#else
+		free(hostedGame);
+#endif
+	}
+};
+
+/*
+This function runs on the feeder thread: it pushes random moves to random games until it is stopped, and returns the amount of moves pushed.
+Drops are rare, like in a real game, so the games last.
+*/
+void feedActions(SessionPool& pool, vector<HostedGame *>& games, int actionsPerSecond, const atomic<bool>& isFeeding, long long& pushedAmount) {
+	static const Game::eAction ACTIONS[] = {Game::MOVE_LEFT, Game::MOVE_RIGHT, Game::ROTATE_RIGHT, Game::MOVE_LEFT, Game::MOVE_RIGHT, Game::ROTATE_RIGHT, Game::JOKER_PAUSE, Game::MOVE_DOWN};
+	RandomStream random(12345);
+	int batchSize = max(1, actionsPerSecond / FEEDER_BATCHES_PER_SECOND);
+	chrono::steady_clock::time_point nextBatch = chrono::steady_clock::now();
+
+	pushedAmount = 0;
+
+	while (isFeeding) {
+		for (int i = 0; i < batchSize; i++) {
+			int gameIndex = random.nextInRange((int)games.size());
+
+			if (games[gameIndex]->session.pushAction(ACTIONS[random.nextInRange(8)])) {
+				pool.wake(gameIndex);
+				pushedAmount++;
+			}
+		}
+
+		nextBatch += chrono::microseconds(1000000 / FEEDER_BATCHES_PER_SECOND);
+		this_thread::sleep_until(nextBatch);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	int gamesAmount = (argc > 1) ? atoi(argv[1]) : DEFAULT_GAMES;
+	int workersAmount = (argc > 2) ? atoi(argv[2]) : DEFAULT_WORKERS;
+	int seconds = (argc > 3) ? atoi(argv[3]) : DEFAULT_SECONDS;
+	bool isTurbo = (argc > 4) && string(argv[4]) == "turbo";
+	int speed = (argc > 4 && !isTurbo) ? atoi(argv[4]) : DEFAULT_SPEED;
+	int actionsPerSecond = (argc > 5) ? atoi(argv[5]) : gamesAmount;
+
+	if (gamesAmount <= 0 || workersAmount <= 0 || seconds <= 0 || speed <= 0 || actionsPerSecond <= 0) {
+		cerr << "Usage: sessions [games] [workers] [seconds] [speed | turbo] [actions per second]" << endl;
+		return 1;
+	}
+
+	SessionPool pool;
+	vector<HostedGame *> games;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	pool.start(workersAmount);
+
+	for (int i = 0; i < gamesAmount; i++) {
+		HostedGame *hostedGame = HostedGame::create();
+
+		hostedGame->game.start((unsigned int)i + 1);
+		hostedGame->game.setSpeed(speed);
+		hostedGame->session.setTurbo(isTurbo, start + chrono::microseconds(speed * 1000LL * i / gamesAmount));
+		hostedGame->session.setRestarting(isTurbo, (unsigned int)i + 1);
+		games.push_back(hostedGame);
+		pool.add(hostedGame->session);
+	}
+
+	atomic<bool> isFeeding(true);
+	long long pushedAmount = 0;
+	thread feeder(feedActions, ref(pool), ref(games), actionsPerSecond, cref(isFeeding), ref(pushedAmount));
+
+	this_thread::sleep_for(chrono::seconds(seconds));
+	isFeeding = false;
+	feeder.join();
+
+	double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	long long steps = pool.getStepsAmount();
+
+	if (isTurbo) {
+		cout << gamesAmount << " games on " << workersAmount << " workers for " << elapsed << "s in turbo mode" << endl;
+		cout << "steps: " << steps << " (" << (long long)(steps / elapsed) << "/sec, " << steps / elapsed / gamesAmount * Game::DEFAULT_SPEED / 1000
+			<< " times faster than real time at the default speed)" << endl;
+	}
+	else {
+		cout << gamesAmount << " games on " << workersAmount << " workers for " << elapsed << "s, a step every " << speed << "ms" << endl;
+		cout << "steps: " << steps << " (" << (long long)(steps / elapsed) << "/sec, " << (long long)(gamesAmount * elapsed * 1000 / speed) << " due at most)" << endl;
+	}
+
+	if (!isTurbo) {
+		cout << "average lateness of a step: " << pool.getAverageLateness() << "us" << endl;
+	}
+
+	long long resumes = pool.getResumesAmount();
+	long long gamesOver = 0;
+
+	pool.stop(); //The games are read only after the workers were stopped.
+
+	for (size_t i = 0; i < games.size(); i++) {
+		gamesOver += games[i]->session.getGamesFinished();
+	}
+
+	cout << "resumes: " << resumes << ", actions pushed: " << pushedAmount << ", games over: " << gamesOver << endl;
+
+	for (size_t i = 0; i < games.size(); i++) {
+		HostedGame::destroy(games[i]);
+	}
+
+	return 0;
+}
\ No newline at end of file
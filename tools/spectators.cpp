@@ -0,0 +1,377 @@
+/*
+A loopback test of the spectator feed: one game is played with random actions and broadcast to many spectators over local sockets.
+Each spectator is a pair of connected Unix sockets. The spectators join at different times during the first half of the game (starting from a keyframe),
+the feed's messages are written to every socket straight from the feed's history (with one gathered write per spectator), and a few receiver threads
+decode the messages like the spectators would. At the end the view of every spectator must match the game.
+The program exits with 1 when a spectator's view does not match (a spectator that fell behind by more than the history in the middle of a message is dropped).
+
+This tool uses POSIX sockets, so it is built on Linux only.
+
+Usage: spectators [spectators] [steps] [receiver threads]
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/resource.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+#include "spectator_feed.h"
+#include "random_stream.h"
+
+constexpr int DEFAULT_SPECTATORS = 1000;
+constexpr int DEFAULT_STEPS = 5000;
+constexpr int DEFAULT_RECEIVERS = 4;
+constexpr unsigned int SPECTATORS_SEED = 4242;
+constexpr int MAX_GATHERED_MESSAGES = 16; //The most messages written to a spectator at once.
+constexpr int RECEIVE_BUFFER_SIZE = 4096;
+constexpr int POLL_TIMEOUT = 10; //In miliseconds.
+constexpr int RESERVED_FILES = 64; //The files the program opens besides the spectators' sockets.
+
+/*
+The sending side of a spectator: its socket and its cursor into the feed.
+*/
+struct SpectatorConnection {
+	int socket = -1;
+	long long joinStep = 0;
+	bool isJoined = false;
+	bool isDropped = false;
+	long long nextSequence = 0; //The sequence number of the next delta the spectator needs.
+	const SpectatorMessage *partialMessage = nullptr; //The message that was only partly written (the rest of it is written first).
+	long long partialSequence = 0;
+	int partialOffset = 0;
+	long long bytesSent = 0;
+};
+
+/*
+The receiving side of a spectator: its socket, the bytes of the message it is reading and its view of the game.
+*/
+struct SpectatorClient {
+	int socket = -1;
+	unsigned char buffer[RECEIVE_BUFFER_SIZE];
+	int bufferSize = 0;
+	SpectatorDecoder decoder;
+	long long messagesApplied = 0;
+	bool isBroken = false; //Whether a message could not be applied.
+	bool isClosed = false;
+};
+
+/*
+This function writes the pending messages of the feed to a spectator's socket, as much as the socket takes without blocking.
+The messages are written from the feed's own buffers, so nothing is copied for each spectator.
+*/
+void sendPending(SpectatorFeed& feed, SpectatorConnection& connection) {
+	while (!connection.isDropped) {
+		iovec parts[MAX_GATHERED_MESSAGES];
+		const SpectatorMessage *messages[MAX_GATHERED_MESSAGES];
+		int partsAmount = 0;
+		long long sequence = connection.nextSequence;
+		int offset = 0;
+
+		if (connection.partialMessage != nullptr) {
+			//The rest of a message can only be written if its buffer was not reused since (otherwise the spectator fell too far behind).
+			if (connection.partialMessage->sequence != connection.partialSequence) {
+				connection.isDropped = true;
+				return;
+			}
+
+			messages[partsAmount++] = connection.partialMessage;
+			offset = connection.partialOffset;
+			sequence = connection.partialSequence + 1;
+		}
+		else if (sequence <= feed.getLastSequence() && !feed.hasMessage(sequence)) { //The spectator has just joined, or its next delta is not kept anymore.
+			const SpectatorMessage& keyframe = feed.getKeyframe();
+
+			messages[partsAmount++] = &keyframe;
+			sequence = keyframe.sequence + 1;
+		}
+
+		for (; partsAmount < MAX_GATHERED_MESSAGES && sequence <= feed.getLastSequence(); sequence++) {
+			messages[partsAmount++] = &feed.getMessage(sequence);
+		}
+
+		if (partsAmount == 0) {
+			return;
+		}
+
+		for (int i = 0; i < partsAmount; i++) {
+			parts[i].iov_base = (void *)(messages[i]->data + (i == 0 ? offset : 0));
+			parts[i].iov_len = (size_t)(messages[i]->size - (i == 0 ? offset : 0));
+		}
+
+		ssize_t written = writev(connection.socket, parts, partsAmount);
+
+		if (written < 0) {
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				connection.isDropped = true;
+			}
+
+			return;
+		}
+
+		connection.bytesSent += written;
+		connection.partialMessage = nullptr;
+
+		//Moving the cursor past the messages that were written in full.
+		for (int i = 0; i < partsAmount; i++) {
+			long long remaining = (long long)parts[i].iov_len;
+
+			if (written < remaining) {
+				connection.partialMessage = messages[i];
+				connection.partialSequence = messages[i]->sequence;
+				connection.partialOffset = (int)(messages[i]->size - remaining + written);
+				connection.nextSequence = messages[i]->sequence + 1;
+				return;
+			}
+
+			written -= remaining;
+			connection.nextSequence = messages[i]->sequence + 1;
+		}
+	}
+}
+
+/*
+This function reads what arrived at a spectator's socket and applies every whole message to its view.
+*/
+void receiveMessages(SpectatorClient& client) {
+	while (true) {
+		ssize_t received = read(client.socket, client.buffer + client.bufferSize, RECEIVE_BUFFER_SIZE - client.bufferSize);
+
+		if (received == 0) {
+			client.isClosed = true;
+			return;
+		}
+
+		if (received < 0) {
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				client.isClosed = true;
+			}
+
+			return;
+		}
+
+		client.bufferSize += (int)received;
+
+		int position = 0;
+
+		while (client.bufferSize - position >= SpectatorMessage::HEADER_SIZE) {
+			int size = SpectatorMessage::readSize(client.buffer + position);
+
+			if (size < SpectatorMessage::HEADER_SIZE || size > SpectatorMessage::MAX_SIZE) {
+				client.isBroken = true;
+				client.isClosed = true;
+				return;
+			}
+
+			if (client.bufferSize - position < size) {
+				break;
+			}
+
+			if (client.decoder.apply(client.buffer + position, size)) {
+				client.messagesApplied++;
+			}
+			else {
+				client.isBroken = true;
+			}
+
+			position += size;
+		}
+
+		//Moving the beginning of a message that did not arrive in full to the start of the buffer.
+		for (int i = position; i < client.bufferSize; i++) {
+			client.buffer[i - position] = client.buffer[i];
+		}
+
+		client.bufferSize -= position;
+	}
+}
+
+/*
+This function runs on a receiver thread: it waits for messages on the sockets of its spectators until all of them are closed.
+*/
+void runReceiver(vector<SpectatorClient>& clients, int first, int step) {
+	vector<pollfd> sockets;
+	vector<SpectatorClient *> owners;
+
+	for (size_t i = first; i < clients.size(); i += step) {
+		pollfd socket = {clients[i].socket, POLLIN, 0};
+
+		sockets.push_back(socket);
+		owners.push_back(&clients[i]);
+	}
+
+	size_t openAmount = sockets.size();
+
+	while (openAmount > 0) {
+		if (poll(sockets.data(), sockets.size(), POLL_TIMEOUT) <= 0) {
+			continue;
+		}
+
+		for (size_t i = 0; i < sockets.size(); i++) {
+			if (sockets[i].fd >= 0 && (sockets[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+				receiveMessages(*owners[i]);
+
+				if (owners[i]->isClosed) {
+					sockets[i].fd = -1; //poll skips negative descriptors.
+					openAmount--;
+				}
+			}
+		}
+	}
+}
+
+/*
+This function raises the limit of open files of the process so it can hold the given amount of files, as far as the hard limit allows
+(the default soft limit is often 1024, and each spectator takes two sockets).
+*/
+void raiseOpenFilesLimit(rlim_t filesAmount) {
+	rlimit limit;
+
+	if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur >= filesAmount) {
+		return;
+	}
+
+	limit.rlim_cur = (limit.rlim_max == RLIM_INFINITY || limit.rlim_max >= filesAmount) ? filesAmount : limit.rlim_max;
+	setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+int main(int argc, char *argv[]) {
+	int spectatorsAmount = (argc > 1) ? atoi(argv[1]) : DEFAULT_SPECTATORS;
+	long long steps = (argc > 2) ? atoll(argv[2]) : DEFAULT_STEPS;
+	int receiversAmount = (argc > 3) ? atoi(argv[3]) : DEFAULT_RECEIVERS;
+
+	if (spectatorsAmount <= 0 || steps <= 0 || receiversAmount <= 0) {
+		cerr << "Usage: spectators [spectators] [steps] [receiver threads]" << endl;
+		return 1;
+	}
+
+	raiseOpenFilesLimit((rlim_t)spectatorsAmount * 2 + RESERVED_FILES);
+
+	vector<SpectatorConnection> connections(spectatorsAmount);
+	vector<SpectatorClient> clients(spectatorsAmount);
+
+	for (int i = 0; i < spectatorsAmount; i++) {
+		int pair[2];
+
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+			cerr << "Cannot create the sockets of spectator " << i << " (the limit of open files may be too low)" << endl;
+			return 1;
+		}
+
+		fcntl(pair[0], F_SETFL, O_NONBLOCK);
+		fcntl(pair[1], F_SETFL, O_NONBLOCK);
+		connections[i].socket = pair[0];
+		connections[i].joinStep = (long long)i * steps / (2 * spectatorsAmount);
+		clients[i].socket = pair[1];
+	}
+
+	vector<thread> receivers;
+
+	for (int i = 0; i < receiversAmount; i++) {
+		receivers.push_back(thread(runReceiver, ref(clients), i, receiversAmount));
+	}
+
+	//Playing the game and broadcasting it after every step.
+	Game game;
+	SpectatorFeed feed;
+	RandomStream random(SPECTATORS_SEED);
+	long long gamesPlayed = 1;
+	long long messagesAmount = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	game.start(SPECTATORS_SEED);
+	feed.update(game);
+
+	for (long long step = 0; step < steps; step++) {
+		if (game.isGameOver()) {
+			game.start(random.next());
+			gamesPlayed++;
+		}
+
+		game.tick((Game::eAction)random.nextInRange(Game::JOKER_PAUSE + 1));
+		messagesAmount += feed.update(game);
+
+		for (int i = 0; i < spectatorsAmount; i++) {
+			SpectatorConnection& connection = connections[i];
+
+			if (!connection.isJoined && step >= connection.joinStep) {
+				connection.isJoined = true;
+				connection.nextSequence = 0; //Not kept in the history, so the spectator starts from a keyframe.
+			}
+
+			if (connection.isJoined) {
+				sendPending(feed, connection);
+			}
+		}
+	}
+
+	//Writing the rest of the messages to the spectators that are behind.
+	bool isBehind = true;
+
+	while (isBehind) {
+		isBehind = false;
+
+		for (int i = 0; i < spectatorsAmount; i++) {
+			sendPending(feed, connections[i]);
+			isBehind |= !connections[i].isDropped && (connections[i].partialMessage != nullptr || connections[i].nextSequence <= feed.getLastSequence());
+		}
+
+		if (isBehind) {
+			this_thread::yield();
+		}
+	}
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	for (int i = 0; i < spectatorsAmount; i++) {
+		close(connections[i].socket);
+	}
+
+	for (size_t i = 0; i < receivers.size(); i++) {
+		receivers[i].join();
+	}
+
+	//Checking the spectators' views.
+	long long bytesSent = 0;
+	long long messagesApplied = 0;
+	int dropped = 0;
+	int mismatches = 0;
+
+	for (int i = 0; i < spectatorsAmount; i++) {
+		bytesSent += connections[i].bytesSent;
+		messagesApplied += clients[i].messagesApplied;
+
+		if (connections[i].isDropped) {
+			dropped++;
+		}
+		else if (clients[i].isBroken || !clients[i].decoder.hasView() || clients[i].decoder.getSequence() != feed.getLastSequence()
+			|| !(clients[i].decoder.getView() == feed.getView())) {
+			mismatches++;
+		}
+
+		close(clients[i].socket);
+	}
+
+	double averageDelta = messagesAmount > 0 ? (double)feed.getDeltaBytes() / messagesAmount : 0;
+	long long fullBoardsBytes = 0; //The size of the whole board sent to every joined spectator after every step (the way the console is repainted).
+
+	for (int i = 0; i < spectatorsAmount; i++) {
+		fullBoardsBytes += (steps - connections[i].joinStep) * (long long)(Board::ROWS * Board::COLS);
+	}
+
+	cout << steps << " steps (" << gamesPlayed << " games), " << messagesAmount << " deltas of " << averageDelta << " bytes on average, "
+		<< feed.getKeyframesEncoded() << " keyframes of " << feed.getKeyframe().size << " bytes" << endl;
+	cout << spectatorsAmount << " spectators on " << receiversAmount << " receiver threads: " << messagesApplied << " messages, " << bytesSent << " bytes sent in " << seconds << "s ("
+		<< (long long)(messagesApplied / seconds) << " messages/sec, " << (long long)(steps / seconds) << " steps/sec)" << endl;
+	cout << "Whole boards after every step would be about " << fullBoardsBytes << " bytes (" << (double)fullBoardsBytes / max(bytesSent, 1LL) << " times more)" << endl;
+	cout << spectatorsAmount - dropped - mismatches << "/" << spectatorsAmount << " spectators match the game, " << dropped << " dropped" << endl;
+
+	return (mismatches == 0 && dropped == 0) ? 0 : 1;
+}
\ No newline at end of file
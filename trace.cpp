@@ -0,0 +1,112 @@
+#include "trace.h"
+
+#ifdef TETRIS_TRACE
+
+#include <fstream>
+#include <functional>
+#include <thread>
+#include "allocation_tracker.h"
+
+chrono::steady_clock::time_point Trace::startTime = chrono::steady_clock::now();
+vector<Trace::TraceEvent> Trace::events;
+long long Trace::counters[COUNTERS_AMOUNT] = {};
+mutex Trace::eventsMutex;
+
+/*
+This function returns the time in microseconds since the trace has started.
+*/
+double Trace::now() {
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - startTime).count();
+}
+
+/*
+This function returns a small number that identifies the calling thread in the trace.
+*/
+unsigned int Trace::getThreadId() {
+	return (unsigned int)(hash<thread::id>()(this_thread::get_id()) & 0xFFFF);
+}
+
+/*
+This function records a zone with the given name that started and ended at the given times.
+*/
+void Trace::addZone(const char *name, double start, double end) {
+	lock_guard<mutex> lock(eventsMutex);
+
+	if (events.capacity() == 0) {
+		events.reserve(RESERVED_EVENTS);
+	}
+
+	TraceEvent event = {name, 'X', getThreadId(), start, end - start, {}};
+	events.push_back(event);
+}
+
+/*
+This function adds the given amount to one of the counters.
+*/
+void Trace::addToCounter(eCounter counter, long long amount) {
+	lock_guard<mutex> lock(eventsMutex);
+
+	counters[counter] += amount;
+}
+
+/*
+This function records the current values of the counters (it is called once per step of the game).
+*/
+void Trace::sampleCounters() {
+	lock_guard<mutex> lock(eventsMutex);
+
+	AllocationCounts allocations = AllocationTracker::getCounts(); //The allocations are counted per thread, so these are the allocations of the calling thread.
+
+	counters[ALLOCATIONS] = allocations.heapAllocations;
+	counters[POOL_ALLOCATIONS] = allocations.poolAllocations;
+
+	TraceEvent event = {"counters", 'C', getThreadId(), now(), 0, {}};
+	for (int i = 0; i < COUNTERS_AMOUNT; i++) {
+		event.counters[i] = counters[i];
+	}
+
+	events.push_back(event);
+}
+
+/*
+This function saves the recorded events into a file using the Chrome trace JSON format and returns whether it succeeded.
+*/
+bool Trace::saveToFile(const string& fileName) {
+	static const char *counterNames[COUNTERS_AMOUNT] = {"ticks", "cells_painted", "gotoxy_calls", "bytes_written", "allocations", "pool_allocations", "frames_skipped", "keys_handled", "input_delay_us", "step_lateness_us"};
+	lock_guard<mutex> lock(eventsMutex);
+	ofstream outFile(fileName, ios::trunc);
+
+	if (!outFile.is_open()) {
+		return false;
+	}
+
+	outFile << "{\"traceEvents\": [" << endl;
+
+	for (size_t i = 0; i < events.size(); i++) {
+		const TraceEvent& event = events[i];
+
+		outFile << "{\"name\": \"" << event.name << "\", \"ph\": \"" << event.phase << "\", \"pid\": 1, \"tid\": " << event.threadId << ", \"ts\": " << fixed << event.timestamp;
+
+		if (event.phase == 'X') {
+			outFile << ", \"dur\": " << event.duration;
+		}
+		else {
+			outFile << ", \"args\": {";
+
+			for (int j = 0; j < COUNTERS_AMOUNT; j++) {
+				outFile << (j > 0 ? ", " : "") << "\"" << counterNames[j] << "\": " << event.counters[j];
+			}
+
+			outFile << "}";
+		}
+
+		outFile << "}" << (i + 1 < events.size() ? "," : "") << endl;
+	}
+
+	outFile << "]}" << endl;
+	outFile.close();
+
+	return true;
+}
+
+#endif
\ No newline at end of file
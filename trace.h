@@ -0,0 +1,82 @@
+#ifndef __TRACE_H
+#define __TRACE_H
+
+/*
+A lightweight tracing layer for profiling the game loop.
+When TETRIS_TRACE is defined, scoped zones and counters are recorded in memory and can be saved as a Chrome trace JSON file
+(it can be opened in Perfetto or in chrome://tracing). When it is not defined, all of the macros below compile to nothing.
+*/
+
+#ifdef TETRIS_TRACE
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <mutex>
+using namespace std;
+
+class Trace {
+public:
+	enum eCounter {TICKS, CELLS_PAINTED, GOTOXY_CALLS, BYTES_WRITTEN, ALLOCATIONS, POOL_ALLOCATIONS, FRAMES_SKIPPED, KEYS_HANDLED, INPUT_DELAY_US, STEP_LATENESS_US, COUNTERS_AMOUNT};
+
+	constexpr static int RESERVED_EVENTS = 1 << 16;
+
+private:
+	struct TraceEvent {
+		const char *name;
+		char phase; //'X' for a zone (with a duration) and 'C' for a sample of the counters.
+		unsigned int threadId;
+		double timestamp; //In microseconds since the trace has started.
+		double duration;
+		long long counters[COUNTERS_AMOUNT];
+	};
+
+	static chrono::steady_clock::time_point startTime;
+	static vector<TraceEvent> events;
+	static long long counters[COUNTERS_AMOUNT];
+	static mutex eventsMutex;
+
+	static unsigned int getThreadId();
+
+public:
+	static double now();
+	static void addZone(const char *name, double start, double end);
+	static void addToCounter(eCounter counter, long long amount);
+	static void sampleCounters();
+	static bool saveToFile(const string& fileName);
+};
+
+/*
+A zone that is recorded from its construction until the end of its scope.
+*/
+class TraceZone {
+private:
+	const char *name;
+	double start;
+
+public:
+	TraceZone(const char *name) : name(name), start(Trace::now()) {
+	}
+
+	~TraceZone() {
+		Trace::addZone(this->name, this->start, Trace::now());
+	}
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COUNTER_ADD(counter, amount) Trace::addToCounter(Trace::counter, (amount))
+#define TRACE_SAMPLE_COUNTERS() Trace::sampleCounters()
+#define TRACE_SAVE(fileName) Trace::saveToFile(fileName)
+
+#else
+
+#define TRACE_ZONE(name)
+#define TRACE_COUNTER_ADD(counter, amount)
+#define TRACE_SAMPLE_COUNTERS()
+#define TRACE_SAVE(fileName)
+
+#endif
+
+#endif
\ No newline at end of file
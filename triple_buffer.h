@@ -0,0 +1,71 @@
+#ifndef __TRIPLE_BUFFER_H
+#define __TRIPLE_BUFFER_H
+
+#include <atomic>
+using namespace std;
+
+/*
+A lock-free triple buffer that passes values from a single writer thread to a single reader thread.
+The writer fills its back buffer and publishes it, and the reader takes the newest published buffer when it is ready for one.
+Neither of them ever waits for the other: the writer always has a buffer to fill, and values that were published before
+the reader took them are skipped (only the newest one is read).
+*/
+template <typename T>
+class TripleBuffer {
+private:
+	constexpr static unsigned char INDEX_MASK = 3;
+	constexpr static unsigned char NEW_BIT = 4; //Marks that the middle buffer was published and was not taken by the reader yet.
+
+	T buffers[3];
+	int back = 0; //This property saves the buffer the writer fills (it is only used by the writer).
+	atomic<unsigned char> middle; //This property saves the buffer that was last published (and whether the reader has taken it).
+	int front = 2; //This property saves the buffer the reader reads (it is only used by the reader).
+
+public:
+	TripleBuffer() : middle(1) {
+	}
+
+	TripleBuffer(const TripleBuffer& other) = delete;
+	TripleBuffer& operator=(const TripleBuffer& other) = delete;
+
+	/*
+	This function returns the buffer the writer fills (only called by the writer).
+	*/
+	T& getBackBuffer() {
+		return this->buffers[this->back];
+	}
+
+	/*
+	This function publishes the back buffer, and gives the writer the buffer that was published before it (only called by the writer).
+	*/
+	void publish() {
+		unsigned char previous = this->middle.exchange((unsigned char)(this->back | NEW_BIT), memory_order_acq_rel);
+
+		this->back = previous & INDEX_MASK;
+	}
+
+	/*
+	This function takes the newest published buffer as the front buffer and returns true, or returns false if nothing was published
+	since the last time it was called (only called by the reader).
+	*/
+	bool update() {
+		if ((this->middle.load(memory_order_relaxed) & NEW_BIT) == 0) {
+			return false;
+		}
+
+		unsigned char published = this->middle.exchange((unsigned char)this->front, memory_order_acq_rel);
+
+		this->front = published & INDEX_MASK;
+
+		return true;
+	}
+
+	/*
+	This function returns the buffer the reader reads (only called by the reader).
+	*/
+	const T& getFrontBuffer() const {
+		return this->buffers[this->front];
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "undo_history.h"
+
+/*
+This function removes all of the saved states.
+*/
+void UndoHistory::clear() {
+	this->current = 0;
+	this->undoAmount = 0;
+	this->redoAmount = 0;
+	this->isEmpty = true;
+}
+
+/*
+This function saves a new state after the current state and makes it the current state.
+*/
+void UndoHistory::record(const GameState& state) {
+	if (this->isEmpty) {
+		this->isEmpty = false;
+	}
+	else {
+		this->current = (this->current + 1) % CAPACITY;
+
+		if (this->undoAmount < CAPACITY - 1) { //If the buffer is full, the oldest state was overwritten.
+			this->undoAmount++;
+		}
+	}
+
+	this->states[this->current] = state;
+	this->redoAmount = 0;
+}
+
+/*
+This function steps back the given amount of states and puts the state it reached into the output parameter.
+It returns false (and does not change anything) if there are not enough saved states.
+*/
+bool UndoHistory::undo(GameState& state, int steps) {
+	if (steps <= 0 || steps > this->undoAmount) {
+		return false;
+	}
+
+	this->current = (this->current - steps + CAPACITY) % CAPACITY;
+	this->undoAmount -= steps;
+	this->redoAmount += steps;
+	state = this->states[this->current];
+
+	return true;
+}
+
+/*
+This function steps forward the given amount of states that were undone and puts the state it reached into the output parameter.
+It returns false (and does not change anything) if there are not enough undone states.
+*/
+bool UndoHistory::redo(GameState& state, int steps) {
+	if (steps <= 0 || steps > this->redoAmount) {
+		return false;
+	}
+
+	this->current = (this->current + steps) % CAPACITY;
+	this->redoAmount -= steps;
+	this->undoAmount += steps;
+	state = this->states[this->current];
+
+	return true;
+}
+
+/*
+This function returns how many states can be undone.
+*/
+int UndoHistory::getUndoAmount() const {
+	return this->undoAmount;
+}
+
+/*
+This function returns how many states can be redone.
+*/
+int UndoHistory::getRedoAmount() const {
+	return this->redoAmount;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef __UNDO_HISTORY_H
+#define __UNDO_HISTORY_H
+
+#include "game_state.h"
+
+/*
+A fixed-size ring buffer of game states that allows stepping back and forth between them.
+Recording a state after stepping back removes the states that could have been redone. When the buffer is full, the oldest state is overwritten.
+*/
+class UndoHistory {
+public:
+	constexpr static int CAPACITY = 256;
+
+private:
+	GameState states[CAPACITY];
+	int current = 0; //This property saves the index of the current state in the ring buffer.
+	int undoAmount = 0; //This property saves how many states are saved before the current state.
+	int redoAmount = 0; //This property saves how many states are saved after the current state.
+	bool isEmpty = true;
+
+public:
+	void clear();
+	void record(const GameState& state);
+	bool undo(GameState& state, int steps = 1);
+	bool redo(GameState& state, int steps = 1);
+
+	int getUndoAmount() const;
+	int getRedoAmount() const;
+};
+
+#endif
\ No newline at end of file